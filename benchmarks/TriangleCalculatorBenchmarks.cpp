@@ -0,0 +1,583 @@
+#include <benchmark/benchmark.h>
+
+#include <logging/logging.hpp>
+#include <nlohmann/json.hpp>
+
+#include <TriangleCalculatorLib/CompactTriangle.hpp>
+#include <TriangleCalculatorLib/SolverStats.hpp>
+#include <TriangleCalculatorLib/Triangle.hpp>
+#include <TriangleCalculatorLib/TriangleBatch.hpp>
+#include <TriangleCalculatorLib/TriangleCache.hpp>
+#include <TriangleCalculatorLib/TriangleCalculator.hpp>
+#include <TriangleCalculatorLib/TriangleGenerator.hpp>
+#include <TriangleCalculatorLib/TriangleJson.hpp>
+#include <TriangleCalculatorLib/TriangleServer.hpp>
+#include <TriangleCalculatorLib/TriangleStream.hpp>
+
+#include "TriangleCalculatorBackend.hpp"
+#include "TriangleView.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <numbers>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace TriangleCalculatorLib;
+
+// Every allocation of the process goes through these, so each benchmark can report its allocations per call.
+namespace {
+std::atomic<std::uint64_t> g_allocations{0};
+
+void* CountedAllocate(std::size_t size, std::size_t alignment) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    void* memory = alignment <= alignof(std::max_align_t)
+                       ? std::malloc(size ? size : 1)
+                       : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+} // namespace
+
+void* operator new(std::size_t size) { return CountedAllocate(size, alignof(std::max_align_t)); }
+void* operator new[](std::size_t size) { return CountedAllocate(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return CountedAllocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return CountedAllocate(size, static_cast<std::size_t>(alignment)); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+
+namespace {
+// the cases TriangleCalculatorBackend::finalizeTriangle dispatches on
+enum class SolverCase {
+    SSS,
+    SAS,
+    SSAOneSolution,
+    SSATwoSolutions,
+    ASA,
+    AAS,
+    InsufficientData,
+    Count
+};
+
+constexpr std::array<const char*, static_cast<std::size_t>(SolverCase::Count)> CaseNames{
+    "SSS", "SAS", "SSAOneSolution", "SSATwoSolutions", "ASA", "AAS", "InsufficientData"};
+
+double ToRadians(double degrees) {
+    return degrees * std::numbers::pi / 180.0;
+}
+
+CompactTriangle Masked(const CompactTriangle& full, std::uint8_t known) {
+    CompactTriangle triangle{};
+    triangle.known = known;
+    triangle.sideA = (known & KnownField::SideA) ? full.sideA : 0.0;
+    triangle.sideB = (known & KnownField::SideB) ? full.sideB : 0.0;
+    triangle.sideC = (known & KnownField::SideC) ? full.sideC : 0.0;
+    triangle.angleA = (known & KnownField::AngleA) ? full.angleA : 0.0;
+    triangle.angleB = (known & KnownField::AngleB) ? full.angleB : 0.0;
+    triangle.angleC = (known & KnownField::AngleC) ? full.angleC : 0.0;
+    return triangle;
+}
+
+// Fixture triangles (degrees) masked down to the known fields of each case
+struct Workload {
+    std::array<std::vector<CompactTriangle>, static_cast<std::size_t>(SolverCase::Count)> cases;
+    std::vector<CompactTriangle> mixed; // every case, interleaved
+};
+
+Workload LoadWorkload() {
+    Workload workload;
+    std::ifstream input(TRIANGLE_FIXTURE_PATH);
+    if (!input.is_open()) {
+        std::cerr << "Unable to open fixture file at " << TRIANGLE_FIXTURE_PATH << "\n";
+        std::exit(1);
+    }
+    nlohmann::json fixture;
+    input >> fixture;
+
+    auto add = [&workload](SolverCase solverCase, const CompactTriangle& triangle) {
+        workload.cases[static_cast<std::size_t>(solverCase)].push_back(triangle);
+    };
+    for (const auto& category : {"right", "equilateral", "isosceles", "scalene"}) {
+        for (const auto& entry : fixture.at(category)) {
+            const auto& sides = entry.at("sides");
+            const auto& angles = entry.at("angles");
+            const CompactTriangle full{sides.at(0).get<double>(), sides.at(1).get<double>(), sides.at(2).get<double>(),
+                                       angles.at(0).get<double>(), angles.at(1).get<double>(), angles.at(2).get<double>(),
+                                       KnownField::All};
+            add(SolverCase::SSS, Masked(full, KnownField::Sides));
+            add(SolverCase::SAS, Masked(full, KnownField::SideA | KnownField::SideB | KnownField::AngleC));
+            add(SolverCase::ASA, Masked(full, KnownField::AngleA | KnownField::AngleB | KnownField::SideC));
+            add(SolverCase::AAS, Masked(full, KnownField::AngleA | KnownField::AngleB | KnownField::SideA));
+            add(SolverCase::InsufficientData, Masked(full, KnownField::SideA | KnownField::AngleA));
+
+            // a, b and the angle opposite the longer side has one solution, opposite the shorter one two
+            if (std::abs(full.sideA - full.sideB) > 1e-6 * std::max(full.sideA, full.sideB)) {
+                const bool aLonger = full.sideA > full.sideB;
+                const std::uint8_t ab = KnownField::SideA | KnownField::SideB;
+                add(SolverCase::SSAOneSolution, Masked(full, ab | (aLonger ? KnownField::AngleA : KnownField::AngleB)));
+                add(SolverCase::SSATwoSolutions, Masked(full, ab | (aLonger ? KnownField::AngleB : KnownField::AngleA)));
+            }
+        }
+    }
+
+    for (std::size_t i = 0; !workload.cases[0].empty() && i < workload.cases[0].size(); ++i) {
+        for (const auto& triangles : workload.cases) {
+            if (i < triangles.size()) {
+                workload.mixed.push_back(triangles[i]);
+            }
+        }
+    }
+    return workload;
+}
+
+const Workload& GetWorkload() {
+    static const Workload workload = LoadWorkload();
+    return workload;
+}
+
+std::vector<Triangle> ToTriangles(const std::vector<CompactTriangle>& triangles, AngleUnit unit) {
+    std::vector<Triangle> result;
+    result.reserve(triangles.size());
+    for (CompactTriangle triangle : triangles) {
+        if (unit == AngleUnit::Radians) {
+            triangle.angleA = ToRadians(triangle.angleA);
+            triangle.angleB = ToRadians(triangle.angleB);
+            triangle.angleC = ToRadians(triangle.angleC);
+        }
+        result.push_back(triangle.toTriangle());
+    }
+    return result;
+}
+
+// Reports triangles/s, the time per triangle and the allocations per triangle.
+// Call it after the timing loop with the allocation count from before the loop.
+void ReportPerTriangle(benchmark::State& state, std::size_t trianglesPerIteration, std::uint64_t allocationsBefore) {
+    const double triangles = static_cast<double>(state.iterations()) * static_cast<double>(trianglesPerIteration);
+    const auto allocations = static_cast<double>(g_allocations.load(std::memory_order_relaxed) - allocationsBefore);
+    state.counters["triangles/s"] = benchmark::Counter(triangles, benchmark::Counter::kIsRate);
+    state.counters["time/triangle"] = benchmark::Counter(triangles, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.counters["allocs/triangle"] = benchmark::Counter(triangles > 0 ? allocations / triangles : 0.0);
+}
+
+// Solves the triangles of one case one at a time through the backend (radians, no unit conversion)
+void BM_BackendCase(benchmark::State& state) {
+    const auto solverCase = static_cast<SolverCase>(state.range(0));
+    const std::vector<Triangle> triangles =
+        ToTriangles(GetWorkload().cases[static_cast<std::size_t>(solverCase)], AngleUnit::Radians);
+    if (triangles.empty()) {
+        state.SkipWithError("the fixture has no triangles for this case");
+        return;
+    }
+    state.SetLabel(CaseNames[static_cast<std::size_t>(solverCase)]);
+    const AmbiguousCaseSolution solution =
+        solverCase == SolverCase::SSATwoSolutions ? AmbiguousCaseSolution::FirstSolution : AmbiguousCaseSolution::NoSolution;
+
+    std::size_t index = 0;
+    const std::uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        Triangle triangle = triangles[index];
+        benchmark::DoNotOptimize(TriangleCalculatorBackend::finalizeTriangle(triangle, solution));
+        benchmark::DoNotOptimize(triangle);
+        index = index + 1 == triangles.size() ? 0 : index + 1;
+    }
+    ReportPerTriangle(state, 1, allocations);
+}
+BENCHMARK(BM_BackendCase)->DenseRange(0, static_cast<int>(SolverCase::Count) - 1);
+
+// The trig-bound cases through the backend in each precision tier (range(1): 0 Exact, 1 Fast)
+void BM_BackendCasePrecision(benchmark::State& state) {
+    const auto solverCase = static_cast<SolverCase>(state.range(0));
+    const auto precision = static_cast<Precision>(state.range(1));
+    const std::vector<Triangle> triangles =
+        ToTriangles(GetWorkload().cases[static_cast<std::size_t>(solverCase)], AngleUnit::Radians);
+    state.SetLabel(std::string(CaseNames[static_cast<std::size_t>(solverCase)]) + (precision == Precision::Fast ? " fast" : " exact"));
+
+    std::size_t index = 0;
+    const std::uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        Triangle triangle = triangles[index];
+        benchmark::DoNotOptimize(TriangleCalculatorBackend::finalizeTriangle(triangle, precision));
+        benchmark::DoNotOptimize(triangle);
+        index = index + 1 == triangles.size() ? 0 : index + 1;
+    }
+    ReportPerTriangle(state, 1, allocations);
+}
+BENCHMARK(BM_BackendCasePrecision)->ArgsProduct({{static_cast<int>(SolverCase::SSS), static_cast<int>(SolverCase::SAS)}, {0, 1}});
+
+// The public single triangle API in each unit, against the backend above it shows what the
+// degree conversion and the wrapper cost
+void BM_FinalizeTriangleUnit(benchmark::State& state) {
+    const auto unit = static_cast<AngleUnit>(state.range(0));
+    const std::vector<Triangle> triangles = ToTriangles(GetWorkload().mixed, unit);
+    state.SetLabel(unit == AngleUnit::Degrees ? "degrees" : "radians");
+
+    std::size_t index = 0;
+    const std::uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TriangleCalculator::finalizeTriangle(triangles[index], unit));
+        index = index + 1 == triangles.size() ? 0 : index + 1;
+    }
+    ReportPerTriangle(state, 1, allocations);
+}
+BENCHMARK(BM_FinalizeTriangleUnit)
+    ->Arg(static_cast<int>(AngleUnit::Degrees))
+    ->Arg(static_cast<int>(AngleUnit::Radians));
+
+// The degree API through a cache, on a stream that repeats a set of range(0) shapes
+void BM_FinalizeTriangleCached(benchmark::State& state) {
+    std::vector<Triangle> triangles = ToTriangles(GetWorkload().mixed, AngleUnit::Degrees);
+    triangles.resize(std::min<std::size_t>(triangles.size(), static_cast<std::size_t>(state.range(0))));
+    TriangleCache cache(1024);
+
+    std::size_t index = 0;
+    const std::uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TriangleCalculator::finalizeTriangle(triangles[index], AngleUnit::Degrees, cache));
+        index = index + 1 == triangles.size() ? 0 : index + 1;
+    }
+    ReportPerTriangle(state, 1, allocations);
+    state.counters["hit rate"] = cache.stats().hitRate();
+}
+BENCHMARK(BM_FinalizeTriangleCached)->Arg(64)->Arg(4096);
+
+void BM_BackendMixed(benchmark::State& state) {
+    const std::vector<Triangle> triangles = ToTriangles(GetWorkload().mixed, AngleUnit::Radians);
+
+    std::size_t index = 0;
+    const std::uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        Triangle triangle = triangles[index];
+        benchmark::DoNotOptimize(TriangleCalculatorBackend::finalizeTriangle(triangle));
+        benchmark::DoNotOptimize(triangle);
+        index = index + 1 == triangles.size() ? 0 : index + 1;
+    }
+    ReportPerTriangle(state, 1, allocations);
+}
+BENCHMARK(BM_BackendMixed);
+
+// the mixed workload solved in each scalar type
+template <typename T>
+void BM_BackendMixedScalarType(benchmark::State& state) {
+    std::vector<BasicTriangle<T>> triangles;
+    for (const Triangle& triangle : ToTriangles(GetWorkload().mixed, AngleUnit::Radians)) {
+        auto convert = [](const std::optional<double>& value) { return value ? std::optional<T>(static_cast<T>(*value)) : std::nullopt; };
+        triangles.push_back({convert(triangle.sideA), convert(triangle.sideB), convert(triangle.sideC),
+                             convert(triangle.angleA), convert(triangle.angleB), convert(triangle.angleC)});
+    }
+
+    std::size_t index = 0;
+    const std::uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        BasicTriangle<T> triangle = triangles[index];
+        benchmark::DoNotOptimize(TriangleCalculatorBackend::finalizeTriangle(triangle));
+        benchmark::DoNotOptimize(triangle);
+        index = index + 1 == triangles.size() ? 0 : index + 1;
+    }
+    ReportPerTriangle(state, 1, allocations);
+}
+BENCHMARK_TEMPLATE(BM_BackendMixedScalarType, float);
+BENCHMARK_TEMPLATE(BM_BackendMixedScalarType, double);
+BENCHMARK_TEMPLATE(BM_BackendMixedScalarType, long double);
+
+// dispatching a runtime rotation to its compile-time TriangleView and reading through it
+void BM_TriangleViewRotation(benchmark::State& state) {
+    Triangle triangle = ToTriangles(GetWorkload().mixed, AngleUnit::Radians).front();
+    int rotation = static_cast<int>(state.range(0));
+
+    const std::uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&triangle);
+        benchmark::DoNotOptimize(rotation);
+        WithRotation(triangle, rotation, [](auto view) {
+            benchmark::DoNotOptimize(view.sideA());
+            benchmark::DoNotOptimize(view.angleC());
+        });
+    }
+    ReportPerTriangle(state, 1, allocations);
+}
+BENCHMARK(BM_TriangleViewRotation)->Arg(0)->Arg(1);
+
+// the batch API on every case at once, for comparison with the single triangle calls
+void BM_FinalizeTrianglesBatch(benchmark::State& state) {
+    const std::vector<CompactTriangle>& mixed = GetWorkload().mixed;
+    const auto count = static_cast<std::size_t>(state.range(0));
+    TriangleBatch input(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        input.set(i, mixed[i % mixed.size()]);
+    }
+    TriangleBatch batch(count);
+
+    const std::uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        state.PauseTiming();
+        batch = input;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(TriangleCalculator::finalizeTriangles(batch.columns()));
+    }
+    // the batch copy between iterations allocates nothing, its vectors already have the capacity
+    ReportPerTriangle(state, count, allocations);
+}
+BENCHMARK(BM_FinalizeTrianglesBatch)->Arg(1 << 12)->Arg(1 << 16);
+
+// the batch API on the mixed workload in each precision tier (range(0): 0 Exact, 1 Fast, 2 Mixed)
+void BM_FinalizeTrianglesBatchPrecision(benchmark::State& state) {
+    const std::vector<CompactTriangle>& mixed = GetWorkload().mixed;
+    const auto precision = static_cast<Precision>(state.range(0));
+    const std::size_t count = 1 << 12;
+    TriangleBatch input(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        input.set(i, mixed[i % mixed.size()]);
+    }
+    TriangleBatch batch(count);
+    state.SetLabel(precision == Precision::Fast ? "fast" : precision == Precision::Mixed ? "mixed" : "exact");
+
+    const std::uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        state.PauseTiming();
+        batch = input;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(TriangleCalculator::finalizeTriangles(batch.columns(), AngleUnit::Degrees, precision));
+    }
+    ReportPerTriangle(state, count, allocations);
+}
+BENCHMARK(BM_FinalizeTrianglesBatchPrecision)->Arg(0)->Arg(1)->Arg(2);
+
+// the price of the solver stats (range(0): 0 off, 1 on), scalar solves pay two clock reads each,
+// batches two per case and block of rows
+void BM_BackendStats(benchmark::State& state) {
+    const std::vector<Triangle> triangles = ToTriangles(GetWorkload().mixed, AngleUnit::Radians);
+    SolverStats::setEnabled(state.range(0) != 0);
+    state.SetLabel(state.range(0) != 0 ? "stats on" : "stats off");
+
+    std::size_t index = 0;
+    const std::uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        Triangle triangle = triangles[index];
+        benchmark::DoNotOptimize(TriangleCalculatorBackend::finalizeTriangle(triangle));
+        benchmark::DoNotOptimize(triangle);
+        index = index + 1 == triangles.size() ? 0 : index + 1;
+    }
+    SolverStats::setEnabled(false);
+    ReportPerTriangle(state, 1, allocations);
+}
+BENCHMARK(BM_BackendStats)->Arg(0)->Arg(1);
+
+void BM_FinalizeTrianglesBatchStats(benchmark::State& state) {
+    const std::vector<CompactTriangle>& mixed = GetWorkload().mixed;
+    const std::size_t count = 1 << 12;
+    TriangleBatch input(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        input.set(i, mixed[i % mixed.size()]);
+    }
+    TriangleBatch batch(count);
+    SolverStats::setEnabled(state.range(0) != 0);
+    state.SetLabel(state.range(0) != 0 ? "stats on" : "stats off");
+
+    const std::uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        state.PauseTiming();
+        batch = input;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(TriangleCalculator::finalizeTriangles(batch.columns()));
+    }
+    SolverStats::setEnabled(false);
+    ReportPerTriangle(state, count, allocations);
+}
+BENCHMARK(BM_FinalizeTrianglesBatchStats)->Arg(0)->Arg(1);
+
+// the workload generator (range(0): 0 into columns, 1 as CSV text, 2 as NDJSON text), one thread
+void BM_GenerateTriangles(benchmark::State& state) {
+    const std::size_t count = 1 << 16;
+    GeneratorOptions options;
+    options.mix.ambiguousFraction = 0.1;
+    options.mix.invalidFraction = 0.1;
+    TriangleBatch batch(count);
+    std::ostringstream text;
+    state.SetLabel(state.range(0) == 0 ? "columns" : state.range(0) == 1 ? "csv" : "ndjson");
+
+    std::int64_t bytes = 0;
+    const std::uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            TriangleGenerator::generate(options, batch.columns());
+            continue;
+        }
+        text.str({});
+        TriangleGenerator::write(text, state.range(0) == 1 ? StreamFormat::Csv : StreamFormat::Ndjson, count, options);
+        bytes += static_cast<std::int64_t>(text.tellp());
+    }
+    if (bytes > 0) {
+        state.SetBytesProcessed(bytes);
+    }
+    ReportPerTriangle(state, count, allocations);
+}
+BENCHMARK(BM_GenerateTriangles)->Arg(0)->Arg(1)->Arg(2);
+
+// The fixture file copied to 4 MB, read into columns through the nlohmann DOM (0) and the streaming reader (1)
+void BM_ReadJsonFixture(benchmark::State& state) {
+    std::ifstream input(TRIANGLE_FIXTURE_PATH);
+    const std::string fixture((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    std::string text;
+    while (text.size() < (4u << 20)) {
+        text += fixture;
+    }
+    const std::size_t copies = text.size() / fixture.size();
+    const auto categories = {"right", "equilateral", "isosceles", "scalene"};
+    std::size_t perCopy = 0;
+    const auto parsed = nlohmann::json::parse(fixture);
+    for (const auto& category : categories) {
+        perCopy += parsed.at(category).size();
+    }
+    const std::size_t count = perCopy * copies;
+    TriangleBatch batch(count);
+    state.SetLabel(state.range(0) == 0 ? "dom" : "streaming");
+
+    const std::uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        std::size_t filled = 0;
+        if (state.range(0) == 0) {
+            for (std::size_t copy = 0; copy < copies; ++copy) {
+                const auto document = nlohmann::json::parse(std::string_view(text).substr(copy * fixture.size(), fixture.size()));
+                for (const auto& category : categories) {
+                    for (const auto& entry : document.at(category)) {
+                        const auto& sides = entry.at("sides");
+                        const auto& angles = entry.at("angles");
+                        batch.set(filled++, CompactTriangle{sides[0].get<double>(), sides[1].get<double>(), sides[2].get<double>(),
+                                                            angles[0].get<double>(), angles[1].get<double>(), angles[2].get<double>(),
+                                                            KnownField::All});
+                    }
+                }
+            }
+        } else {
+            TriangleJsonReader reader{std::string_view{text}};
+            filled = reader.read(batch.columns());
+        }
+        if (filled != count) {
+            state.SkipWithError("not every triangle was read");
+            break;
+        }
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * text.size()));
+    ReportPerTriangle(state, count, allocations);
+}
+BENCHMARK(BM_ReadJsonFixture)->Arg(0)->Arg(1);
+
+// One request at a time from a local client to a TriangleServer and back: a CSV line (0) or a binary
+// request of one triangle (1), with the p50 and p99 round trip of the run
+void BM_ServerRoundTrip(benchmark::State& state) {
+    ServerOptions options;
+    options.socketPath = std::filesystem::temp_directory_path() / "TriangleServerBenchmark.sock";
+    TriangleServer server(options);
+    if (server.listen() != ResultCode::Success) {
+        state.SkipWithError("the server can not listen");
+        return;
+    }
+    std::thread loop([&server] { server.run(); });
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, options.socketPath.c_str(), sizeof(address.sun_path) - 1);
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        state.SkipWithError("the client can not connect");
+    }
+    const bool binary = state.range(0) == 1;
+    std::string request = "30,60,?,?,?,2\n";
+    if (binary) {
+        request.clear();
+        const CompactTriangle triangle{0.0, 0.0, 2.0, 30.0, 60.0, 0.0,
+                                       static_cast<std::uint8_t>(KnownField::SideC | KnownField::AngleA | KnownField::AngleB)};
+        ServerProtocol::appendRequest(request, std::span(&triangle, 1));
+    }
+    state.SetLabel(binary ? "binary" : "csv line");
+
+    std::vector<std::int64_t> latencies;
+    std::array<char, 256> reply;
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        ::send(fd, request.data(), request.size(), 0);
+        // a reply fits one read: a line of ~60 bytes, or 58 binary bytes
+        if (::read(fd, reply.data(), reply.size()) <= 0) {
+            state.SkipWithError("the server closed the connection");
+            break;
+        }
+        latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+    ::close(fd);
+    server.stop();
+    loop.join();
+
+    if (!latencies.empty()) {
+        std::sort(latencies.begin(), latencies.end());
+        state.counters["p50_us"] = static_cast<double>(latencies[latencies.size() / 2]) / 1000.0;
+        state.counters["p99_us"] = static_cast<double>(latencies[latencies.size() * 99 / 100]) / 1000.0;
+    }
+}
+BENCHMARK(BM_ServerRoundTrip)->Arg(0)->Arg(1);
+
+// Receives the log records of the logging benchmarks and throws them away
+class DiscardingLogger final : public logiface::logger {
+public:
+    explicit DiscardingLogger(logiface::level lvl) : level_(lvl) {}
+
+    void log(const logiface::record& r) override { benchmark::DoNotOptimize(r.message.data()); }
+    void set_level(logiface::level lvl) noexcept override { level_ = lvl; }
+    logiface::level get_level() const noexcept override { return level_; }
+
+private:
+    logiface::level level_;
+};
+
+// The mixed workload with a logger installed at the given level (trace passes every record,
+// critical none), without a logger for -1. TriangleCalculatorBenchmarksNoLogging runs the
+// same benchmark with logging compiled out (LOGIFACE_ENABLE_LOGGING=0).
+void BM_BackendLogging(benchmark::State& state) {
+    const std::vector<Triangle> triangles = ToTriangles(GetWorkload().mixed, AngleUnit::Radians);
+    const bool installLogger = state.range(0) >= 0;
+    DiscardingLogger sink(installLogger ? static_cast<logiface::level>(state.range(0)) : logiface::level::critical);
+    logiface::set_logger(installLogger ? &sink : nullptr);
+    state.SetLabel(LOGIFACE_ENABLE_LOGGING ? "logging compiled in" : "logging compiled out");
+
+    std::size_t index = 0;
+    const std::uint64_t allocations = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        Triangle triangle = triangles[index];
+        benchmark::DoNotOptimize(TriangleCalculatorBackend::finalizeTriangle(triangle));
+        benchmark::DoNotOptimize(triangle);
+        index = index + 1 == triangles.size() ? 0 : index + 1;
+    }
+    ReportPerTriangle(state, 1, allocations);
+    logiface::set_logger(nullptr);
+}
+BENCHMARK(BM_BackendLogging)
+    ->Arg(-1)
+    ->Arg(static_cast<int>(logiface::level::trace))
+    ->Arg(static_cast<int>(logiface::level::info))
+    ->Arg(static_cast<int>(logiface::level::critical));
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,77 @@
+#ifndef COMPACT_TRIANGLE_HPP
+#define COMPACT_TRIANGLE_HPP
+
+#include "Triangle.hpp"
+
+#include <cstdint>
+#include <optional>
+
+namespace TriangleCalculatorLib
+{
+    // bits of the known-mask, one per triangle field
+    namespace KnownField
+    {
+        inline constexpr std::uint8_t SideA = 1u << 0;
+        inline constexpr std::uint8_t SideB = 1u << 1;
+        inline constexpr std::uint8_t SideC = 1u << 2;
+        inline constexpr std::uint8_t AngleA = 1u << 3;
+        inline constexpr std::uint8_t AngleB = 1u << 4;
+        inline constexpr std::uint8_t AngleC = 1u << 5;
+
+        inline constexpr std::uint8_t Sides = SideA | SideB | SideC;
+        inline constexpr std::uint8_t Angles = AngleA | AngleB | AngleC;
+        inline constexpr std::uint8_t All = Sides | Angles;
+    } // namespace KnownField
+
+    /// Triangle stored as six plain doubles and a known-field bitmask (56 bytes instead of the 96 of Triangle).
+    /// A value is only meaningful when its bit is set in `known`, unknown values are kept at 0.
+    struct CompactTriangle
+    {
+        double sideA = 0.0;
+        double sideB = 0.0;
+        double sideC = 0.0;
+        double angleA = 0.0;
+        double angleB = 0.0;
+        double angleC = 0.0;
+        std::uint8_t known = 0;
+
+        bool isKnown(std::uint8_t field) const noexcept { return (known & field) == field; }
+
+        /// Pack a triangle, unknown fields clear their mask bit
+        static CompactTriangle fromTriangle(const Triangle& triangle) noexcept
+        {
+            CompactTriangle compact;
+            auto store = [&compact](double& field, const std::optional<double>& value, std::uint8_t bit) {
+                field = value.value_or(0.0);
+                if (value.has_value()) { compact.known |= bit; }
+            };
+            store(compact.sideA, triangle.sideA, KnownField::SideA);
+            store(compact.sideB, triangle.sideB, KnownField::SideB);
+            store(compact.sideC, triangle.sideC, KnownField::SideC);
+            store(compact.angleA, triangle.angleA, KnownField::AngleA);
+            store(compact.angleB, triangle.angleB, KnownField::AngleB);
+            store(compact.angleC, triangle.angleC, KnownField::AngleC);
+            return compact;
+        }
+
+        /// Unpack into a triangle holding only the known fields
+        Triangle toTriangle() const noexcept
+        {
+            auto load = [this](double field, std::uint8_t bit) {
+                return (known & bit) ? std::optional<double>(field) : std::nullopt;
+            };
+            Triangle triangle;
+            triangle.sideA = load(sideA, KnownField::SideA);
+            triangle.sideB = load(sideB, KnownField::SideB);
+            triangle.sideC = load(sideC, KnownField::SideC);
+            triangle.angleA = load(angleA, KnownField::AngleA);
+            triangle.angleB = load(angleB, KnownField::AngleB);
+            triangle.angleC = load(angleC, KnownField::AngleC);
+            return triangle;
+        }
+    };
+
+    static_assert(sizeof(CompactTriangle) == 7 * sizeof(double), "CompactTriangle should stay six doubles plus the mask");
+} // namespace TriangleCalculatorLib
+
+#endif // COMPACT_TRIANGLE_HPP
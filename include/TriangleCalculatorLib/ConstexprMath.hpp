@@ -0,0 +1,242 @@
+#ifndef CONSTEXPR_MATH_HPP
+#define CONSTEXPR_MATH_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace TriangleCalculatorLib
+{
+    /// Math functions usable in constant expressions, where the std:: ones are not constexpr.
+    /// Results are within a few ulp of the std:: functions for the arguments a triangle produces
+    /// (angles within [-2pi, 2pi]), which is well inside ABSOLUTE_TOLERANCE.
+    class ConstexprMath
+    {
+    public:
+        static constexpr double pi = 3.141592653589793238462643383279502884;
+
+        template <typename T>
+        static constexpr T abs(T x) { return x < 0 ? -x : x; }
+
+        static constexpr double sqrt(double x)
+        {
+            if (x != x || x < 0)
+            {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            if (x == 0 || x == std::numeric_limits<double>::infinity())
+            {
+                return x;
+            }
+            // scale into [0.25, 4) by powers of four, which keeps the result exact to scale back
+            double scale = 1.0;
+            while (x >= 4.0)
+            {
+                x *= 0.25;
+                scale *= 2.0;
+            }
+            while (x < 0.25)
+            {
+                x *= 4.0;
+                scale *= 0.5;
+            }
+            // Newton's method from 1 has converged for this range after 7 steps
+            double y = 1.0;
+            for (int i = 0; i < 7; ++i)
+            {
+                y = 0.5 * (y + x / y);
+            }
+            return y * scale;
+        }
+
+        static constexpr double sin(double x) { return sinQuadrant(x, 0); }
+
+        static constexpr double cos(double x) { return sinQuadrant(x, 1); }
+
+        static constexpr double atan(double x)
+        {
+            if (x != x)
+            {
+                return x;
+            }
+            if (x < 0)
+            {
+                return -atan(-x);
+            }
+            if (x > 1.0)
+            {
+                return pi / 2 - atan(1.0 / x);
+            }
+            // atan(x) = 2 atan(x / (1 + sqrt(1 + x^2))), twice brings x below tan(pi / 16)
+            for (int i = 0; i < 2; ++i)
+            {
+                x = x / (1.0 + sqrt(1.0 + x * x));
+            }
+            const double x2 = x * x;
+            double term = x;
+            double sum = x;
+            for (int n = 1; n < 20; ++n)
+            {
+                term *= -x2;
+                sum += term / (2 * n + 1);
+            }
+            return 4.0 * sum;
+        }
+
+        static constexpr double asin(double x)
+        {
+            if (x != x || x < -1.0 || x > 1.0)
+            {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            if (abs(x) == 1.0)
+            {
+                return x * (pi / 2);
+            }
+            return atan(x / sqrt((1.0 - x) * (1.0 + x)));
+        }
+
+        static constexpr double acos(double x)
+        {
+            if (x != x || x < -1.0 || x > 1.0)
+            {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            if (x == -1.0)
+            {
+                return pi;
+            }
+            // the half angle form stays accurate near x = 1, where pi / 2 - asin(x) cancels
+            return 2.0 * atan(sqrt((1.0 - x) / (1.0 + x)));
+        }
+
+        /// f(d degrees) for every integer degree d in [0, 360)
+        static constexpr std::array<double, 360> degreeTable(double (*f)(double))
+        {
+            std::array<double, 360> table{};
+            for (std::size_t degrees = 0; degrees < table.size(); ++degrees)
+            {
+                table[degrees] = f(static_cast<double>(degrees) * pi / 180.0);
+            }
+            return table;
+        }
+
+    private:
+        // sin(x + quadrant * pi / 2)
+        static constexpr double sinQuadrant(double x, long long quadrant)
+        {
+            if (x != x || abs(x) == std::numeric_limits<double>::infinity())
+            {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            // x = k * pi / 2 + r with |r| <= pi / 4, pi / 2 split in two parts so r keeps its low bits
+            constexpr double halfPiHigh = 1.57079632679489655800e+00;
+            constexpr double halfPiLow = 6.12323399573676603587e-17;
+            const double scaled = x / halfPiHigh;
+            const auto k = static_cast<long long>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+            const double r = (x - static_cast<double>(k) * halfPiHigh) - static_cast<double>(k) * halfPiLow;
+            const double r2 = r * r;
+
+            switch (((k + quadrant) % 4 + 4) % 4)
+            {
+            case 0:
+                return sinSeries(r, r2);
+            case 1:
+                return cosSeries(r2);
+            case 2:
+                return -sinSeries(r, r2);
+            default:
+                return -cosSeries(r2);
+            }
+        }
+
+        // Taylor series, the terms left out are below 1e-19 for |r| <= pi / 4
+        static constexpr double sinSeries(double r, double r2)
+        {
+            double term = r;
+            double sum = r;
+            for (int n = 1; n < 12; ++n)
+            {
+                term *= -r2 / ((2 * n) * (2 * n + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+        static constexpr double cosSeries(double r2)
+        {
+            double term = 1.0;
+            double sum = 1.0;
+            for (int n = 1; n < 12; ++n)
+            {
+                term *= -r2 / ((2 * n - 1) * (2 * n));
+                sum += term;
+            }
+            return sum;
+        }
+    };
+
+    /// sin and cos of every integer degree in [0, 360), computed at compile time
+    inline constexpr std::array<double, 360> IntegerDegreeSines = ConstexprMath::degreeTable(&ConstexprMath::sin);
+    inline constexpr std::array<double, 360> IntegerDegreeCosines = ConstexprMath::degreeTable(&ConstexprMath::cos);
+
+    /// The tolerance of the solver comparisons per scalar type: scaled by max(1, |a|, |b|), so it is absolute
+    /// for small values and relative for large ones. Float gets a wider one, its epsilon is already 1.2e-7.
+    template <typename T>
+    struct ToleranceTraits;
+
+    template <>
+    struct ToleranceTraits<float>
+    {
+        static constexpr float absolute = 1e-5f;
+    };
+
+    template <>
+    struct ToleranceTraits<double>
+    {
+        static constexpr double absolute = 2e-7;
+    };
+
+    template <>
+    struct ToleranceTraits<long double>
+    {
+        static constexpr long double absolute = 2e-7L;
+    };
+
+    // the comparisons of the solvers, internal: not part of the library interface
+    namespace detail
+    {
+        // Utility function for floating-point comparison with absolute tolerance
+        // Using absolute tolerance (1e-9) instead of relative to avoid precision issues
+        inline constexpr double ABSOLUTE_TOLERANCE = ToleranceTraits<double>::absolute;
+
+        // the scalar type comes from the first argument, so IsGreater(side, 0) compares in the type of side
+        template <typename T>
+        constexpr bool IsEqual(T a, std::type_identity_t<T> b, std::type_identity_t<T> epsilon = ToleranceTraits<T>::absolute)
+        {
+            return ConstexprMath::abs(a - b) <= epsilon * std::max({T(1), ConstexprMath::abs(a), ConstexprMath::abs(b)});
+        }
+
+        template <typename T>
+        constexpr bool IsLess(T a, std::type_identity_t<T> b, std::type_identity_t<T> epsilon = ToleranceTraits<T>::absolute)
+        {
+            return a < b - epsilon * std::max({T(1), ConstexprMath::abs(a), ConstexprMath::abs(b)});
+        }
+
+        template <typename T>
+        constexpr bool IsLessOrEqual(T a, std::type_identity_t<T> b, std::type_identity_t<T> epsilon = ToleranceTraits<T>::absolute)
+        {
+            return a < b + epsilon * std::max({T(1), ConstexprMath::abs(a), ConstexprMath::abs(b)});
+        }
+
+        template <typename T>
+        constexpr bool IsGreater(T a, std::type_identity_t<T> b, std::type_identity_t<T> epsilon = ToleranceTraits<T>::absolute)
+        {
+            return a > b + epsilon * std::max({T(1), ConstexprMath::abs(a), ConstexprMath::abs(b)});
+        }
+    } // namespace detail
+} // namespace TriangleCalculatorLib
+
+#endif // CONSTEXPR_MATH_HPP
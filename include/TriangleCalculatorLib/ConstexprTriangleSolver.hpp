@@ -0,0 +1,310 @@
+#ifndef CONSTEXPR_TRIANGLE_SOLVER_HPP
+#define CONSTEXPR_TRIANGLE_SOLVER_HPP
+
+#include "CompactTriangle.hpp"
+#include "ConstexprMath.hpp"
+#include "ReturnCode.hpp"
+#include "Triangle.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace TriangleCalculatorLib
+{
+    /// Solver that can run at compile time, for tables of fixed triangles:
+    ///     constexpr CompactTriangle rightTriangle = ConstexprTriangleSolver::solved({3, 4, 5, 0, 0, 0, KnownField::Sides});
+    /// It takes the same case decisions as the runtime solver (SSS, SAS, SSA, ASA and AAS) with the math
+    /// from ConstexprMath (and without fused multiply-adds), results agree with TriangleCalculator::finalizeTriangle
+    /// far inside detail::ABSOLUTE_TOLERANCE.
+    class ConstexprTriangleSolver
+    {
+    public:
+        /// Solve a triangle in place
+        /// @param triangle Solved fields are written back and their known bits set
+        /// @param unit The unit of the angles
+        /// @return Success or InsufficientData, like TriangleCalculator::finalizeTriangle
+        static constexpr ResultCode solve(CompactTriangle& triangle, AngleUnit unit = AngleUnit::Degrees,
+                                          AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution)
+        {
+            if (unit == AngleUnit::Radians)
+            {
+                return solveRadians(triangle, ambiguousCaseSolution);
+            }
+
+            scaleAngles(triangle, ConstexprMath::pi, 180.0);
+            const ResultCode code = solveRadians(triangle, ambiguousCaseSolution);
+            scaleAngles(triangle, 180.0, ConstexprMath::pi);
+            return code;
+        }
+
+        /// The solved triangle, a triangle that can not be solved comes back unchanged
+        static constexpr CompactTriangle solved(CompactTriangle triangle, AngleUnit unit = AngleUnit::Degrees,
+                                                AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution)
+        {
+            solve(triangle, unit, ambiguousCaseSolution);
+            return triangle;
+        }
+
+    private:
+        // the fields of a triangle rotated so that field `first` is a: like TriangleView in the runtime solver
+        class View
+        {
+        public:
+            constexpr View(CompactTriangle& triangle, int first) : triangle_(triangle), first_(((first % 3) + 3) % 3) {}
+
+            constexpr double side(int i) const { return sideField(i); }
+            constexpr double angle(int i) const { return angleField(i); }
+            constexpr bool hasSide(int i) const { return triangle_.known & sideBit(i); }
+            constexpr bool hasAngle(int i) const { return triangle_.known & angleBit(i); }
+            // known and positive, the runtime solver treats other sides as unknown
+            constexpr bool hasPositiveSide(int i) const { return hasSide(i) && detail::IsGreater(side(i), 0); }
+
+            constexpr void setSide(int i, double value) const
+            {
+                sideField(i) = value;
+                triangle_.known |= sideBit(i);
+            }
+
+            constexpr void setAngle(int i, double value) const
+            {
+                angleField(i) = value;
+                triangle_.known |= angleBit(i);
+            }
+
+        private:
+            constexpr int index(int i) const { return (first_ + i) % 3; }
+            constexpr std::uint8_t sideBit(int i) const { return static_cast<std::uint8_t>(KnownField::SideA << index(i)); }
+            constexpr std::uint8_t angleBit(int i) const { return static_cast<std::uint8_t>(KnownField::AngleA << index(i)); }
+
+            constexpr double& sideField(int i) const
+            {
+                const int field = index(i);
+                return field == 0 ? triangle_.sideA : field == 1 ? triangle_.sideB : triangle_.sideC;
+            }
+
+            constexpr double& angleField(int i) const
+            {
+                const int field = index(i);
+                return field == 0 ? triangle_.angleA : field == 1 ? triangle_.angleB : triangle_.angleC;
+            }
+
+            CompactTriangle& triangle_;
+            int first_;
+        };
+
+        static constexpr int A = 0;
+        static constexpr int B = 1;
+        static constexpr int C = 2;
+
+        static constexpr void scaleAngles(CompactTriangle& triangle, double multiplier, double divisor)
+        {
+            const View view(triangle, 0);
+            for (int i = 0; i < 3; ++i)
+            {
+                if (view.hasAngle(i))
+                {
+                    view.setAngle(i, view.angle(i) * multiplier / divisor);
+                }
+            }
+        }
+
+        static constexpr int knownAngleCount(const View& view)
+        {
+            return static_cast<int>(view.hasAngle(A)) + static_cast<int>(view.hasAngle(B)) + static_cast<int>(view.hasAngle(C));
+        }
+
+        static constexpr int knownSideCount(const View& view)
+        {
+            return static_cast<int>(view.hasPositiveSide(A)) + static_cast<int>(view.hasPositiveSide(B)) +
+                   static_cast<int>(view.hasPositiveSide(C));
+        }
+
+        // the first field (0 for a, 1 for b, 2 for c) the predicate holds for
+        template <typename Predicate>
+        static constexpr int findFirst(const View& view, Predicate predicate)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                if (predicate(view, i))
+                {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        static constexpr int findLargestSide(const View& view)
+        {
+            int largest = -1;
+            double largestValue = -1.0;
+            for (int i = 0; i < 3; ++i)
+            {
+                if (view.hasSide(i) && view.side(i) > largestValue)
+                {
+                    largestValue = view.side(i);
+                    largest = i;
+                }
+            }
+            return largest;
+        }
+
+        // two angles known, the third one follows from the angle sum
+        static constexpr void solveThirdAngle(CompactTriangle& triangle)
+        {
+            const View tri(triangle, findFirst(View(triangle, 0), [](const View& view, int i) { return !view.hasAngle(i); }));
+            tri.setAngle(A, ConstexprMath::pi - (tri.angle(B) + tri.angle(C)));
+        }
+
+        // all sides known: the angle at the largest side from the law of cosines, the others from the law of sines
+        static constexpr void solveAnglesWithSides(CompactTriangle& triangle)
+        {
+            const View tri(triangle, findLargestSide(View(triangle, 0)));
+            const double a = tri.side(A);
+            const double b = tri.side(B);
+            const double c = tri.side(C);
+
+            if (!tri.hasAngle(A))
+            {
+                double cosA = (b * b + (c * c - a * a)) / (2 * b * c);
+                cosA = std::max(-1.0, std::min(1.0, cosA));
+                tri.setAngle(A, ConstexprMath::acos(cosA));
+            }
+            const double angleA = tri.angle(A);
+
+            if (!tri.hasAngle(B))
+            {
+                if (knownAngleCount(tri) == 2)
+                {
+                    tri.setAngle(B, ConstexprMath::pi - angleA - tri.angle(C));
+                    return;
+                }
+
+                double sinB = b * (ConstexprMath::sin(angleA) / a);
+                sinB = std::max(-1.0, std::min(1.0, sinB));
+                const double angleB = ConstexprMath::asin(sinB);
+                tri.setAngle(B, angleB);
+
+                if (!tri.hasAngle(C))
+                {
+                    tri.setAngle(C, ConstexprMath::pi - angleA - angleB);
+                }
+            }
+            else if (!tri.hasAngle(C))
+            {
+                tri.setAngle(C, ConstexprMath::pi - angleA - tri.angle(B));
+            }
+        }
+
+        // all angles known: the missing sides from the law of sines, scaled by the first known side
+        static constexpr void solveSides(CompactTriangle& triangle)
+        {
+            const View tri(triangle, findFirst(View(triangle, 0), [](const View& view, int i) { return view.hasPositiveSide(i); }));
+            const double a = tri.side(A);
+            const double sinA = ConstexprMath::sin(tri.angle(A));
+            for (int i : {B, C})
+            {
+                if (!tri.hasSide(i) || detail::IsLessOrEqual(tri.side(i), 0))
+                {
+                    tri.setSide(i, a * ConstexprMath::sin(tri.angle(i)) / sinA);
+                }
+            }
+        }
+
+        // two sides and the angle between them (angle a): the third side from the law of cosines
+        static constexpr void solveSideWithAngleCos(const View& tri)
+        {
+            const double b = tri.side(B);
+            const double c = tri.side(C);
+            const double result = b * b + (c * c - 2 * b * c * ConstexprMath::cos(tri.angle(A)));
+            tri.setSide(A, ConstexprMath::sqrt(std::max(0.0, result)));
+        }
+
+        // two sides and an angle that is not between them (angle a): the angle at the other known side
+        static constexpr bool resolveSSA(const View& tri, AmbiguousCaseSolution ambiguousCaseSolution)
+        {
+            const int other = tri.hasSide(B) ? B : C;
+            const double a = tri.side(A);
+            const double otherSide = tri.side(other);
+            const double sinAngleA = ConstexprMath::sin(tri.angle(A));
+            const double h = (tri.hasPositiveSide(B) ? tri.side(B) : tri.hasPositiveSide(C) ? tri.side(C) : 0.0) * sinAngleA;
+
+            if (detail::IsLess(a, h) && !detail::IsEqual(a, h))
+            {
+                return false;
+            }
+            if (detail::IsEqual(a, h))
+            {
+                tri.setAngle(other, ConstexprMath::pi / 2.0);
+                return true;
+            }
+            const bool hasTwoSolutions = detail::IsLess(h, a) && detail::IsLess(a, otherSide);
+
+            double sinAngle = otherSide * sinAngleA / a;
+            sinAngle = std::max(-1.0, std::min(1.0, sinAngle));
+            double angle = ConstexprMath::asin(sinAngle);
+            if (angle != angle)
+            {
+                return false;
+            }
+            if (hasTwoSolutions && ambiguousCaseSolution == AmbiguousCaseSolution::SecondSolution)
+            {
+                angle = ConstexprMath::pi - angle;
+            }
+            tri.setAngle(other, angle);
+            return true;
+        }
+
+        static constexpr ResultCode solveRadians(CompactTriangle& triangle, AmbiguousCaseSolution ambiguousCaseSolution)
+        {
+            const View view(triangle, 0);
+            const int knownAngles = knownAngleCount(view);
+            const int knownSides = knownSideCount(view);
+
+            if (knownAngles + knownSides < 3 || knownSides == 0)
+            {
+                return ResultCode::InsufficientData;
+            }
+
+            if (knownSides == 3)
+            {
+                // SSS
+                if (knownAngles == 2)
+                {
+                    solveThirdAngle(triangle);
+                }
+                else if (knownAngles < 2)
+                {
+                    solveAnglesWithSides(triangle);
+                }
+            }
+            else if (knownSides == 2 && knownAngles == 1)
+            {
+                const View tri(triangle, findFirst(view, [](const View& v, int i) { return v.hasAngle(i); }));
+                if (tri.hasPositiveSide(B) && tri.hasPositiveSide(C))
+                {
+                    // SAS
+                    solveSideWithAngleCos(tri);
+                    solveAnglesWithSides(triangle);
+                }
+                else if (resolveSSA(tri, ambiguousCaseSolution))
+                {
+                    // SSA
+                    solveThirdAngle(triangle);
+                    solveSides(triangle);
+                }
+            }
+            else if (knownAngles >= 2)
+            {
+                // ASA or AAS
+                if (knownAngles == 2)
+                {
+                    solveThirdAngle(triangle);
+                }
+                solveSides(triangle);
+            }
+            return ResultCode::Success;
+        }
+    };
+} // namespace TriangleCalculatorLib
+
+#endif // CONSTEXPR_TRIANGLE_SOLVER_HPP
@@ -0,0 +1,117 @@
+#ifndef FAST_MATH_HPP
+#define FAST_MATH_HPP
+
+#include <array>
+#include <cmath>
+
+namespace TriangleCalculatorLib
+{
+    namespace detail
+    {
+        // The functions of FastMath. Unit only keeps copies apart: units compiled with other instruction
+        // set flags instantiate it with a type of their own, so no out-of-line copy is shared with them.
+        template <typename Unit>
+        class BasicFastMath
+        {
+        public:
+            /// Largest error of sin and cos relative to the exact value
+            static constexpr double sinCosMaxRelativeError = 3e-11;
+
+            /// Largest absolute error of asin and acos, in radians
+            static constexpr double asinAcosMaxAbsoluteError = 5e-9;
+
+            static double sin(double x)
+            {
+                // x = k pi + r with |r| <= pi / 2, sin(x) = (-1)^k sin(r)
+                const double k = roundNearest(x * invPi);
+                const double r = (x - k * piHi) - k * piLo;
+                const double s = sinPolynomial(r);
+                return isOdd(k) ? -s : s;
+            }
+
+            static double cos(double x)
+            {
+                // x = (k + 1/2) pi + r with |r| <= pi / 2, cos(x) = (-1)^(k + 1) sin(r)
+                const double k = roundNearest(x * invPi - 0.5);
+                const double r = ((x - k * piHi) - halfPiHi) - (k * piLo + halfPiLo);
+                const double s = sinPolynomial(r);
+                return isOdd(k) ? s : -s;
+            }
+
+            static double asin(double x)
+            {
+                // asin(x) = pi/2 - 2 asin(sqrt((1 - x) / 2)) for x > 0.5
+                const double ax = std::abs(x);
+                const bool large = ax > 0.5;
+                const double s = large ? std::sqrt((1.0 - ax) * 0.5) : ax;
+                const double p = asinPolynomial(s);
+                const double y = large ? (halfPiHi - 2.0 * p) + halfPiLo : p;
+                return x < 0.0 ? -y : y;
+            }
+
+            static double acos(double x)
+            {
+                // acos(x) = 2 asin(sqrt((1 - x) / 2)) for x > 0.5 and pi - 2 asin(sqrt((1 + x) / 2)) for x < -0.5
+                const double ax = std::abs(x);
+                const bool large = ax > 0.5;
+                const double s = large ? std::sqrt((1.0 - ax) * 0.5) : x;
+                const double p = asinPolynomial(s);
+                const double small = (halfPiHi - p) + halfPiLo;
+                const double positive = 2.0 * p;
+                const double negative = (piHi - 2.0 * p) + piLo;
+                return large ? (x > 0.0 ? positive : negative) : small;
+            }
+
+        private:
+            // pi and pi/2 split into a high and a low part so the range reduction keeps the low bits of r
+            static constexpr double piHi = 3.141592653589793116;
+            static constexpr double piLo = 1.2246467991473532e-16;
+            static constexpr double halfPiHi = 1.5707963267948966192;
+            static constexpr double halfPiLo = 6.123233995736766e-17;
+            static constexpr double invPi = 0.31830988618379067154;
+
+            // sin(r) = r P(r^2) on |r| <= pi/2, relative error 2.1e-11; sin feeds asin in the law of sines,
+            // which amplifies its error near right angles, so it gets one term more than asin
+            static constexpr std::array<double, 6> sinCoefficients{
+                0.99999999997884893, -0.16666666608826045, 0.0083333307205568994,
+                -0.00019840832823159621, 2.7523971069590425e-06, -2.386834643592302e-08};
+
+            // asin(s) = s Q(s^2) on |s| <= 0.5, relative error 4.4e-9
+            static constexpr std::array<double, 6> asinCoefficients{
+                0.99999999558439678, 0.16666790109687621, 0.074944347585539473,
+                0.045550185416422563, 0.023858169108816607, 0.042635642535943069};
+
+            // Estrin's scheme: the pairs are independent, which halves the dependency chain of Horner's
+            static double estrin(const std::array<double, 6>& c, double z)
+            {
+                const double z2 = z * z;
+                const double low = c[0] + c[1] * z;
+                const double middle = c[2] + c[3] * z;
+                const double high = c[4] + c[5] * z;
+                return low + z2 * (middle + z2 * high);
+            }
+
+            static double sinPolynomial(double r) { return r * estrin(sinCoefficients, r * r); }
+
+            static double asinPolynomial(double s) { return s * estrin(asinCoefficients, s * s); }
+
+            // round to nearest integer for |x| < 2^51 without a libm call
+            static double roundNearest(double x)
+            {
+                constexpr double shifter = 6755399441055744.0; // 1.5 * 2^52
+                return (x + shifter) - shifter;
+            }
+
+            static bool isOdd(double k) { return k - 2.0 * roundNearest(k * 0.5) != 0.0; }
+        };
+    } // namespace detail
+
+    /// Low degree sin/cos/asin/acos for Precision::Fast, several times cheaper than the std:: functions.
+    /// The polynomials are minimax fits (Remez exchange on the relative error) and the functions are
+    /// branch free, so loops over them vectorize like the exact batch kernels do.
+    /// The error bounds (sinCosMaxRelativeError, asinAcosMaxAbsoluteError) hold for the arguments a triangle
+    /// produces (|x| <= 4 pi for sin and cos), they are checked against the std:: functions by the tests.
+    using FastMath = detail::BasicFastMath<void>;
+} // namespace TriangleCalculatorLib
+
+#endif // FAST_MATH_HPP
@@ -3,15 +3,32 @@
 
 #include "Triangle.hpp"
 
+#include <cstdint>
+#include <string_view>
+
 namespace TriangleCalculatorLib
 {
-    enum class ResultCode
+    // one byte wide so batch result columns stay compact
+    enum class ResultCode : std::uint8_t
     {
         Success,
         InsufficientData, // Not enough data to solve the triangle
         TriangleAmbiguous, // SSA case with two possible solutions (returned even if only one is requested)
         InvalidData // aka a non-existent triangle
     };
+
+    constexpr std::string_view to_string(ResultCode code) noexcept
+    {
+        switch (code)
+        {
+            case ResultCode::Success: return "Success";
+            case ResultCode::InsufficientData: return "InsufficientData";
+            case ResultCode::TriangleAmbiguous: return "TriangleAmbiguous";
+            case ResultCode::InvalidData: return "InvalidData";
+        }
+        return "Unknown";
+    }
+
     struct Result
     {
         Triangle triangle;
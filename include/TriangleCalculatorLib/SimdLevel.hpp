@@ -0,0 +1,41 @@
+#ifndef TRIANGLE_SIMD_LEVEL_HPP
+#define TRIANGLE_SIMD_LEVEL_HPP
+
+#include <cstdint>
+#include <string_view>
+
+namespace TriangleCalculatorLib
+{
+    // instruction set used by the batch kernels
+    enum class SimdLevel : std::uint8_t
+    {
+        Scalar, // portable fallback, one triangle at a time
+        SSE2,   // 2 triangles per instruction
+        AVX2,   // 4 triangles per instruction (with FMA)
+        AVX512  // 8 triangles per instruction
+    };
+
+    /// The best level supported by both the CPU (checked once via CPUID) and this build
+    SimdLevel detectedSimdLevel() noexcept;
+
+    /// The level the batch kernels currently run at, detectedSimdLevel() unless overridden
+    SimdLevel activeSimdLevel() noexcept;
+
+    /// Override the active level, mainly for tests and benchmarks
+    /// @return false (and nothing changes) if the level is not supported on this machine
+    bool setSimdLevel(SimdLevel level) noexcept;
+
+    constexpr std::string_view to_string(SimdLevel level) noexcept
+    {
+        switch (level)
+        {
+            case SimdLevel::Scalar: return "scalar";
+            case SimdLevel::SSE2: return "sse2";
+            case SimdLevel::AVX2: return "avx2";
+            case SimdLevel::AVX512: return "avx512";
+        }
+        return "unknown";
+    }
+} // namespace TriangleCalculatorLib
+
+#endif // TRIANGLE_SIMD_LEVEL_HPP
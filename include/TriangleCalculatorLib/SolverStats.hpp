@@ -0,0 +1,126 @@
+#ifndef SOLVER_STATS_HPP
+#define SOLVER_STATS_HPP
+
+#include "ReturnCode.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace TriangleCalculatorLib
+{
+    // the branches of the solver, every solved triangle is counted under one of them
+    enum class SolveCase : std::uint8_t
+    {
+        Insufficient, // fewer than 3 values or no side known
+        Complete,     // nothing left to solve
+        ThirdAngle,   // 3 sides and 2 angles, only the third angle is missing
+        SSS,          // 3 sides and at most 1 angle
+        SAS,          // 2 sides and the included angle
+        SSA,          // 2 sides and a non-included angle
+        AAS,          // 2 or 3 angles and 1 or 2 sides (covers ASA)
+        Count
+    };
+
+    constexpr std::string_view to_string(SolveCase solveCase) noexcept
+    {
+        switch (solveCase)
+        {
+            case SolveCase::Insufficient: return "Insufficient";
+            case SolveCase::Complete: return "Complete";
+            case SolveCase::ThirdAngle: return "ThirdAngle";
+            case SolveCase::SSS: return "SSS";
+            case SolveCase::SAS: return "SAS";
+            case SolveCase::SSA: return "SSA";
+            case SolveCase::AAS: return "AAS";
+            case SolveCase::Count: break;
+        }
+        return "Unknown";
+    }
+
+    /// Counters of the solver: solved triangles per case, result codes and per case latency histograms.
+    /// Every thread counts into its own block without locks or shared cache lines, a snapshot sums the blocks.
+    /// Off by default; while off the solvers skip all of it.
+    /// Every solve is counted, but a clock read costs about as much as a fast solve, so only one scalar solve
+    /// in LatencySampleInterval per thread is timed (the histogram counts are samples, not solves).
+    /// Batch rows are timed per case and block, every row of it is counted at the average, so the
+    /// histograms of batches show the cost per row.
+    class SolverStats
+    {
+    public:
+        static constexpr std::size_t CaseCount = static_cast<std::size_t>(SolveCase::Count);
+        static constexpr std::size_t CodeCount = 4; // the values of ResultCode
+
+        /// Scalar solves per timed one
+        static constexpr std::uint32_t LatencySampleInterval = 16;
+
+        /// Bucket 0 holds 0 ns, bucket i holds [2^(i-1), 2^i) ns, the last one everything above
+        static constexpr std::size_t LatencyBuckets = 32;
+
+        struct Histogram
+        {
+            std::array<std::uint64_t, LatencyBuckets> buckets{};
+            std::uint64_t count = 0;
+            std::uint64_t totalNanoseconds = 0;
+
+            /// Exclusive upper bound of a bucket in nanoseconds, 0 for the last (unbounded) one
+            static constexpr std::uint64_t upperBound(std::size_t bucket) noexcept
+            {
+                return bucket + 1 < LatencyBuckets ? std::uint64_t{1} << bucket : 0;
+            }
+
+            /// Bucket a latency falls into
+            static std::size_t bucketFor(std::uint64_t nanoseconds) noexcept;
+        };
+
+        struct Snapshot
+        {
+            std::array<std::uint64_t, CaseCount> cases{};
+            std::array<std::uint64_t, CodeCount> codes{};
+            std::array<Histogram, CaseCount> latency{};
+
+            std::uint64_t solves() const noexcept;
+
+            std::uint64_t count(SolveCase solveCase) const noexcept { return cases[static_cast<std::size_t>(solveCase)]; }
+            std::uint64_t count(ResultCode code) const noexcept { return codes[static_cast<std::size_t>(code)]; }
+        };
+
+        static bool enabled() noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+        /// Start or stop counting, the counters keep their values
+        static void setEnabled(bool enabled) noexcept;
+
+        /// Sum of the counters of all threads (including finished ones) since the last reset
+        static Snapshot snapshot();
+
+        /// Start counting from zero again
+        static void reset();
+
+        /// The snapshot as one JSON object: {"solves":..,"cases":{"SSS":{"count":..,"latency":{..}},..},"codes":{..}}
+        static std::string toJson(const Snapshot& snapshot);
+
+        /// The snapshot in the Prometheus text exposition format, latencies as histograms in seconds
+        static std::string toPrometheus(const Snapshot& snapshot);
+
+        /// Whether the calling thread should time its next scalar solve, true once per LatencySampleInterval calls
+        static bool sampleLatency() noexcept;
+
+        /// Record one scalar solve, called by the solvers while enabled
+        static void record(SolveCase solveCase, ResultCode code) noexcept;
+
+        /// Record one timed scalar solve
+        static void record(SolveCase solveCase, ResultCode code, std::uint64_t nanoseconds) noexcept;
+
+        /// Record a run of rows solved together, codes holds how many rows ended with each ResultCode
+        static void record(SolveCase solveCase, const std::array<std::uint64_t, CodeCount>& codes, std::uint64_t rows,
+                           std::uint64_t nanoseconds) noexcept;
+
+    private:
+        static std::atomic<bool> enabled_;
+    };
+} // namespace TriangleCalculatorLib
+
+#endif // SOLVER_STATS_HPP
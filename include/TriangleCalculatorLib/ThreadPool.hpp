@@ -0,0 +1,72 @@
+#ifndef TRIANGLE_THREAD_POOL_HPP
+#define TRIANGLE_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TriangleCalculatorLib
+{
+    /// Fixed-size pool of worker threads, each owning a task deque.
+    /// A worker takes tasks from the front of its own deque and, once that is empty,
+    /// steals from the back of the other workers' deques.
+    class ThreadPool
+    {
+    public:
+        /// @param threadCount Number of worker threads, 0 uses std::thread::hardware_concurrency()
+        explicit ThreadPool(std::size_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        std::size_t threadCount() const noexcept { return workers_.size(); }
+
+        /// Run body(begin, end) over [0, count) in chunks of at most chunkSize elements and wait for all of them.
+        /// Chunks are dealt to the workers as contiguous runs, the calling thread helps while it waits.
+        /// The body must not throw.
+        void parallelFor(std::size_t count, std::size_t chunkSize,
+                         const std::function<void(std::size_t, std::size_t)>& body);
+
+        /// Queue a single task to run on some worker. The task must not throw.
+        void submit(std::function<void()> task);
+
+    private:
+        struct Task
+        {
+            void (*run)(void* context, std::size_t begin, std::size_t end) = nullptr;
+            void* context = nullptr;
+            std::size_t begin = 0;
+            std::size_t end = 0;
+        };
+
+        struct WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void WorkerLoop(std::size_t index);
+        bool TryPopOwn(std::size_t index, Task& task);
+        bool TrySteal(std::size_t thief, Task& task);
+        bool TryRunOne(std::size_t preferredQueue);
+        void Push(std::size_t queue, const Task& task);
+        void WakeWorkers(std::size_t taskCount);
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues_;
+        std::vector<std::thread> workers_;
+        std::atomic<std::size_t> queuedTasks_{0};
+        std::atomic<std::size_t> nextQueue_{0};
+        std::mutex sleepMutex_;
+        std::condition_variable sleepCondition_;
+        bool stopping_{false};
+    };
+} // namespace TriangleCalculatorLib
+
+#endif // TRIANGLE_THREAD_POOL_HPP
@@ -5,14 +5,18 @@
 
 namespace TriangleCalculatorLib
 {
-    struct Triangle
+    /// A triangle with any of its fields known, in the scalar type T (float, double or long double)
+    template <typename T>
+    struct BasicTriangle
     {
-        std::optional<double> sideA;
-        std::optional<double> sideB;
-        std::optional<double> sideC;
-        std::optional<double> angleA;
-        std::optional<double> angleB;
-        std::optional<double> angleC;
+        using value_type = T;
+
+        std::optional<T> sideA;
+        std::optional<T> sideB;
+        std::optional<T> sideC;
+        std::optional<T> angleA;
+        std::optional<T> angleB;
+        std::optional<T> angleC;
 
         // Method to reset all values to std::nullopt
         void reset() {
@@ -25,12 +29,35 @@ namespace TriangleCalculatorLib
         }
     };
 
+    using Triangle = BasicTriangle<double>;
+
     enum class AmbiguousCaseSolution
     {
         NoSolution = 0,
         FirstSolution = 1,
         SecondSolution = 2
     };
+
+    enum class AngleUnit
+    {
+        Degrees = 0,
+        Radians = 1
+    };
+
+    // Exact uses the std:: trig functions, Fast the FastMath polynomials: solved values then agree
+    // with Exact within FAST_PRECISION_TOLERANCE (relative, or absolute below 1).
+    // Mixed solves batches in float and solves again in double the triangles whose condition estimate
+    // says float is not good enough (near-degenerate ones): solved values agree with Exact within
+    // MIXED_PRECISION_TOLERANCE (relative). Single triangles are solved as with Exact.
+    enum class Precision
+    {
+        Exact = 0,
+        Fast = 1,
+        Mixed = 2
+    };
+
+    inline constexpr double FAST_PRECISION_TOLERANCE = 1e-6;
+    inline constexpr double MIXED_PRECISION_TOLERANCE = 1e-5;
 } // namespace TriangleCalculatorLib
 
 #endif // TRIANGLE_HPP
\ No newline at end of file
@@ -0,0 +1,118 @@
+#ifndef TRIANGLE_ASYNC_HPP
+#define TRIANGLE_ASYNC_HPP
+
+#include "ReturnCode.hpp"
+#include "Triangle.hpp"
+#include "TriangleBatch.hpp"
+#include "TriangleCalculator.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stop_token>
+
+namespace TriangleCalculatorLib
+{
+    class ThreadPool;
+
+    struct AsyncSolveOptions
+    {
+        AngleUnit unit = AngleUnit::Degrees;
+        Precision precision = Precision::Exact;
+        AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution;
+        /// Rows per chunk, the unit of work, of cancellation and of nextChunk()
+        std::size_t chunkSize = TriangleCalculator::DefaultChunkSize;
+        /// Solve on this pool if set, on TriangleAsync::defaultPool() otherwise
+        ThreadPool* pool = nullptr;
+        /// Chunks that have not started when a stop is requested are skipped
+        std::stop_token stopToken;
+    };
+
+    struct AsyncSolveResult
+    {
+        ResultCode code = ResultCode::Success; // InvalidData if the column lengths differ (nothing is solved)
+        std::size_t solvedRows = 0;
+        bool cancelled = false;                // some chunks were skipped, their rows are untouched
+    };
+
+    /// A solved chunk: rows [begin, end) of the batch
+    struct SolvedChunk
+    {
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        TriangleColumns rows;
+    };
+
+    /// A batch being solved on a pool, returned by TriangleAsync::solve. Awaiting it suspends the coroutine
+    /// until every chunk is done, no thread blocks meanwhile. The coroutine is resumed on the pool thread
+    /// that finished the last chunk (or goes on without suspending if it is done already).
+    /// One coroutine at a time may await an operation.
+    ///
+    /// Destroying an operation that is still running cancels it and waits for the chunks already
+    /// solving, the columns are not touched after that.
+    class SolveOperation
+    {
+    public:
+        class ChunkAwaiter;
+
+        SolveOperation(SolveOperation&& other) noexcept;
+        SolveOperation& operator=(SolveOperation&& other) noexcept;
+        ~SolveOperation();
+
+        /// Skip the chunks that have not started yet, awaiting still waits for the ones running
+        void cancel() noexcept;
+
+        /// Await the next chunk in row order: the chunk once it is solved, nullopt after the last one
+        /// or when the next one was skipped. Solved chunks can be written out while later ones solve.
+        ChunkAwaiter nextChunk() noexcept;
+
+        bool await_ready() const noexcept;
+        bool await_suspend(std::coroutine_handle<> waiter);
+        AsyncSolveResult await_resume() const;
+
+        class ChunkAwaiter
+        {
+        public:
+            bool await_ready() const noexcept;
+            bool await_suspend(std::coroutine_handle<> waiter);
+            std::optional<SolvedChunk> await_resume();
+
+        private:
+            friend class SolveOperation;
+            explicit ChunkAwaiter(SolveOperation& operation) noexcept : operation_(operation) {}
+
+            SolveOperation& operation_;
+        };
+
+    private:
+        friend class TriangleAsync;
+        struct State;
+
+        explicit SolveOperation(std::shared_ptr<State> state) noexcept;
+        void wait() noexcept;
+
+        std::shared_ptr<State> state_;
+        std::size_t nextChunk_ = 0;
+    };
+
+    /// Batch solving for C++20 coroutines: the batch is split into chunks that are queued on a
+    /// ThreadPool right away, the caller co_awaits the whole batch or its chunks one by one.
+    ///
+    ///     SolveOperation solving = TriangleAsync::solve(batch.columns());
+    ///     while (std::optional<SolvedChunk> chunk = co_await solving.nextChunk())
+    ///         co_await write(chunk->rows);
+    ///     AsyncSolveResult result = co_await solving;
+    class TriangleAsync
+    {
+    public:
+        /// Start solving the columns in place, every row exactly as TriangleCalculator::finalizeTriangles does
+        /// @param columns The triangle columns, they must outlive the operation; rows are solved once their chunk is delivered
+        static SolveOperation solve(TriangleColumns columns, const AsyncSolveOptions& options = {});
+
+        /// The pool of the library, one thread per core, started on first use
+        static ThreadPool& defaultPool();
+    };
+} // namespace TriangleCalculatorLib
+
+#endif // TRIANGLE_ASYNC_HPP
@@ -0,0 +1,132 @@
+#ifndef TRIANGLE_BATCH_HPP
+#define TRIANGLE_BATCH_HPP
+
+#include "CompactTriangle.hpp"
+#include "ReturnCode.hpp"
+#include "Triangle.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace TriangleCalculatorLib
+{
+    /// Structure-of-arrays view over a batch of triangles.
+    /// Every span must have the same length; a value is only read when its bit is set in `known`.
+    /// Solving writes the computed values back into the columns, sets their bits in `known`
+    /// and stores one ResultCode per triangle in `codes`.
+    struct TriangleColumns
+    {
+        std::span<double> sideA;
+        std::span<double> sideB;
+        std::span<double> sideC;
+        std::span<double> angleA;
+        std::span<double> angleB;
+        std::span<double> angleC;
+        std::span<std::uint8_t> known;
+        std::span<ResultCode> codes;
+
+        std::size_t size() const noexcept { return known.size(); }
+
+        bool hasConsistentSizes() const noexcept
+        {
+            const std::size_t n = known.size();
+            return sideA.size() == n && sideB.size() == n && sideC.size() == n &&
+                   angleA.size() == n && angleB.size() == n && angleC.size() == n &&
+                   codes.size() == n;
+        }
+
+        // Sub-range [offset, offset + count) of every column.
+        TriangleColumns subspan(std::size_t offset, std::size_t count) const noexcept
+        {
+            return TriangleColumns{
+                sideA.subspan(offset, count), sideB.subspan(offset, count), sideC.subspan(offset, count),
+                angleA.subspan(offset, count), angleB.subspan(offset, count), angleC.subspan(offset, count),
+                known.subspan(offset, count), codes.subspan(offset, count)};
+        }
+
+        // Store a triangle at the given row and reset its result code.
+        void set(std::size_t index, const CompactTriangle& triangle) const noexcept
+        {
+            sideA[index] = triangle.sideA;
+            sideB[index] = triangle.sideB;
+            sideC[index] = triangle.sideC;
+            angleA[index] = triangle.angleA;
+            angleB[index] = triangle.angleB;
+            angleC[index] = triangle.angleC;
+            known[index] = triangle.known;
+            codes[index] = ResultCode::Success;
+        }
+
+        CompactTriangle getCompact(std::size_t index) const noexcept
+        {
+            return CompactTriangle{sideA[index], sideB[index], sideC[index],
+                                   angleA[index], angleB[index], angleC[index], known[index]};
+        }
+    };
+
+    /// Owning column storage for a batch of triangles.
+    class TriangleBatch
+    {
+    public:
+        TriangleBatch() = default;
+        explicit TriangleBatch(std::size_t count) { resize(count); }
+
+        std::size_t size() const noexcept { return known_.size(); }
+
+        void resize(std::size_t count)
+        {
+            sideA_.resize(count);
+            sideB_.resize(count);
+            sideC_.resize(count);
+            angleA_.resize(count);
+            angleB_.resize(count);
+            angleC_.resize(count);
+            known_.resize(count);
+            codes_.resize(count);
+        }
+
+        /// Store a triangle at the given row, unknown fields clear their mask bit
+        void set(std::size_t index, const Triangle& triangle)
+        {
+            set(index, CompactTriangle::fromTriangle(triangle));
+        }
+
+        void set(std::size_t index, const CompactTriangle& triangle)
+        {
+            columns().set(index, triangle);
+        }
+
+        /// Rebuild the triangle at the given row from its known fields
+        Triangle get(std::size_t index) const
+        {
+            return getCompact(index).toTriangle();
+        }
+
+        CompactTriangle getCompact(std::size_t index) const
+        {
+            return CompactTriangle{sideA_[index], sideB_[index], sideC_[index],
+                                   angleA_[index], angleB_[index], angleC_[index], known_[index]};
+        }
+
+        ResultCode code(std::size_t index) const { return codes_[index]; }
+
+        TriangleColumns columns() noexcept
+        {
+            return TriangleColumns{sideA_, sideB_, sideC_, angleA_, angleB_, angleC_, known_, codes_};
+        }
+
+    private:
+        std::vector<double> sideA_;
+        std::vector<double> sideB_;
+        std::vector<double> sideC_;
+        std::vector<double> angleA_;
+        std::vector<double> angleB_;
+        std::vector<double> angleC_;
+        std::vector<std::uint8_t> known_;
+        std::vector<ResultCode> codes_;
+    };
+} // namespace TriangleCalculatorLib
+
+#endif // TRIANGLE_BATCH_HPP
@@ -0,0 +1,74 @@
+#ifndef TRIANGLE_CACHE_HPP
+#define TRIANGLE_CACHE_HPP
+
+#include "CompactTriangle.hpp"
+#include "ReturnCode.hpp"
+#include "Triangle.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace TriangleCalculatorLib
+{
+    /// Bounded memo of solved triangles, for request streams that solve the same shapes over and over.
+    /// Entries are keyed on the exact input bits: the known mask, the six values (unknown ones as 0),
+    /// the angle unit and the AmbiguousCaseSolution. The table is split into shards with a lock each,
+    /// so threads only contend when they hit the same shard; a full shard evicts with the CLOCK algorithm.
+    /// All memory is allocated up front, lookups and inserts never allocate.
+    class TriangleCache
+    {
+    public:
+        struct Stats
+        {
+            std::uint64_t hits = 0;
+            std::uint64_t misses = 0;
+            std::uint64_t evictions = 0;
+            std::size_t size = 0; // entries currently cached
+
+            double hitRate() const noexcept
+            {
+                const std::uint64_t lookups = hits + misses;
+                return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+            }
+        };
+
+        /// @param capacity Maximum number of cached triangles (rounded up to a multiple of the shard count)
+        /// @param shardCount Number of independently locked shards, 0 uses one per hardware thread
+        explicit TriangleCache(std::size_t capacity = 4096, std::size_t shardCount = 0);
+        ~TriangleCache();
+
+        TriangleCache(const TriangleCache&) = delete;
+        TriangleCache& operator=(const TriangleCache&) = delete;
+
+        /// Look up the solved triangle for an input
+        /// @param input The triangle as it was passed to the solver
+        /// @param solved Receives the cached solved triangle on a hit
+        /// @param code Receives the cached result code on a hit
+        /// @return true on a hit
+        bool find(const CompactTriangle& input, AngleUnit unit, AmbiguousCaseSolution ambiguousCaseSolution,
+                  CompactTriangle& solved, ResultCode& code);
+
+        /// Remember the solved triangle for an input, evicting an entry not used recently if the shard is full
+        void insert(const CompactTriangle& input, AngleUnit unit, AmbiguousCaseSolution ambiguousCaseSolution,
+                    const CompactTriangle& solved, ResultCode code);
+
+        /// Drop every entry and reset the counters
+        void clear();
+
+        /// Counters summed over all shards
+        Stats stats() const;
+
+        std::size_t capacity() const noexcept;
+
+    private:
+        struct Shard;
+
+        Shard& shardFor(std::uint64_t hash) const noexcept;
+
+        std::unique_ptr<Shard[]> shards_;
+        std::size_t shardCount_ = 0;
+    };
+} // namespace TriangleCalculatorLib
+
+#endif // TRIANGLE_CACHE_HPP
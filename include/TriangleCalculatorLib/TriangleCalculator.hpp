@@ -1,21 +1,219 @@
 #ifndef TRIANGLE_CALCULATOR_HPP
 #define TRIANGLE_CALCULATOR_HPP
 
+#include "CompactTriangle.hpp"
 #include "ReturnCode.hpp"
 #include "Triangle.hpp"
+#include "TriangleBatch.hpp"
 
+#include <cstddef>
 #include <optional>
+#include <span>
 #include <utility>
 
 namespace TriangleCalculatorLib
 {
+    class ThreadPool;
+    class TriangleCache;
+
     class TriangleCalculator {
     public:
+        /// Rows per parallel work item: ~50 bytes per row keeps a chunk within a core's share of L2
+        static constexpr std::size_t DefaultChunkSize = 4096;
+
         /// Finalize the triangle by calculating missing sides and angles
-        /// @param triangle The triangle to finalize
+        /// @param triangle The triangle to finalize (angles in degrees)
         /// @return The finalized triangle with all sides and angles calculated
         static Result finalizeTriangle(Triangle triangle, AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
-        
+
+        /// Finalize the triangle by calculating missing sides and angles
+        /// @param triangle The triangle to finalize
+        /// @param unit The unit of the angles of the triangle, both in and out
+        /// @return The finalized triangle with all sides and angles calculated
+        static Result finalizeTriangle(Triangle triangle, AngleUnit unit, AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize the triangle in place, with AngleUnit::Radians nothing is converted or copied
+        /// @param triangle The triangle to finalize, solved values are written back into it
+        /// @param unit The unit of the angles of the triangle, both in and out
+        /// @return The result code of the triangle
+        static ResultCode finalizeTriangleInPlace(Triangle& triangle, AngleUnit unit, AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize the triangle with the trig functions of a precision tier
+        /// @param triangle The triangle to finalize
+        /// @param unit The unit of the angles of the triangle, both in and out
+        /// @param precision Fast trades accuracy (see FAST_PRECISION_TOLERANCE) for speed, Mixed solves like Exact here
+        /// @return The finalized triangle with all sides and angles calculated
+        static Result finalizeTriangle(Triangle triangle, AngleUnit unit, Precision precision,
+                                       AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize the triangle in place with the trig functions of a precision tier
+        /// @param triangle The triangle to finalize, solved values are written back into it
+        /// @param unit The unit of the angles of the triangle, both in and out
+        /// @param precision Fast trades accuracy (see FAST_PRECISION_TOLERANCE) for speed, Mixed solves like Exact here
+        /// @return The result code of the triangle
+        static ResultCode finalizeTriangleInPlace(Triangle& triangle, AngleUnit unit, Precision precision,
+                                                  AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize a float or long double triangle in place, solving in that type with its ToleranceTraits
+        /// (instantiated for float and long double, double triangles take the overloads above)
+        /// @param triangle The triangle to finalize, solved values are written back into it
+        /// @param unit The unit of the angles of the triangle, both in and out
+        /// @return The result code of the triangle
+        template <typename T>
+        static ResultCode finalizeTriangleInPlace(BasicTriangle<T>& triangle, AngleUnit unit,
+                                                  AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize a float or long double triangle in place with the trig functions of a precision tier
+        /// (Fast evaluates FastMath in double, so it gains nothing for long double)
+        /// @param triangle The triangle to finalize, solved values are written back into it
+        /// @param unit The unit of the angles of the triangle, both in and out
+        /// @param precision Fast trades accuracy (see FAST_PRECISION_TOLERANCE) for speed, Mixed solves like Exact here
+        /// @return The result code of the triangle
+        template <typename T>
+        static ResultCode finalizeTriangleInPlace(BasicTriangle<T>& triangle, AngleUnit unit, Precision precision,
+                                                  AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize the triangle, answering repeated inputs from a cache
+        /// @param triangle The triangle to finalize
+        /// @param unit The unit of the angles of the triangle, both in and out
+        /// @param cache Looked up first, receives the result on a miss; may be shared between threads
+        /// @return The finalized triangle, exactly as the uncached overload returns it
+        static Result finalizeTriangle(Triangle triangle, AngleUnit unit, TriangleCache& cache,
+                                       AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize a compact triangle in place
+        /// @param triangle The triangle to finalize (angles in degrees), solved values and their known bits are written back
+        /// @return The result code of the triangle
+        static ResultCode finalizeTriangle(CompactTriangle& triangle, AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize a compact triangle in place
+        /// @param triangle The triangle to finalize, solved values and their known bits are written back
+        /// @param unit The unit of the angles of the triangle, both in and out
+        /// @return The result code of the triangle
+        static ResultCode finalizeTriangle(CompactTriangle& triangle, AngleUnit unit, AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize a batch of triangles in place
+        /// @param columns The triangle columns (angles in degrees), solved values and result codes are written back into them
+        /// @param ambiguousCaseSolution The solution to use for every ambiguous SSA triangle in the batch
+        /// @return InvalidData if the column lengths differ (nothing is solved), Success otherwise
+        static ResultCode finalizeTriangles(TriangleColumns columns, AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize a batch of triangles in place
+        /// @param columns The triangle columns, solved values and result codes are written back into them
+        /// @param unit The unit of the angle columns, both in and out
+        /// @param ambiguousCaseSolution The solution to use for every ambiguous SSA triangle in the batch
+        /// @return InvalidData if the column lengths differ (nothing is solved), Success otherwise
+        static ResultCode finalizeTriangles(TriangleColumns columns, AngleUnit unit,
+                                            AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize a batch of triangles in place with the trig functions of a precision tier
+        /// @param columns The triangle columns, solved values and result codes are written back into them
+        /// @param unit The unit of the angle columns, both in and out
+        /// @param precision The precision tier for every triangle of the batch, Mixed solves in float where that is accurate enough
+        /// @param ambiguousCaseSolution The solution to use for every ambiguous SSA triangle in the batch
+        /// @return InvalidData if the column lengths differ (nothing is solved), Success otherwise
+        static ResultCode finalizeTriangles(TriangleColumns columns, AngleUnit unit, Precision precision,
+                                            AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize a batch of triangles in place, spread over the threads of a pool
+        /// Every row is solved exactly as by the single threaded overload, so the output does not depend on the thread count
+        /// @param columns The triangle columns (angles in degrees), solved values and result codes are written back into them
+        /// @param pool The thread pool to run on, the calling thread helps while it waits
+        /// @param ambiguousCaseSolution The solution to use for every ambiguous SSA triangle in the batch
+        /// @param chunkSize Number of rows per work item
+        /// @return InvalidData if the column lengths differ (nothing is solved), Success otherwise
+        static ResultCode finalizeTriangles(TriangleColumns columns, ThreadPool& pool,
+                                            AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution,
+                                            std::size_t chunkSize = DefaultChunkSize);
+
+        /// Finalize a batch of triangles in place, spread over the threads of a pool
+        /// @param columns The triangle columns, solved values and result codes are written back into them
+        /// @param unit The unit of the angle columns, both in and out
+        /// @param pool The thread pool to run on, the calling thread helps while it waits
+        /// @param ambiguousCaseSolution The solution to use for every ambiguous SSA triangle in the batch
+        /// @param chunkSize Number of rows per work item
+        /// @return InvalidData if the column lengths differ (nothing is solved), Success otherwise
+        static ResultCode finalizeTriangles(TriangleColumns columns, AngleUnit unit, ThreadPool& pool,
+                                            AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution,
+                                            std::size_t chunkSize = DefaultChunkSize);
+
+        /// Finalize a batch of triangles in place with the trig functions of a precision tier, spread over the threads of a pool
+        /// @param columns The triangle columns, solved values and result codes are written back into them
+        /// @param unit The unit of the angle columns, both in and out
+        /// @param precision The precision tier for every triangle of the batch, Mixed solves in float where that is accurate enough
+        /// @param pool The thread pool to run on, the calling thread helps while it waits
+        /// @param ambiguousCaseSolution The solution to use for every ambiguous SSA triangle in the batch
+        /// @param chunkSize Number of rows per work item
+        /// @return InvalidData if the column lengths differ (nothing is solved), Success otherwise
+        static ResultCode finalizeTriangles(TriangleColumns columns, AngleUnit unit, Precision precision, ThreadPool& pool,
+                                            AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution,
+                                            std::size_t chunkSize = DefaultChunkSize);
+
+        /// Finalize an array of compact triangles in place
+        /// @param triangles The triangles (angles in degrees), solved values and their known bits are written back
+        /// @param codes Receives one ResultCode per triangle, must be as long as triangles
+        /// @param ambiguousCaseSolution The solution to use for every ambiguous SSA triangle in the batch
+        /// @return InvalidData if the lengths differ (nothing is solved), Success otherwise
+        static ResultCode finalizeTriangles(std::span<CompactTriangle> triangles, std::span<ResultCode> codes,
+                                            AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize an array of compact triangles in place
+        /// @param triangles The triangles, solved values and their known bits are written back
+        /// @param codes Receives one ResultCode per triangle, must be as long as triangles
+        /// @param unit The unit of the angles of the triangles, both in and out
+        /// @param ambiguousCaseSolution The solution to use for every ambiguous SSA triangle in the batch
+        /// @return InvalidData if the lengths differ (nothing is solved), Success otherwise
+        static ResultCode finalizeTriangles(std::span<CompactTriangle> triangles, std::span<ResultCode> codes, AngleUnit unit,
+                                            AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize an array of compact triangles in place with the trig functions of a precision tier
+        /// @param triangles The triangles, solved values and their known bits are written back
+        /// @param codes Receives one ResultCode per triangle, must be as long as triangles
+        /// @param unit The unit of the angles of the triangles, both in and out
+        /// @param precision The precision tier for every triangle of the batch, Mixed solves in float where that is accurate enough
+        /// @param ambiguousCaseSolution The solution to use for every ambiguous SSA triangle in the batch
+        /// @return InvalidData if the lengths differ (nothing is solved), Success otherwise
+        static ResultCode finalizeTriangles(std::span<CompactTriangle> triangles, std::span<ResultCode> codes, AngleUnit unit,
+                                            Precision precision,
+                                            AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        /// Finalize an array of compact triangles in place, spread over the threads of a pool
+        /// @param triangles The triangles (angles in degrees), solved values and their known bits are written back
+        /// @param codes Receives one ResultCode per triangle, must be as long as triangles
+        /// @param pool The thread pool to run on, the calling thread helps while it waits
+        /// @param ambiguousCaseSolution The solution to use for every ambiguous SSA triangle in the batch
+        /// @param chunkSize Number of triangles per work item
+        /// @return InvalidData if the lengths differ (nothing is solved), Success otherwise
+        static ResultCode finalizeTriangles(std::span<CompactTriangle> triangles, std::span<ResultCode> codes, ThreadPool& pool,
+                                            AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution,
+                                            std::size_t chunkSize = DefaultChunkSize);
+
+        /// Finalize an array of compact triangles in place, spread over the threads of a pool
+        /// @param triangles The triangles, solved values and their known bits are written back
+        /// @param codes Receives one ResultCode per triangle, must be as long as triangles
+        /// @param unit The unit of the angles of the triangles, both in and out
+        /// @param pool The thread pool to run on, the calling thread helps while it waits
+        /// @param ambiguousCaseSolution The solution to use for every ambiguous SSA triangle in the batch
+        /// @param chunkSize Number of triangles per work item
+        /// @return InvalidData if the lengths differ (nothing is solved), Success otherwise
+        static ResultCode finalizeTriangles(std::span<CompactTriangle> triangles, std::span<ResultCode> codes, AngleUnit unit, ThreadPool& pool,
+                                            AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution,
+                                            std::size_t chunkSize = DefaultChunkSize);
+
+        /// Finalize an array of compact triangles in place with the trig functions of a precision tier, spread over the threads of a pool
+        /// @param triangles The triangles, solved values and their known bits are written back
+        /// @param codes Receives one ResultCode per triangle, must be as long as triangles
+        /// @param unit The unit of the angles of the triangles, both in and out
+        /// @param precision The precision tier for every triangle of the batch, Mixed solves in float where that is accurate enough
+        /// @param pool The thread pool to run on, the calling thread helps while it waits
+        /// @param ambiguousCaseSolution The solution to use for every ambiguous SSA triangle in the batch
+        /// @param chunkSize Number of triangles per work item
+        /// @return InvalidData if the lengths differ (nothing is solved), Success otherwise
+        static ResultCode finalizeTriangles(std::span<CompactTriangle> triangles, std::span<ResultCode> codes, AngleUnit unit,
+                                            Precision precision, ThreadPool& pool,
+                                            AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution,
+                                            std::size_t chunkSize = DefaultChunkSize);
+
         /// Get the base and height of a triangle
         /// @param triangle The triangle for which to get the base and height
         /// @return A pair containing the base and height of the triangle (in that order)
@@ -31,6 +229,12 @@ namespace TriangleCalculatorLib
         /// @return The perimeter of the triangle
         static double perimeter(Triangle triangle);
     };
+
+    extern template ResultCode TriangleCalculator::finalizeTriangleInPlace(BasicTriangle<float>&, AngleUnit, AmbiguousCaseSolution);
+    extern template ResultCode TriangleCalculator::finalizeTriangleInPlace(BasicTriangle<float>&, AngleUnit, Precision, AmbiguousCaseSolution);
+    extern template ResultCode TriangleCalculator::finalizeTriangleInPlace(BasicTriangle<long double>&, AngleUnit, AmbiguousCaseSolution);
+    extern template ResultCode TriangleCalculator::finalizeTriangleInPlace(BasicTriangle<long double>&, AngleUnit, Precision,
+                                                                          AmbiguousCaseSolution);
 } // namespace TriangleCalculatorLib
 
 #endif
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef TRIANGLE_FILE_HPP
+#define TRIANGLE_FILE_HPP
+
+#include "ReturnCode.hpp"
+#include "Triangle.hpp"
+#include "TriangleBatch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace TriangleCalculatorLib
+{
+    /// Memory-mapped columnar triangle file (.tcb).
+    ///
+    /// Layout (little endian), version 1:
+    ///   128 byte header: magic "TRICALC\0", u32 version, u32 header size, u64 row count, u64 row capacity,
+    ///                    u32 angle unit (0 degrees, 1 radians), u32 reserved,
+    ///                    u64 byte offset of each column (known, sideA, sideB, sideC, angleA, angleB, angleC, codes)
+    ///   columns:         known masks (u8), six double columns, result codes (u8), each `capacity` rows long
+    ///                    and starting on a 64 byte boundary
+    /// The solver works on the mapped columns directly, nothing is parsed or copied.
+    class TriangleFile {
+    public:
+        static constexpr std::uint32_t FormatVersion = 1;
+
+        enum class Access : std::uint8_t
+        {
+            CopyOnWrite, // private mapping: the columns can be solved in place, the file itself never changes
+            ReadWrite    // shared mapping: changes to the columns go to the file
+        };
+
+        TriangleFile() = default;
+        ~TriangleFile();
+
+        TriangleFile(TriangleFile&& other) noexcept;
+        TriangleFile& operator=(TriangleFile&& other) noexcept;
+        TriangleFile(const TriangleFile&) = delete;
+        TriangleFile& operator=(const TriangleFile&) = delete;
+
+        /// Map an existing file
+        /// @return InvalidData (and nothing is open) if the file can not be mapped or is not a valid triangle file
+        ResultCode open(const std::filesystem::path& path, Access access = Access::CopyOnWrite);
+
+        /// Create (or truncate) a file with room for capacity rows and map it read-write, it starts with 0 rows
+        /// @return InvalidData (and nothing is open) if the file can not be created
+        ResultCode create(const std::filesystem::path& path, std::size_t capacity, AngleUnit unit = AngleUnit::Degrees);
+
+        void close() noexcept;
+
+        bool isOpen() const noexcept { return mapping_ != nullptr; }
+        std::size_t size() const noexcept;
+        std::size_t capacity() const noexcept;
+        AngleUnit unit() const noexcept;
+
+        /// Set the number of rows, at most capacity()
+        /// @return InvalidData if count is larger than the capacity
+        ResultCode resize(std::size_t count) noexcept;
+
+        /// The first size() rows of every column, pointing into the mapping
+        TriangleColumns columns() noexcept;
+
+        /// Flush a ReadWrite mapping to disk
+        /// @return InvalidData if the flush failed
+        ResultCode sync() noexcept;
+
+    private:
+        struct Header;
+
+        Header* header() const noexcept;
+        ResultCode map(int fd, std::size_t bytes, Access access);
+
+        void* mapping_ = nullptr;
+        std::size_t mappingSize_ = 0;
+    };
+} // namespace TriangleCalculatorLib
+
+#endif // TRIANGLE_FILE_HPP
@@ -0,0 +1,149 @@
+#ifndef TRIANGLE_GENERATOR_HPP
+#define TRIANGLE_GENERATOR_HPP
+
+#include "CompactTriangle.hpp"
+#include "ReturnCode.hpp"
+#include "Triangle.hpp"
+#include "TriangleBatch.hpp"
+#include "TriangleStream.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string_view>
+
+namespace TriangleCalculatorLib
+{
+    class ThreadPool;
+
+    // which three values of a generated triangle are given
+    enum class GeneratorCase : std::uint8_t
+    {
+        SSS, // 3 sides
+        SAS, // 2 sides and the included angle
+        SSA, // 2 sides and the angle opposite the longer one (one solution)
+        ASA, // 2 angles and the included side
+        AAS, // 2 angles and a non-included side
+        Count
+    };
+
+    // the shape a generated triangle is cut from, the categories of tests/TriangleGenerator.py
+    enum class TriangleShape : std::uint8_t
+    {
+        Right,
+        Equilateral,
+        Isosceles,
+        Scalene,
+        Count
+    };
+
+    // what the given values of a generated triangle describe
+    enum class GeneratedKind : std::uint8_t
+    {
+        Valid,     // exactly one triangle
+        Ambiguous, // SSA with two triangles
+        Invalid    // no triangle: sides breaking the triangle inequality, angles of 180 or more, SSA too short to close
+    };
+
+    constexpr std::string_view to_string(GeneratorCase generatorCase) noexcept
+    {
+        switch (generatorCase)
+        {
+            case GeneratorCase::SSS: return "SSS";
+            case GeneratorCase::SAS: return "SAS";
+            case GeneratorCase::SSA: return "SSA";
+            case GeneratorCase::ASA: return "ASA";
+            case GeneratorCase::AAS: return "AAS";
+            case GeneratorCase::Count: break;
+        }
+        return "Unknown";
+    }
+
+    constexpr std::string_view to_string(TriangleShape shape) noexcept
+    {
+        switch (shape)
+        {
+            case TriangleShape::Right: return "right";
+            case TriangleShape::Equilateral: return "equilateral";
+            case TriangleShape::Isosceles: return "isosceles";
+            case TriangleShape::Scalene: return "scalene";
+            case TriangleShape::Count: break;
+        }
+        return "unknown";
+    }
+
+    /// The make-up of a generated workload. Weights are relative and need not sum to 1.
+    /// Every row is first drawn invalid (invalidFraction), then ambiguous (ambiguousFraction),
+    /// otherwise it is a valid row of a case drawn from `cases`; invalid rows draw their case the same way.
+    struct GeneratorMix
+    {
+        static constexpr std::size_t CaseCount = static_cast<std::size_t>(GeneratorCase::Count);
+        static constexpr std::size_t ShapeCount = static_cast<std::size_t>(TriangleShape::Count);
+
+        std::array<double, CaseCount> cases{1.0, 1.0, 1.0, 1.0, 1.0};
+        /// right, equilateral, isosceles, scalene: the 20/20/20/40 split of the Python fixture
+        std::array<double, ShapeCount> shapes{20.0, 20.0, 20.0, 40.0};
+        double ambiguousFraction = 0.0;
+        double invalidFraction = 0.0;
+
+        double& weight(GeneratorCase generatorCase) noexcept { return cases[static_cast<std::size_t>(generatorCase)]; }
+        double& weight(TriangleShape shape) noexcept { return shapes[static_cast<std::size_t>(shape)]; }
+    };
+
+    struct GeneratorOptions
+    {
+        /// The same seed gives the same rows, whatever the thread count or how the rows are split up
+        std::uint64_t seed = 42;
+        GeneratorMix mix;
+        AngleUnit unit = AngleUnit::Degrees;
+        /// Index of the first row, so a load split over several machines can give each its own range
+        /// (rows [firstRow, firstRow + count) are the same as in one run from 0)
+        std::uint64_t firstRow = 0;
+        /// Generate shards of this many rows on the pool if set, on the calling thread otherwise
+        ThreadPool* pool = nullptr;
+        std::size_t shardSize = 64 * 1024;
+    };
+
+    /// One generated row: the solver input and the complete triangle it was cut from
+    struct GeneratedTriangle
+    {
+        CompactTriangle input;    // only the values of the case are known
+        CompactTriangle complete; // all six values: for ambiguous rows the first solution, for invalid ones the triangle before it was broken
+        GeneratorCase generatorCase = GeneratorCase::SSS;
+        TriangleShape shape = TriangleShape::Scalene;
+        GeneratedKind kind = GeneratedKind::Valid;
+    };
+
+    /// Deterministic synthetic workloads for load tests, the C++ replacement of tests/TriangleGenerator.py
+    /// at volumes the Python can not reach. Every row is a pure function of the seed and its index (a
+    /// counter-based random stream per row), so shards are generated in parallel and written in order
+    /// without changing a byte of the output.
+    class TriangleGenerator
+    {
+    public:
+        /// The row with the given index
+        static GeneratedTriangle generate(const GeneratorOptions& options, std::uint64_t row) noexcept;
+
+        /// Fill every row of the columns with the inputs of rows [options.firstRow, options.firstRow + size)
+        static void generate(const GeneratorOptions& options, const TriangleColumns& columns);
+
+        /// Write count rows as text input (with a header for CSV), formatted shard by shard in large blocks
+        /// @return InvalidData if writing failed
+        static ResultCode write(std::ostream& output, StreamFormat format, std::uint64_t count, const GeneratorOptions& options);
+
+        /// Create a binary triangle file (.tcb) of count rows, the shards are generated straight into the mapping
+        /// @return InvalidData if the file can not be created or flushed
+        static ResultCode writeFile(const std::filesystem::path& path, std::uint64_t count, const GeneratorOptions& options);
+
+        /// Parse weights like "SSS=2,SAS=1", cases left out get weight 0
+        /// @return false (and the mix is unchanged) on an unknown name or a value that is not a weight
+        static bool parseCases(std::string_view text, GeneratorMix& mix);
+
+        /// Parse weights like "right=1,scalene=3", shapes left out get weight 0
+        static bool parseShapes(std::string_view text, GeneratorMix& mix);
+    };
+} // namespace TriangleCalculatorLib
+
+#endif // TRIANGLE_GENERATOR_HPP
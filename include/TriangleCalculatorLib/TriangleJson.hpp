@@ -0,0 +1,61 @@
+#ifndef TRIANGLE_JSON_HPP
+#define TRIANGLE_JSON_HPP
+
+#include "ReturnCode.hpp"
+#include "TriangleBatch.hpp"
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string_view>
+
+namespace TriangleCalculatorLib
+{
+    struct JsonReadStats
+    {
+        std::size_t triangles = 0; // rows filled
+        std::size_t malformed = 0; // triangle objects with the wrong values, filled as all unknown with InvalidData
+        std::size_t bytes = 0;     // input consumed
+    };
+
+    /// Streaming reader for triangles stored as {"sides":[a,b,c],"angles":[A,B,C]} objects with null for
+    /// unknown values, the shape of tests/triangles_fp.json. No document is built: the input is tokenized
+    /// in place, block by block, and every object holding "sides" or "angles" becomes a row of the columns
+    /// handed to read(). Where such objects sit does not matter (in arrays under category keys like the
+    /// fixture, one per line like NDJSON), other values are skipped.
+    /// Memory is one input block plus the nesting depth, independent of the input size.
+    ///
+    /// A triangle object with a sides or angles array that does not hold exactly three numbers or nulls
+    /// is counted as malformed and filled as all unknown with InvalidData. Input that is not JSON at all
+    /// stops the reader (status() turns InvalidData).
+    class TriangleJsonReader
+    {
+    public:
+        /// Read from a stream, in blocks
+        explicit TriangleJsonReader(std::istream& input);
+
+        /// Read text already in memory (a mapped file for instance), nothing is copied
+        explicit TriangleJsonReader(std::string_view text);
+
+        ~TriangleJsonReader();
+
+        TriangleJsonReader(const TriangleJsonReader&) = delete;
+        TriangleJsonReader& operator=(const TriangleJsonReader&) = delete;
+
+        /// Fill rows with the next triangles and reset their result codes (InvalidData for malformed ones)
+        /// @return The number of rows filled, fewer than rows.size() once the input ended or failed
+        std::size_t read(const TriangleColumns& rows);
+
+        /// InvalidData after a read error, a JSON syntax error or input that ended inside a value
+        ResultCode status() const noexcept;
+
+        const JsonReadStats& stats() const noexcept;
+
+    private:
+        struct Parser;
+
+        std::unique_ptr<Parser> parser_;
+    };
+} // namespace TriangleCalculatorLib
+
+#endif // TRIANGLE_JSON_HPP
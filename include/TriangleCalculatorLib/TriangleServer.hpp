@@ -0,0 +1,102 @@
+#ifndef TRIANGLE_SERVER_HPP
+#define TRIANGLE_SERVER_HPP
+
+#include "CompactTriangle.hpp"
+#include "ReturnCode.hpp"
+#include "Triangle.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TriangleCalculatorLib
+{
+    class ThreadPool;
+
+    struct ServerOptions
+    {
+        /// The Unix domain socket to listen on, a stale socket file left there is replaced;
+        /// listen() fails while another server still accepts connections on it
+        std::filesystem::path socketPath;
+        AngleUnit unit = AngleUnit::Degrees;
+        AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution;
+        /// Binary requests of at least this many triangles are split over the pool, in pieces of this size.
+        /// Smaller requests and text lines are solved on the event loop: handing them over would cost more than the solve.
+        std::size_t poolThreshold = 1024;
+        /// Solve large binary requests here if set, everything on the event loop otherwise
+        ThreadPool* pool = nullptr;
+        /// Stop reading from a client while this many reply bytes wait for it
+        std::size_t maxPendingOutput = 16 * 1024 * 1024;
+    };
+
+    /// Binary requests and replies of TriangleServer, little endian and unaligned:
+    ///   header:   u8 FrameMarker, 3 reserved bytes (0), u32 triangle count
+    ///   request:  count records of u8 known mask (KnownField bits), f64 sideA, sideB, sideC, angleA, angleB, angleC
+    ///   reply:    the same header, then count records of u8 ResultCode, u8 known mask, the six f64
+    /// The marker is a control character no text line starts with, so both kinds mix on one connection.
+    struct ServerProtocol
+    {
+        static constexpr std::uint8_t FrameMarker = 0x01;
+        static constexpr std::size_t HeaderSize = 8;
+        static constexpr std::size_t RequestRecordSize = 1 + 6 * sizeof(double);
+        static constexpr std::size_t ReplyRecordSize = 2 + 6 * sizeof(double);
+        /// Larger requests close the connection, a batch is at most this many triangles
+        static constexpr std::uint32_t MaxFrameTriangles = 1u << 22;
+
+        /// Append one binary request for the triangles
+        static void appendRequest(std::string& out, std::span<const CompactTriangle> triangles);
+
+        /// Parse the binary reply at the start of input
+        /// @param triangles Receives the solved triangles, appended
+        /// @param codes Receives their result codes, appended
+        /// @return The bytes of the reply, 0 while input does not hold a whole reply yet
+        static std::size_t parseReply(std::string_view input, std::vector<CompactTriangle>& triangles,
+                                      std::vector<ResultCode>& codes);
+    };
+
+    /// Long running solver behind a Unix domain socket, so clients solving a few triangles at a time
+    /// skip process start-up. One epoll event loop serves every connection; clients may pipeline any
+    /// number of requests and get the replies in request order.
+    ///
+    /// Requests are either
+    ///   - text lines like the batch input, each solved on its own and answered with one result line
+    ///     (with code) in the same format: a line starting with '{' is NDJSON, anything else CSV.
+    ///     Blank lines are skipped, malformed ones answered as all unknown with InvalidData, lines
+    ///     longer than 64 KiB close the connection.
+    ///   - binary batches in the ServerProtocol format, answered with a binary reply.
+    ///
+    /// The event loop needs epoll, on other platforms listen() and run() fail with InvalidData.
+    class TriangleServer
+    {
+    public:
+        explicit TriangleServer(ServerOptions options);
+        ~TriangleServer();
+
+        TriangleServer(const TriangleServer&) = delete;
+        TriangleServer& operator=(const TriangleServer&) = delete;
+
+        /// Create the socket and start listening, clients may connect from here on
+        /// @return InvalidData (and nothing is listening) if the socket or the event loop can not be set up,
+        ///         or another server listens on the socket path
+        ResultCode listen();
+
+        /// Serve until stop() is called, then close every connection and remove the socket file
+        /// @return InvalidData if listen() did not succeed or the event loop failed, Success after stop()
+        ResultCode run();
+
+        /// Make run() return, from any thread or a signal handler
+        void stop() noexcept;
+
+    private:
+        struct Loop;
+
+        std::unique_ptr<Loop> loop_;
+    };
+} // namespace TriangleCalculatorLib
+
+#endif // TRIANGLE_SERVER_HPP
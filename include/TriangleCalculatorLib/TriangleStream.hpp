@@ -0,0 +1,92 @@
+#ifndef TRIANGLE_STREAM_HPP
+#define TRIANGLE_STREAM_HPP
+
+#include "CompactTriangle.hpp"
+#include "ReturnCode.hpp"
+#include "Triangle.hpp"
+#include "TriangleBatch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace TriangleCalculatorLib
+{
+    class ThreadPool;
+
+    // text formats of the streaming solver, one triangle per line
+    enum class StreamFormat : std::uint8_t
+    {
+        // An optional first line naming these columns (and code) is skipped. Output adds a code column.
+        Csv,
+        // flat objects {"angleA":..,"sideA":..}, missing keys, null or "?" for unknowns.
+        // Output objects carry all six fields (null when unknown) and "code".
+        Ndjson
+    };
+
+    struct StreamOptions
+    {
+        StreamFormat inputFormat = StreamFormat::Csv;
+        StreamFormat outputFormat = StreamFormat::Csv;
+        AngleUnit unit = AngleUnit::Degrees;
+        AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution;
+        /// Triangles parsed and solved at a time, bounds the memory used independent of the input size
+        std::size_t chunkSize = 64 * 1024;
+        /// Solve the chunks on this pool if set, on the calling thread otherwise
+        ThreadPool* pool = nullptr;
+    };
+
+    struct StreamStats
+    {
+        std::size_t triangles = 0;      // rows written, one per non-empty input line
+        std::size_t malformedLines = 0; // lines that could not be parsed, written as all unknown with InvalidData
+    };
+
+    class TriangleStream {
+    public:
+        /// Read triangles from input until it ends, solve them chunk by chunk and write one result line per triangle
+        /// Input and output are moved in large blocks, every output line keeps the position of its input line
+        /// @param input The text to read, in options.inputFormat
+        /// @param output Receives the solved triangles in options.outputFormat
+        /// @param stats Receives the number of triangles and malformed lines if set
+        /// @return InvalidData if reading or writing failed, Success otherwise (per triangle codes are in the output)
+        static ResultCode solve(std::istream& input, std::ostream& output, const StreamOptions& options = {},
+                                StreamStats* stats = nullptr);
+
+        /// Read triangles from input until it ends, without solving them
+        /// @param onTriangle Called for every triangle with whether its line was malformed (then it is all unknown),
+        ///                   returning false stops reading
+        /// @return InvalidData if reading failed or onTriangle stopped it, Success otherwise
+        static ResultCode read(std::istream& input, StreamFormat format,
+                               const std::function<bool(const CompactTriangle& triangle, bool malformed)>& onTriangle,
+                               StreamStats* stats = nullptr);
+
+        /// Write every row of the columns with its result code, in blocks
+        /// @return InvalidData if the column lengths differ or writing failed, Success otherwise
+        static ResultCode write(std::ostream& output, StreamFormat format, const TriangleColumns& columns);
+
+        /// Append the CSV header line naming the six input columns, nothing for NDJSON
+        static void appendHeader(std::string& out, StreamFormat format);
+
+        /// Append one triangle as an input line (no code), what parseCsvLine and parseNdjsonLine read back
+        static void appendLine(std::string& out, StreamFormat format, const CompactTriangle& triangle);
+
+        /// Append one solved triangle as an output line, with its code like the lines solve() writes
+        static void appendResult(std::string& out, StreamFormat format, const CompactTriangle& triangle, ResultCode code);
+
+        /// Parse one CSV line, nullopt if it is malformed; the code column of a solved line is accepted and ignored
+        static std::optional<CompactTriangle> parseCsvLine(std::string_view line);
+
+        /// Parse one NDJSON line, nullopt if it is malformed
+        static std::optional<CompactTriangle> parseNdjsonLine(std::string_view line);
+
+        /// Parse a format name ("csv" or "ndjson")
+        static std::optional<StreamFormat> parseFormat(std::string_view name);
+    };
+} // namespace TriangleCalculatorLib
+
+#endif // TRIANGLE_STREAM_HPP
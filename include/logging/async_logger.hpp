@@ -0,0 +1,175 @@
+// Logger that hands records to a background thread through a bounded lock-free queue.
+#ifndef LOGGING_ASYNC_LOGGER_HPP
+#define LOGGING_ASYNC_LOGGER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include <logging/logging.hpp>
+
+namespace logiface {
+
+// what log() does when the queue is full
+enum class overflow_policy {
+    drop,  // discard the record and count it in dropped()
+    block  // wait for the background thread to make room
+};
+
+// Decorates another logger: log() copies the record into a slot of a bounded
+// multi-producer/single-consumer ring and returns, the wrapped sink is only ever
+// called from the background thread, one record at a time. The destructor drains
+// everything that was queued before it returns.
+class async_logger final : public logger {
+public:
+    // longest message kept per record, longer messages are cut off
+    static constexpr std::size_t max_message_size = 512 - 64;
+
+    explicit async_logger(logger& sink,
+                          std::size_t capacity = 4096,
+                          overflow_policy policy = overflow_policy::drop,
+                          level min_level = level::trace)
+        : sink_{sink},
+          capacity_{std::bit_ceil(std::max<std::size_t>(capacity, 2))},
+          slots_{std::make_unique<slot[]>(capacity_)},
+          policy_{policy},
+          min_level_{min_level} {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        worker_ = std::thread([this] { drain(); });
+    }
+
+    ~async_logger() override {
+        if (get_logger() == this) {
+            set_logger(nullptr);
+        }
+        stopping_.store(true, std::memory_order_release);
+        wake_consumer();
+        worker_.join();
+    }
+
+    async_logger(const async_logger&) = delete;
+    async_logger& operator=(const async_logger&) = delete;
+
+    void log(const record& r) noexcept override {
+        if (static_cast<int>(r.lvl) < static_cast<int>(get_level())) return;
+
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        slot* target = nullptr;
+        while (true) {
+            target = &slots_[pos & (capacity_ - 1)];
+            const std::size_t seq = target->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // full: the consumer has not released this slot from the previous lap yet
+                if (policy_ == overflow_policy::drop) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                std::this_thread::yield();
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        target->lvl = r.lvl;
+        target->file = r.file;
+        target->function = r.function;
+        target->line = r.line;
+        target->timestamp = r.timestamp;
+        target->length = std::min(r.message.size(), max_message_size);
+        std::copy_n(r.message.data(), target->length, target->message);
+        target->sequence.store(pos + 1, std::memory_order_release);
+
+        wake_consumer();
+    }
+
+    void set_level(level lvl) noexcept override { min_level_.store(lvl, std::memory_order_relaxed); }
+    level get_level() const noexcept override { return min_level_.load(std::memory_order_relaxed); }
+
+    // wait until every record queued before this call has reached the sink
+    void flush() noexcept {
+        const std::size_t target = enqueue_pos_.load(std::memory_order_acquire);
+        std::size_t done = drained_.load(std::memory_order_acquire);
+        while (done < target) {
+            drained_.wait(done, std::memory_order_acquire);
+            done = drained_.load(std::memory_order_acquire);
+        }
+    }
+
+    // number of records discarded because the queue was full (drop policy only)
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct slot {
+        std::atomic<std::size_t> sequence{0};
+        level lvl{level::trace};
+        const char* file{nullptr};
+        const char* function{nullptr};
+        int line{0};
+        std::chrono::system_clock::time_point timestamp{};
+        std::size_t length{0};
+        char message[max_message_size];
+    };
+
+    void wake_consumer() noexcept {
+        signal_.fetch_add(1, std::memory_order_release);
+        signal_.notify_one();
+    }
+
+    void drain() noexcept {
+        std::size_t pos = 0;
+        while (true) {
+            const std::uint32_t signal = signal_.load(std::memory_order_acquire);
+
+            slot& current = slots_[pos & (capacity_ - 1)];
+            if (current.sequence.load(std::memory_order_acquire) == pos + 1) {
+                sink_.log(record{current.lvl,
+                                 std::string_view(current.message, current.length),
+                                 current.file,
+                                 current.function,
+                                 current.line,
+                                 current.timestamp});
+                current.sequence.store(pos + capacity_, std::memory_order_release);
+                ++pos;
+                drained_.store(pos, std::memory_order_release);
+                drained_.notify_all();
+                continue;
+            }
+
+            // empty (or the next producer has claimed but not yet filled its slot)
+            if (stopping_.load(std::memory_order_acquire) &&
+                pos == enqueue_pos_.load(std::memory_order_acquire)) {
+                return;
+            }
+            signal_.wait(signal, std::memory_order_acquire);
+        }
+    }
+
+    logger& sink_;
+    const std::size_t capacity_;
+    std::unique_ptr<slot[]> slots_;
+    const overflow_policy policy_;
+    std::atomic<level> min_level_;
+
+    alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<std::size_t> drained_{0};
+    alignas(64) std::atomic<std::uint32_t> signal_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<bool> stopping_{false};
+    std::thread worker_;
+};
+
+} // namespace logiface
+
+#endif // LOGGING_ASYNC_LOGGER_HPP
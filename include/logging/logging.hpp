@@ -1,9 +1,15 @@
 #ifndef LOGGING_LOGGING_HPP
 #define LOGGING_LOGGING_HPP
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <charconv>
 #include <chrono>
+#include <cstddef>
+#include <optional>
 #include <string_view>
+#include <type_traits>
 
 #ifndef LOGIFACE_ENABLE_LOGGING
 #define LOGIFACE_ENABLE_LOGGING 1
@@ -48,35 +54,154 @@ inline logger* get_logger() noexcept {
     return detail::g_logger.load(std::memory_order_acquire);
 }
 
+namespace detail {
+    // fixed stack buffer for deferred formatting, output past the capacity is cut off
+    class format_buffer {
+    public:
+        static constexpr std::size_t capacity = 1024;
+
+        void append(std::string_view text) noexcept {
+            const std::size_t n = std::min(text.size(), capacity - size_);
+            std::copy_n(text.data(), n, data_.data() + size_);
+            size_ += n;
+        }
+
+        void append(const char* text) noexcept { append(std::string_view(text ? text : "(null)")); }
+
+        void append(bool value) noexcept { append(value ? std::string_view("true") : std::string_view("false")); }
+
+        void append(char value) noexcept { append(std::string_view(&value, 1)); }
+
+        template <typename T>
+            requires(std::is_integral_v<T> || std::is_floating_point_v<T>)
+        void append(T value) noexcept {
+            char* first = data_.data() + size_;
+            char* last = data_.data() + capacity;
+            std::to_chars_result result;
+            if constexpr (std::is_floating_point_v<T>) {
+                // six fixed decimals, the same text std::to_string gives
+                result = std::to_chars(first, last, value, std::chars_format::fixed, 6);
+            } else {
+                result = std::to_chars(first, last, value);
+            }
+            size_ = result.ec == std::errc{} ? static_cast<std::size_t>(result.ptr - data_.data()) : capacity;
+        }
+
+        // unknown values print as '?'
+        template <typename T>
+        void append(const std::optional<T>& value) noexcept {
+            if (value) {
+                append(*value);
+            } else {
+                append('?');
+            }
+        }
+
+        template <typename T>
+            requires(std::is_enum_v<T>)
+        void append(T value) noexcept {
+            append(static_cast<std::underlying_type_t<T>>(value));
+        }
+
+        std::string_view view() const noexcept { return {data_.data(), size_}; }
+
+    private:
+        std::array<char, capacity> data_;
+        std::size_t size_ = 0;
+    };
+
+    inline void format_to(format_buffer& buffer, std::string_view fmt) noexcept {
+        buffer.append(fmt);
+    }
+
+    // replace each "{}" in fmt with the next argument
+    template <typename First, typename... Rest>
+    void format_to(format_buffer& buffer, std::string_view fmt, const First& first, const Rest&... rest) noexcept {
+        const std::size_t placeholder = fmt.find("{}");
+        if (placeholder == std::string_view::npos) {
+            buffer.append(fmt);
+            return;
+        }
+        buffer.append(fmt.substr(0, placeholder));
+        buffer.append(first);
+        format_to(buffer, fmt.substr(placeholder + 2), rest...);
+    }
+} // namespace detail
+
 #if LOGIFACE_ENABLE_LOGGING
 #ifndef LOGIFACE_MIN_LEVEL
 #define LOGIFACE_MIN_LEVEL trace
 #endif
 
+// the installed logger when a record at this level would reach it, null otherwise;
+// checked before any message is built or timestamp taken. The record goes to this
+// logger: loading it again could see it replaced or removed in between
+inline logger* logger_for(level lvl) noexcept {
+    if (static_cast<int>(lvl) < static_cast<int>(level::LOGIFACE_MIN_LEVEL)) return nullptr;
+    auto* lg = get_logger();
+    return lg && static_cast<int>(lvl) >= static_cast<int>(lg->get_level()) ? lg : nullptr;
+}
+
+// true when a record at this level would reach the installed logger
+inline bool should_log(level lvl) noexcept {
+    return logger_for(lvl) != nullptr;
+}
+
 inline void log(level lvl,
                 std::string_view msg,
                 const char* file,
                 const char* func,
                 int line) {
-    if (static_cast<int>(lvl) < static_cast<int>(level::LOGIFACE_MIN_LEVEL)) return;
-    if (auto* lg = get_logger()) {
-        lg->log(record{
+    auto* lg = logger_for(lvl);
+    if (!lg) return;
+    lg->log(record{
+        lvl,
+        msg,
+        file,
+        func,
+        line,
+        std::chrono::system_clock::now()});
+}
+
+namespace detail {
+    // formatting does not throw, the logger may: its exceptions reach the caller as with log()
+    template <typename... Args>
+    void log_format(logger& lg, level lvl, const char* file, const char* func, int line,
+                    std::string_view fmt, const Args&... args) {
+        format_buffer buffer;
+        format_to(buffer, fmt, args...);
+        lg.log(record{
             lvl,
-            msg,
+            buffer.view(),
             file,
             func,
             line,
             std::chrono::system_clock::now()});
     }
-}
+} // namespace detail
 
 #define LOGIFACE_LOG(lvl, msg)                                                \
     ::logiface::log(::logiface::level::lvl, std::string_view(msg), __FILE__,  \
                     __func__, __LINE__)
 
+// Deferred formatting: LOGIFACE_LOGF(info, "a={} b={}", a, b).
+// The level is checked first; the arguments are only evaluated and formatted
+// (into a stack buffer, without allocating) when the record will be logged.
+#define LOGIFACE_LOGF(lvl, ...)                                                    \
+    do {                                                                           \
+        if (auto* logiface_lg_ = ::logiface::logger_for(::logiface::level::lvl)) { \
+            ::logiface::detail::log_format(*logiface_lg_, ::logiface::level::lvl,  \
+                                           __FILE__, __func__, __LINE__,           \
+                                           __VA_ARGS__);                           \
+        }                                                                          \
+    } while (false)
+
 #else
+inline logger* logger_for(level) noexcept { return nullptr; }
+inline bool should_log(level) noexcept { return false; }
 inline void log(level, std::string_view, const char*, const char*, int) {}
 #define LOGIFACE_LOG(lvl, msg) ((void)0)
+#define LOGIFACE_LOGF(lvl, ...) ((void)0)
 #endif
 
 } // namespace logiface
@@ -0,0 +1,193 @@
+// Logger that stops repeated messages from one call site from flooding the sink.
+#ifndef LOGGING_RATE_LIMITED_LOGGER_HPP
+#define LOGGING_RATE_LIMITED_LOGGER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include <logging/logging.hpp>
+
+namespace logiface {
+
+// Decorates another logger. Records are grouped by call site (file and line); per site
+// the first `burst` records of every `period` are passed on, later ones are only counted.
+// The first record of a site after its period ran out is preceded by a
+// "suppressed K occurrences" summary. A site that goes quiet is only reported by
+// flush_expired(), which long running processes call periodically, or by the destructor.
+// Safe for concurrent callers, the site table is lock-free and fixed size; once it is full,
+// records from new call sites pass through unlimited.
+class rate_limited_logger final : public logger {
+public:
+    explicit rate_limited_logger(logger& sink,
+                                 std::uint32_t burst = 10,
+                                 std::chrono::milliseconds period = std::chrono::seconds(1),
+                                 std::size_t max_sites = 256,
+                                 level min_level = level::trace)
+        : sink_{sink},
+          burst_{burst},
+          period_{period},
+          capacity_{std::bit_ceil(std::max<std::size_t>(max_sites, 1))},
+          sites_{std::make_unique<site[]>(capacity_)},
+          min_level_{min_level} {}
+
+    ~rate_limited_logger() override {
+        if (get_logger() == this) {
+            set_logger(nullptr);
+        }
+        flush_suppressed();
+    }
+
+    rate_limited_logger(const rate_limited_logger&) = delete;
+    rate_limited_logger& operator=(const rate_limited_logger&) = delete;
+
+    void log(const record& r) override {
+        if (static_cast<int>(r.lvl) < static_cast<int>(get_level())) return;
+
+        site* entry = find_site(r);
+        if (!entry) {
+            sink_.log(r);
+            return;
+        }
+
+        const std::int64_t now = r.timestamp.time_since_epoch().count();
+        std::int64_t start = entry->window_start.load(std::memory_order_acquire);
+        if (now - start >= period_ticks() &&
+            entry->window_start.compare_exchange_strong(start, now, std::memory_order_acq_rel)) {
+            // this caller opened the new window: report the previous one and reset the budget
+            entry->in_window.store(0, std::memory_order_relaxed);
+            const std::uint64_t suppressed = entry->suppressed.exchange(0, std::memory_order_relaxed);
+            if (suppressed > 0) {
+                emit_summary(r, suppressed, r.message);
+            }
+        }
+
+        if (entry->in_window.fetch_add(1, std::memory_order_relaxed) < burst_) {
+            sink_.log(r);
+        } else {
+            entry->suppressed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void set_level(level lvl) noexcept override { min_level_.store(lvl, std::memory_order_relaxed); }
+    level get_level() const noexcept override { return min_level_.load(std::memory_order_relaxed); }
+
+    // report every site that still has suppressed records, without waiting for its period to end
+    void flush_suppressed() {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            site& entry = sites_[i];
+            // a site just claimed by another thread is left for later, its details may not be there yet
+            if (!entry.ready.load(std::memory_order_acquire)) continue;
+            const std::uint64_t suppressed = entry.suppressed.exchange(0, std::memory_order_relaxed);
+            if (suppressed > 0) {
+                emit_summary(summary_record(entry, std::chrono::system_clock::now()), suppressed, {});
+            }
+        }
+    }
+
+    // report the sites whose period ran out with records still suppressed, as their next record would,
+    // and start their next period; without it a burst followed by silence is only reported at the end
+    void flush_expired(std::chrono::system_clock::time_point now = std::chrono::system_clock::now()) {
+        const std::int64_t ticks = now.time_since_epoch().count();
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            site& entry = sites_[i];
+            if (!entry.ready.load(std::memory_order_acquire) || entry.suppressed.load(std::memory_order_relaxed) == 0) continue;
+            std::int64_t start = entry.window_start.load(std::memory_order_acquire);
+            if (ticks - start >= period_ticks() &&
+                entry.window_start.compare_exchange_strong(start, ticks, std::memory_order_acq_rel)) {
+                entry.in_window.store(0, std::memory_order_relaxed);
+                const std::uint64_t suppressed = entry.suppressed.exchange(0, std::memory_order_relaxed);
+                if (suppressed > 0) {
+                    emit_summary(summary_record(entry, now), suppressed, {});
+                }
+            }
+        }
+    }
+
+private:
+    struct site {
+        std::atomic<std::uint64_t> key{0};
+        std::atomic<std::int64_t> window_start{std::numeric_limits<std::int64_t>::min() / 2};
+        std::atomic<std::uint32_t> in_window{0};
+        std::atomic<std::uint64_t> suppressed{0};
+        // call site details for the summaries flush_suppressed() reports
+        std::atomic<level> lvl{level::trace};
+        std::atomic<const char*> file{nullptr};
+        std::atomic<const char*> function{nullptr};
+        std::atomic<int> line{0};
+        // set once the details above are stored, after the key: other threads may match the key sooner
+        std::atomic<bool> ready{false};
+    };
+
+    // a record at the call site of a ready site, for its summaries
+    static record summary_record(const site& entry, std::chrono::system_clock::time_point now) noexcept {
+        return record{entry.lvl.load(std::memory_order_relaxed),
+                      {},
+                      entry.file.load(std::memory_order_relaxed),
+                      entry.function.load(std::memory_order_relaxed),
+                      entry.line.load(std::memory_order_relaxed),
+                      now};
+    }
+
+    std::int64_t period_ticks() const noexcept {
+        return std::chrono::duration_cast<std::chrono::system_clock::duration>(period_).count();
+    }
+
+    // file names are string literals, so the pointer identifies the file; it is packed with the line
+    // into one key (user space pointers fit in 48 bits), a rare collision only shares a budget
+    static std::uint64_t site_key(const record& r) noexcept {
+        const auto file = reinterpret_cast<std::uintptr_t>(r.file);
+        return (static_cast<std::uint64_t>(file) << 16) ^ static_cast<std::uint16_t>(r.line) ^ 1u;
+    }
+
+    site* find_site(const record& r) noexcept {
+        const std::uint64_t key = site_key(r);
+        std::size_t index = static_cast<std::size_t>(key * 0x9E3779B97F4A7C15ull >> 32) & (capacity_ - 1);
+        for (std::size_t probe = 0; probe < capacity_; ++probe, index = (index + 1) & (capacity_ - 1)) {
+            site& entry = sites_[index];
+            std::uint64_t current = entry.key.load(std::memory_order_acquire);
+            if (current == 0) {
+                if (entry.key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                    entry.lvl.store(r.lvl, std::memory_order_relaxed);
+                    entry.file.store(r.file, std::memory_order_relaxed);
+                    entry.function.store(r.function, std::memory_order_relaxed);
+                    entry.line.store(r.line, std::memory_order_relaxed);
+                    entry.ready.store(true, std::memory_order_release);
+                    return &entry;
+                }
+            }
+            if (current == key) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    void emit_summary(const record& site_record, std::uint64_t suppressed, std::string_view message) {
+        detail::format_buffer buffer;
+        if (message.empty()) {
+            detail::format_to(buffer, "suppressed {} occurrences", suppressed);
+        } else {
+            detail::format_to(buffer, "suppressed {} occurrences of: {}", suppressed, message);
+        }
+        record summary = site_record;
+        summary.message = buffer.view();
+        sink_.log(summary);
+    }
+
+    logger& sink_;
+    const std::uint32_t burst_;
+    const std::chrono::milliseconds period_;
+    const std::size_t capacity_;
+    std::unique_ptr<site[]> sites_;
+    std::atomic<level> min_level_;
+};
+
+} // namespace logiface
+
+#endif // LOGGING_RATE_LIMITED_LOGGER_HPP
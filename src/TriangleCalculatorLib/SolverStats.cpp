@@ -0,0 +1,354 @@
+#include <TriangleCalculatorLib/SolverStats.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <mutex>
+#include <new>
+
+namespace TriangleCalculatorLib
+{
+    std::atomic<bool> SolverStats::enabled_{false};
+
+    namespace
+    {
+        // the counters of one thread, only that thread writes them, snapshots read them concurrently
+        struct Counters
+        {
+            std::array<std::atomic<std::uint64_t>, SolverStats::CaseCount> cases{};
+            std::array<std::atomic<std::uint64_t>, SolverStats::CodeCount> codes{};
+            std::array<std::array<std::atomic<std::uint64_t>, SolverStats::LatencyBuckets>, SolverStats::CaseCount> latency{};
+            std::array<std::atomic<std::uint64_t>, SolverStats::CaseCount> totalNanoseconds{};
+            // links of the registry's live list, guarded by its mutex: registering a thread never allocates
+            Counters* previous = nullptr;
+            Counters* next = nullptr;
+        };
+
+        // a single writer needs no read-modify-write, a plain load and store keeps the lock prefix off the hot path
+        void Add(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        void AddTo(SolverStats::Snapshot& total, const Counters& counters)
+        {
+            for (std::size_t i = 0; i < SolverStats::CaseCount; ++i)
+            {
+                total.cases[i] += counters.cases[i].load(std::memory_order_relaxed);
+                SolverStats::Histogram& histogram = total.latency[i];
+                for (std::size_t bucket = 0; bucket < SolverStats::LatencyBuckets; ++bucket)
+                {
+                    const std::uint64_t count = counters.latency[i][bucket].load(std::memory_order_relaxed);
+                    histogram.buckets[bucket] += count;
+                    histogram.count += count;
+                }
+                histogram.totalNanoseconds += counters.totalNanoseconds[i].load(std::memory_order_relaxed);
+            }
+            for (std::size_t i = 0; i < SolverStats::CodeCount; ++i)
+            {
+                total.codes[i] += counters.codes[i].load(std::memory_order_relaxed);
+            }
+        }
+
+        void Subtract(SolverStats::Snapshot& total, const SolverStats::Snapshot& baseline)
+        {
+            for (std::size_t i = 0; i < SolverStats::CaseCount; ++i)
+            {
+                total.cases[i] -= baseline.cases[i];
+                SolverStats::Histogram& histogram = total.latency[i];
+                for (std::size_t bucket = 0; bucket < SolverStats::LatencyBuckets; ++bucket)
+                {
+                    histogram.buckets[bucket] -= baseline.latency[i].buckets[bucket];
+                }
+                histogram.count -= baseline.latency[i].count;
+                histogram.totalNanoseconds -= baseline.latency[i].totalNanoseconds;
+            }
+            for (std::size_t i = 0; i < SolverStats::CodeCount; ++i)
+            {
+                total.codes[i] -= baseline.codes[i];
+            }
+        }
+
+        // the blocks of the running threads, plus what finished threads counted.
+        // Counters are never cleared (another thread may be writing them), reset moves the baseline instead.
+        struct Registry
+        {
+            std::mutex mutex;
+            Counters* live = nullptr;
+            SolverStats::Snapshot retired;
+            SolverStats::Snapshot baseline;
+
+            // callers hold the mutex
+            SolverStats::Snapshot total() const
+            {
+                SolverStats::Snapshot snapshot = retired;
+                for (const Counters* counters = live; counters != nullptr; counters = counters->next)
+                {
+                    AddTo(snapshot, *counters);
+                }
+                return snapshot;
+            }
+        };
+
+        // never destroyed: pool threads owned by other statics (TriangleAsync::defaultPool) can outlive any
+        // static of this unit at exit, and their counters still fold into the registry when they end.
+        // Built in static storage so the first record does not allocate either.
+        Registry& GetRegistry()
+        {
+            alignas(Registry) static unsigned char storage[sizeof(Registry)];
+            static Registry& registry = *new (storage) Registry;
+            return registry;
+        }
+
+        // registers on the first count of a thread, folds into the retired totals when the thread exits
+        class ThreadCounters
+        {
+        public:
+            ThreadCounters() : registry_(GetRegistry())
+            {
+                std::lock_guard lock(registry_.mutex);
+                counters.next = registry_.live;
+                if (registry_.live != nullptr)
+                {
+                    registry_.live->previous = &counters;
+                }
+                registry_.live = &counters;
+            }
+
+            ~ThreadCounters()
+            {
+                std::lock_guard lock(registry_.mutex);
+                AddTo(registry_.retired, counters);
+                (counters.previous != nullptr ? counters.previous->next : registry_.live) = counters.next;
+                if (counters.next != nullptr)
+                {
+                    counters.next->previous = counters.previous;
+                }
+            }
+
+            Counters counters;
+
+        private:
+            Registry& registry_;
+        };
+
+        Counters& LocalCounters()
+        {
+            thread_local ThreadCounters local;
+            return local.counters;
+        }
+
+        void AppendNumber(std::string& out, std::uint64_t value)
+        {
+            std::array<char, 24> digits;
+            const auto result = std::to_chars(digits.data(), digits.data() + digits.size(), value);
+            out.append(digits.data(), result.ptr);
+        }
+
+        // integer nanoseconds as seconds in exponent form, exact where scaling a double by 1e-9 would round
+        void AppendSeconds(std::string& out, std::uint64_t nanoseconds)
+        {
+            AppendNumber(out, nanoseconds);
+            out += "e-09";
+        }
+
+        constexpr std::array<ResultCode, SolverStats::CodeCount> Codes{ResultCode::Success, ResultCode::InsufficientData,
+                                                                        ResultCode::TriangleAmbiguous, ResultCode::InvalidData};
+    } // namespace
+
+    std::size_t SolverStats::Histogram::bucketFor(std::uint64_t nanoseconds) noexcept
+    {
+        return std::min<std::size_t>(std::bit_width(nanoseconds), LatencyBuckets - 1);
+    }
+
+    std::uint64_t SolverStats::Snapshot::solves() const noexcept
+    {
+        std::uint64_t total = 0;
+        for (const std::uint64_t count : cases)
+        {
+            total += count;
+        }
+        return total;
+    }
+
+    void SolverStats::setEnabled(bool enabled) noexcept
+    {
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    SolverStats::Snapshot SolverStats::snapshot()
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard lock(registry.mutex);
+        Snapshot snapshot = registry.total();
+        Subtract(snapshot, registry.baseline);
+        return snapshot;
+    }
+
+    void SolverStats::reset()
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard lock(registry.mutex);
+        registry.baseline = registry.total();
+    }
+
+    bool SolverStats::sampleLatency() noexcept
+    {
+        thread_local std::uint32_t solves = 0;
+        return solves++ % LatencySampleInterval == 0;
+    }
+
+    void SolverStats::record(SolveCase solveCase, ResultCode code) noexcept
+    {
+        Counters& counters = LocalCounters();
+        Add(counters.cases[static_cast<std::size_t>(solveCase)], 1);
+        Add(counters.codes[static_cast<std::size_t>(code)], 1);
+    }
+
+    void SolverStats::record(SolveCase solveCase, ResultCode code, std::uint64_t nanoseconds) noexcept
+    {
+        record(solveCase, code);
+        Counters& counters = LocalCounters();
+        const auto index = static_cast<std::size_t>(solveCase);
+        Add(counters.latency[index][Histogram::bucketFor(nanoseconds)], 1);
+        Add(counters.totalNanoseconds[index], nanoseconds);
+    }
+
+    void SolverStats::record(SolveCase solveCase, const std::array<std::uint64_t, CodeCount>& codes, std::uint64_t rows,
+                             std::uint64_t nanoseconds) noexcept
+    {
+        if (rows == 0)
+        {
+            return;
+        }
+        Counters& counters = LocalCounters();
+        const auto index = static_cast<std::size_t>(solveCase);
+        Add(counters.cases[index], rows);
+        for (std::size_t i = 0; i < CodeCount; ++i)
+        {
+            Add(counters.codes[i], codes[i]);
+        }
+        Add(counters.latency[index][Histogram::bucketFor(nanoseconds / rows)], rows);
+        Add(counters.totalNanoseconds[index], nanoseconds);
+    }
+
+    std::string SolverStats::toJson(const Snapshot& snapshot)
+    {
+        std::string out = "{\"solves\":";
+        AppendNumber(out, snapshot.solves());
+
+        out += ",\"cases\":{";
+        for (std::size_t i = 0; i < CaseCount; ++i)
+        {
+            const Histogram& histogram = snapshot.latency[i];
+            out += i == 0 ? "\"" : ",\"";
+            out += to_string(static_cast<SolveCase>(i));
+            out += "\":{\"count\":";
+            AppendNumber(out, snapshot.cases[i]);
+            out += ",\"latency\":{\"count\":";
+            AppendNumber(out, histogram.count);
+            out += ",\"total_ns\":";
+            AppendNumber(out, histogram.totalNanoseconds);
+            // only the buckets in use, each with its exclusive upper bound (null for the unbounded one)
+            out += ",\"buckets\":[";
+            bool first = true;
+            for (std::size_t bucket = 0; bucket < LatencyBuckets; ++bucket)
+            {
+                if (histogram.buckets[bucket] == 0)
+                {
+                    continue;
+                }
+                out += first ? "{\"below_ns\":" : ",{\"below_ns\":";
+                first = false;
+                if (Histogram::upperBound(bucket) == 0)
+                {
+                    out += "null";
+                }
+                else
+                {
+                    AppendNumber(out, Histogram::upperBound(bucket));
+                }
+                out += ",\"count\":";
+                AppendNumber(out, histogram.buckets[bucket]);
+                out += '}';
+            }
+            out += "]}}";
+        }
+
+        out += "},\"codes\":{";
+        for (std::size_t i = 0; i < CodeCount; ++i)
+        {
+            out += i == 0 ? "\"" : ",\"";
+            out += to_string(Codes[i]);
+            out += "\":";
+            AppendNumber(out, snapshot.codes[i]);
+        }
+        out += "}}";
+        return out;
+    }
+
+    std::string SolverStats::toPrometheus(const Snapshot& snapshot)
+    {
+        std::string out;
+        out += "# HELP triangle_solves_total Triangles solved, by solver case.\n";
+        out += "# TYPE triangle_solves_total counter\n";
+        for (std::size_t i = 0; i < CaseCount; ++i)
+        {
+            out += "triangle_solves_total{case=\"";
+            out += to_string(static_cast<SolveCase>(i));
+            out += "\"} ";
+            AppendNumber(out, snapshot.cases[i]);
+            out += '\n';
+        }
+
+        out += "# HELP triangle_results_total Triangles solved, by result code.\n";
+        out += "# TYPE triangle_results_total counter\n";
+        for (std::size_t i = 0; i < CodeCount; ++i)
+        {
+            out += "triangle_results_total{code=\"";
+            out += to_string(Codes[i]);
+            out += "\"} ";
+            AppendNumber(out, snapshot.codes[i]);
+            out += '\n';
+        }
+
+        // Prometheus buckets are cumulative with inclusive bounds, ours hold integer nanoseconds below
+        // 2^i, so "le" is 2^i - 1 ns
+        out += "# HELP triangle_solve_duration_seconds Time to solve one triangle, by solver case.\n";
+        out += "# TYPE triangle_solve_duration_seconds histogram\n";
+        for (std::size_t i = 0; i < CaseCount; ++i)
+        {
+            const Histogram& histogram = snapshot.latency[i];
+            const std::string_view name = to_string(static_cast<SolveCase>(i));
+            std::uint64_t cumulative = 0;
+            for (std::size_t bucket = 0; bucket < LatencyBuckets; ++bucket)
+            {
+                cumulative += histogram.buckets[bucket];
+                out += "triangle_solve_duration_seconds_bucket{case=\"";
+                out += name;
+                out += "\",le=\"";
+                if (Histogram::upperBound(bucket) == 0)
+                {
+                    out += "+Inf";
+                }
+                else
+                {
+                    AppendSeconds(out, Histogram::upperBound(bucket) - 1);
+                }
+                out += "\"} ";
+                AppendNumber(out, cumulative);
+                out += '\n';
+            }
+            out += "triangle_solve_duration_seconds_sum{case=\"";
+            out += name;
+            out += "\"} ";
+            AppendSeconds(out, histogram.totalNanoseconds);
+            out += "\ntriangle_solve_duration_seconds_count{case=\"";
+            out += name;
+            out += "\"} ";
+            AppendNumber(out, histogram.count);
+            out += '\n';
+        }
+        return out;
+    }
+} // namespace TriangleCalculatorLib
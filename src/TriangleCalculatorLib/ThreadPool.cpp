@@ -0,0 +1,207 @@
+#include <TriangleCalculatorLib/ThreadPool.hpp>
+
+#include <algorithm>
+
+namespace TriangleCalculatorLib
+{
+    namespace
+    {
+        struct ParallelForJob
+        {
+            const std::function<void(std::size_t, std::size_t)>* body;
+            std::atomic<std::size_t> remaining;
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+
+        void RunParallelForChunk(void* context, std::size_t begin, std::size_t end)
+        {
+            auto* job = static_cast<ParallelForJob*>(context);
+            (*job->body)(begin, end);
+            // count down under the lock: the job lives on the caller's stack, the caller can only see
+            // the last chunk finish once this lock is released, which is the last access to the job
+            std::lock_guard<std::mutex> lock(job->mutex);
+            if (job->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                job->finished.notify_all();
+            }
+        }
+
+        void RunSubmittedTask(void* context, std::size_t, std::size_t)
+        {
+            std::unique_ptr<std::function<void()>> task(static_cast<std::function<void()>*>(context));
+            (*task)();
+        }
+    } // namespace
+
+    ThreadPool::ThreadPool(std::size_t threadCount)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        queues_.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+        {
+            queues_.push_back(std::make_unique<WorkerQueue>());
+        }
+
+        workers_.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+        {
+            workers_.emplace_back([this, i] { WorkerLoop(i); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stopping_ = true;
+        }
+        sleepCondition_.notify_all();
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::parallelFor(std::size_t count, std::size_t chunkSize,
+                                 const std::function<void(std::size_t, std::size_t)>& body)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        chunkSize = std::max<std::size_t>(1, chunkSize);
+        const std::size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+        if (chunkCount == 1)
+        {
+            body(0, count);
+            return;
+        }
+
+        ParallelForJob job{&body, {chunkCount}, {}, {}};
+
+        // deal contiguous runs of chunks to each worker so neighbouring rows stay on the same core,
+        // idle workers rebalance by stealing from the end of the others' runs
+        const std::size_t workerCount = queues_.size();
+        for (std::size_t worker = 0; worker < workerCount; ++worker)
+        {
+            const std::size_t firstChunk = chunkCount * worker / workerCount;
+            const std::size_t lastChunk = chunkCount * (worker + 1) / workerCount;
+            for (std::size_t chunk = firstChunk; chunk < lastChunk; ++chunk)
+            {
+                const std::size_t begin = chunk * chunkSize;
+                Push(worker, Task{&RunParallelForChunk, &job, begin, std::min(count, begin + chunkSize)});
+            }
+        }
+        WakeWorkers(chunkCount);
+
+        // help out until nothing is left to steal, then wait for the chunks still running
+        while (job.remaining.load(std::memory_order_acquire) != 0 && TryRunOne(0))
+        {
+        }
+        std::unique_lock<std::mutex> lock(job.mutex);
+        job.finished.wait(lock, [&job] { return job.remaining.load(std::memory_order_acquire) == 0; });
+    }
+
+    void ThreadPool::submit(std::function<void()> task)
+    {
+        auto* context = new std::function<void()>(std::move(task));
+        const std::size_t queue = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        Push(queue, Task{&RunSubmittedTask, context, 0, 0});
+        WakeWorkers(1);
+    }
+
+    void ThreadPool::Push(std::size_t queue, const Task& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(queues_[queue]->mutex);
+            queues_[queue]->tasks.push_back(task);
+        }
+        queuedTasks_.fetch_add(1, std::memory_order_release);
+    }
+
+    void ThreadPool::WakeWorkers(std::size_t taskCount)
+    {
+        // taking the lock orders the wake-up after any worker that is about to wait has checked the counter
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+        }
+        if (taskCount == 1)
+        {
+            sleepCondition_.notify_one();
+        }
+        else
+        {
+            sleepCondition_.notify_all();
+        }
+    }
+
+    bool ThreadPool::TryPopOwn(std::size_t index, Task& task)
+    {
+        WorkerQueue& queue = *queues_[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            return false;
+        }
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        queuedTasks_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool ThreadPool::TrySteal(std::size_t thief, Task& task)
+    {
+        const std::size_t queueCount = queues_.size();
+        for (std::size_t offset = 1; offset <= queueCount; ++offset)
+        {
+            WorkerQueue& queue = *queues_[(thief + offset) % queueCount];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+                queuedTasks_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ThreadPool::TryRunOne(std::size_t preferredQueue)
+    {
+        Task task;
+        if (!TrySteal(preferredQueue, task))
+        {
+            return false;
+        }
+        task.run(task.context, task.begin, task.end);
+        return true;
+    }
+
+    void ThreadPool::WorkerLoop(std::size_t index)
+    {
+        while (true)
+        {
+            Task task;
+            if (TryPopOwn(index, task) || TrySteal(index, task))
+            {
+                task.run(task.context, task.begin, task.end);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            sleepCondition_.wait(lock, [this] {
+                return stopping_ || queuedTasks_.load(std::memory_order_acquire) > 0;
+            });
+            if (stopping_ && queuedTasks_.load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+        }
+    }
+} // namespace TriangleCalculatorLib
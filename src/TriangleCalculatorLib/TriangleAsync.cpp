@@ -0,0 +1,237 @@
+#include <TriangleCalculatorLib/TriangleAsync.hpp>
+
+#include <TriangleCalculatorLib/ThreadPool.hpp>
+
+#include <logging/logging.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace TriangleCalculatorLib
+{
+    namespace
+    {
+        enum class ChunkState : std::uint8_t
+        {
+            Queued,
+            Solved,
+            Skipped
+        };
+
+        // what a suspended coroutine waits for: one chunk, or every chunk
+        constexpr std::size_t AllChunks = std::numeric_limits<std::size_t>::max();
+    } // namespace
+
+    struct SolveOperation::State
+    {
+        TriangleColumns columns;
+        AsyncSolveOptions options;
+        std::stop_source cancellation; // cancel() and the destructor, options.stopToken is the caller's
+        std::size_t chunkSize = 0;
+        std::size_t chunkCount = 0;
+        ResultCode code = ResultCode::Success;
+
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::vector<ChunkState> chunks;
+        std::size_t done = 0;    // chunks solved or skipped
+        std::size_t running = 0; // chunks writing to the columns
+        std::size_t solvedRows = 0;
+        bool cancelled = false;
+        std::coroutine_handle<> waiter;
+        std::size_t waitingFor = AllChunks;
+
+        bool stopRequested() const noexcept
+        {
+            return cancellation.stop_requested() || options.stopToken.stop_requested();
+        }
+
+        bool complete() const noexcept { return done == chunkCount; }
+
+        // whether what a waiter waits for is there (under the mutex)
+        bool ready(std::size_t chunk) const noexcept
+        {
+            return chunk == AllChunks ? complete() : chunk >= chunkCount || chunks[chunk] != ChunkState::Queued;
+        }
+
+        // runs on the pool
+        void solve(std::size_t chunk) noexcept
+        {
+            const std::size_t begin = chunk * chunkSize;
+            const std::size_t count = std::min(chunkSize, columns.size() - begin);
+            bool skip = false;
+            {
+                // a stop seen here is ordered with the destructor: either it waits for this chunk or the chunk skips
+                std::lock_guard<std::mutex> lock(mutex);
+                skip = stopRequested();
+                running += skip ? 0 : 1;
+            }
+            if (!skip)
+            {
+                TriangleCalculator::finalizeTriangles(columns.subspan(begin, count), options.unit, options.precision,
+                                                      options.ambiguousCaseSolution);
+            }
+
+            std::coroutine_handle<> resume;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                chunks[chunk] = skip ? ChunkState::Skipped : ChunkState::Solved;
+                ++done;
+                running -= skip ? 0 : 1;
+                cancelled |= skip;
+                solvedRows += skip ? 0 : count;
+                if (waiter && ready(waitingFor))
+                {
+                    resume = std::exchange(waiter, {});
+                }
+                finished.notify_all();
+            }
+            // outside the lock, the coroutine may await the next chunk right away
+            if (resume)
+            {
+                resume.resume();
+            }
+        }
+
+        bool suspend(std::coroutine_handle<> handle, std::size_t chunk)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (ready(chunk))
+            {
+                return false;
+            }
+            waiter = handle;
+            waitingFor = chunk;
+            return true;
+        }
+    };
+
+    SolveOperation::SolveOperation(std::shared_ptr<State> state) noexcept : state_(std::move(state)) {}
+
+    SolveOperation::SolveOperation(SolveOperation&& other) noexcept
+        : state_(std::move(other.state_)), nextChunk_(std::exchange(other.nextChunk_, 0))
+    {
+    }
+
+    SolveOperation& SolveOperation::operator=(SolveOperation&& other) noexcept
+    {
+        if (this != &other)
+        {
+            wait();
+            state_ = std::move(other.state_);
+            nextChunk_ = std::exchange(other.nextChunk_, 0);
+        }
+        return *this;
+    }
+
+    SolveOperation::~SolveOperation()
+    {
+        wait();
+    }
+
+    void SolveOperation::wait() noexcept
+    {
+        if (!state_)
+        {
+            return;
+        }
+        // chunks still queued skip without touching the columns, only the running ones are waited for:
+        // the last owner may be a coroutine resumed on the pool, waiting for queued chunks could wait for itself
+        cancel();
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        state_->finished.wait(lock, [this] { return state_->running == 0; });
+    }
+
+    void SolveOperation::cancel() noexcept
+    {
+        if (state_)
+        {
+            state_->cancellation.request_stop();
+        }
+    }
+
+    SolveOperation::ChunkAwaiter SolveOperation::nextChunk() noexcept
+    {
+        return ChunkAwaiter(*this);
+    }
+
+    bool SolveOperation::await_ready() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->complete();
+    }
+
+    bool SolveOperation::await_suspend(std::coroutine_handle<> waiter)
+    {
+        return state_->suspend(waiter, AllChunks);
+    }
+
+    AsyncSolveResult SolveOperation::await_resume() const
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return AsyncSolveResult{state_->code, state_->solvedRows, state_->cancelled};
+    }
+
+    bool SolveOperation::ChunkAwaiter::await_ready() const noexcept
+    {
+        State& state = *operation_.state_;
+        std::lock_guard<std::mutex> lock(state.mutex);
+        return state.ready(operation_.nextChunk_);
+    }
+
+    bool SolveOperation::ChunkAwaiter::await_suspend(std::coroutine_handle<> waiter)
+    {
+        return operation_.state_->suspend(waiter, operation_.nextChunk_);
+    }
+
+    std::optional<SolvedChunk> SolveOperation::ChunkAwaiter::await_resume()
+    {
+        State& state = *operation_.state_;
+        std::lock_guard<std::mutex> lock(state.mutex);
+        const std::size_t chunk = operation_.nextChunk_;
+        if (chunk >= state.chunkCount || state.chunks[chunk] != ChunkState::Solved)
+        {
+            // the end, or a gap where the rows in order stop
+            operation_.nextChunk_ = state.chunkCount;
+            return std::nullopt;
+        }
+        ++operation_.nextChunk_;
+        const std::size_t begin = chunk * state.chunkSize;
+        const std::size_t count = std::min(state.chunkSize, state.columns.size() - begin);
+        return SolvedChunk{begin, begin + count, state.columns.subspan(begin, count)};
+    }
+
+    SolveOperation TriangleAsync::solve(TriangleColumns columns, const AsyncSolveOptions& options)
+    {
+        auto state = std::make_shared<SolveOperation::State>();
+        state->columns = columns;
+        state->options = options;
+        if (!columns.hasConsistentSizes())
+        {
+            LOGIFACE_LOG(error, "Triangle batch columns have mismatching lengths");
+            state->code = ResultCode::InvalidData;
+            return SolveOperation(std::move(state));
+        }
+
+        state->chunkSize = std::max<std::size_t>(1, options.chunkSize);
+        state->chunkCount = (columns.size() + state->chunkSize - 1) / state->chunkSize;
+        state->chunks.assign(state->chunkCount, ChunkState::Queued);
+        ThreadPool& pool = options.pool != nullptr ? *options.pool : defaultPool();
+        for (std::size_t chunk = 0; chunk < state->chunkCount; ++chunk)
+        {
+            pool.submit([state, chunk] { state->solve(chunk); });
+        }
+        return SolveOperation(std::move(state));
+    }
+
+    ThreadPool& TriangleAsync::defaultPool()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+} // namespace TriangleCalculatorLib
@@ -0,0 +1,663 @@
+#include "TriangleBatchSolver.hpp"
+
+#include "TriangleCalculatorBackend.hpp"
+#include "TriangleKernels.hpp"
+
+#include <TriangleCalculatorLib/FastMath.hpp>
+#include <TriangleCalculatorLib/ReturnCode.hpp>
+#include <TriangleCalculatorLib/SolverStats.hpp>
+#include <logging/logging.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+
+namespace TriangleCalculatorLib
+{
+    namespace
+    {
+        // the cases of TriangleCalculatorBackend::solve, each with its own kernel
+        enum class BatchCase : std::uint8_t
+        {
+            Insufficient, // fewer than 3 values or no side known
+            Complete,     // nothing left to solve
+            SSS,          // 3 sides, no angle
+            SAS,          // 2 sides and the included angle
+            SSA,          // 2 sides and a non-included angle
+            AAS,          // 2 or 3 angles and 1 or 2 sides (covers ASA)
+            Generic,      // everything else (e.g. SSS with some angles, non-positive sides), solved row by row
+            Count
+        };
+
+        // SSA: the second known side is c in canonical rotation (b otherwise)
+        constexpr std::uint8_t SSASolvesFromC = 1u << 0;
+        // SSA: side a comes before the other known side in ABC order, the backend solves the last side from it
+        constexpr std::uint8_t SSAReferenceIsA = 1u << 1;
+
+        struct CaseInfo
+        {
+            BatchCase kind = BatchCase::Generic;
+            std::uint8_t rotation = 0; // field rotated into position A by the kernel
+            std::uint8_t flags = 0;
+        };
+
+        constexpr bool SideKnown(std::uint8_t mask, int index) { return (mask >> index) & 1u; }
+        constexpr bool AngleKnown(std::uint8_t mask, int index) { return (mask >> (3 + index)) & 1u; }
+
+        // same decision tree as TriangleCalculatorBackend::solve, evaluated once per mask at compile time
+        constexpr CaseInfo Classify(std::uint8_t mask)
+        {
+            int sides = 0;
+            int angles = 0;
+            for (int i = 0; i < 3; ++i)
+            {
+                sides += SideKnown(mask, i);
+                angles += AngleKnown(mask, i);
+            }
+
+            if (sides + angles < 3 || sides == 0)
+            {
+                return {BatchCase::Insufficient, 0, 0};
+            }
+            if (sides == 3)
+            {
+                if (angles == 3) { return {BatchCase::Complete, 0, 0}; }
+                if (angles == 0) { return {BatchCase::SSS, 0, 0}; }
+                return {BatchCase::Generic, 0, 0};
+            }
+            if (sides == 2 && angles == 1)
+            {
+                int angle = 0;
+                while (!AngleKnown(mask, angle)) { ++angle; }
+                if (!SideKnown(mask, angle))
+                {
+                    return {BatchCase::SAS, static_cast<std::uint8_t>(angle), 0};
+                }
+                const int other = SideKnown(mask, (angle + 1) % 3) ? (angle + 1) % 3 : (angle + 2) % 3;
+                std::uint8_t flags = 0;
+                if (other == (angle + 2) % 3) { flags |= SSASolvesFromC; }
+                if (angle < other) { flags |= SSAReferenceIsA; }
+                return {BatchCase::SSA, static_cast<std::uint8_t>(angle), flags};
+            }
+
+            int firstSide = 0;
+            while (!SideKnown(mask, firstSide)) { ++firstSide; }
+            return {BatchCase::AAS, static_cast<std::uint8_t>(firstSide), 0};
+        }
+
+        constexpr auto CaseTable = [] {
+            std::array<CaseInfo, 64> table{};
+            for (std::size_t mask = 0; mask < table.size(); ++mask)
+            {
+                table[mask] = Classify(static_cast<std::uint8_t>(mask));
+            }
+            return table;
+        }();
+
+        // rows are handled in blocks small enough that all scratch space lives on the stack and in L1/L2
+        constexpr std::size_t BlockSize = 256;
+        // lanes of the widest vector the kernels are built for (AVX-512), 8 doubles or 16 floats
+        template <typename T>
+        constexpr std::size_t LaneCount = 64 / sizeof(T);
+        static_assert(BlockSize % LaneCount<float> == 0);
+
+        struct Bucket
+        {
+            std::size_t count = 0;
+            std::array<std::uint16_t, BlockSize> rows; // block-relative row indices, filled up to count
+        };
+
+        // canonical (rotated) copy of the rows of one bucket, angles in radians
+        struct Scratch
+        {
+            using value_type = double;
+
+            alignas(64) std::array<std::array<double, BlockSize>, 3> side;
+            alignas(64) std::array<std::array<double, BlockSize>, 3> angle;
+            std::array<bool, BlockSize> solved;
+        };
+
+        // the float copy of a bucket for Precision::Mixed, with the condition estimate of every row
+        struct FloatScratch
+        {
+            using value_type = float;
+
+            alignas(64) std::array<std::array<float, BlockSize>, 3> side;
+            alignas(64) std::array<std::array<float, BlockSize>, 3> angle;
+            alignas(64) std::array<float, BlockSize> condition;
+        };
+
+        // Precision::Mixed keeps a float result when its condition estimate (in float roundings, see
+        // TriangleKernelsImpl.hpp) stays below this. The estimates overshoot the measured errors, which stay
+        // under 0.8 estimated roundings, so kept results are within 128 * 0.8 * 2^-24 ~ 6e-6 < MIXED_PRECISION_TOLERANCE
+        constexpr float MixedConditionLimit = 128.0f;
+        static_assert(MixedConditionLimit * 0.8 * 0x1p-24 < MIXED_PRECISION_TOLERANCE);
+
+        // The condition estimates assume every float value is normal. The kernels square and multiply sides,
+        // so Precision::Mixed keeps a row in float only while its known values are within 2^-60 .. 2^60
+        // (their squares and products stay far from the float limits) and its solved values are finite
+        constexpr double FloatMagnitudeMin = 0x1p-60;
+        constexpr double FloatMagnitudeMax = 0x1p60;
+
+        bool FitsFloat(double value)
+        {
+            const double magnitude = std::abs(value);
+            return magnitude >= FloatMagnitudeMin && magnitude <= FloatMagnitudeMax;
+        }
+
+        struct ColumnPointers
+        {
+            std::array<double*, 3> side;
+            std::array<double*, 3> angle;
+            std::uint8_t* known;
+            ResultCode* codes;
+        };
+
+        // rows the kernels can take: every known value finite and every known side clearly positive,
+        // anything else keeps the exact semantics of the scalar backend
+        bool IsClean(const ColumnPointers& columns, std::size_t row, std::uint8_t mask)
+        {
+            constexpr double infinity = std::numeric_limits<double>::infinity();
+            bool clean = true;
+            for (int i = 0; i < 3; ++i)
+            {
+                const double side = columns.side[i][row];
+                const double angle = columns.angle[i][row];
+                clean &= !SideKnown(mask, i) || (side > ABSOLUTE_TOLERANCE && side < infinity);
+                clean &= !AngleKnown(mask, i) || std::abs(angle) < infinity;
+            }
+            return clean;
+        }
+
+        // copy the rows of a bucket into canonical rotation, angles in radians. With completeAngles (ASA/AAS)
+        // a missing angle is pi minus the others (SimpleSolveAngles), computed in double before the copy
+        // is narrowed to the scalar of the scratch space
+        template <typename ScratchType>
+        void Gather(const ColumnPointers& columns, std::size_t blockBegin, const Bucket& bucket,
+                    ScratchType& scratch, double toRadians, bool completeAngles = false)
+        {
+            for (std::size_t slot = 0; slot < bucket.count; ++slot)
+            {
+                const std::size_t row = blockBegin + bucket.rows[slot];
+                const std::uint8_t mask = columns.known[row];
+                const int rotation = CaseTable[mask & KnownField::All].rotation;
+                std::array<double, 3> angle;
+                for (int m = 0; m < 3; ++m)
+                {
+                    scratch.side[m][slot] = static_cast<typename ScratchType::value_type>(columns.side[(m + rotation) % 3][row]);
+                    angle[m] = columns.angle[(m + rotation) % 3][row] * toRadians;
+                }
+                for (int m = 0; m < 3; ++m)
+                {
+                    if (completeAngles && !AngleKnown(mask, (m + rotation) % 3))
+                    {
+                        angle[m] = M_PI - (angle[(m + 1) % 3] + angle[(m + 2) % 3]);
+                    }
+                    scratch.angle[m][slot] = static_cast<typename ScratchType::value_type>(angle[m]);
+                }
+            }
+        }
+
+        // fill the slots up to the next full vector with copies of the first row and return the padded count,
+        // so every row goes through the vector body of the kernel and the result of a row does not depend
+        // on where it ends up in its bucket (keeps split and unsplit batches bitwise identical)
+        template <typename ScratchType>
+        std::size_t PadLanes(const Bucket& bucket, ScratchType& scratch)
+        {
+            constexpr std::size_t lanes = LaneCount<typename ScratchType::value_type>;
+            const std::size_t padded = (bucket.count + lanes - 1) / lanes * lanes;
+            for (std::size_t slot = bucket.count; slot < padded; ++slot)
+            {
+                for (int m = 0; m < 3; ++m)
+                {
+                    scratch.side[m][slot] = scratch.side[m][0];
+                    scratch.angle[m][slot] = scratch.angle[m][0];
+                }
+            }
+            return padded;
+        }
+
+        // write back only the fields of a row that were unknown, known inputs are left untouched
+        template <typename ScratchType>
+        void ScatterRow(const ColumnPointers& columns, std::size_t row, const ScratchType& scratch, std::size_t slot,
+                        double fromRadians)
+        {
+            const std::uint8_t mask = columns.known[row];
+            const int rotation = CaseTable[mask & KnownField::All].rotation;
+            for (int m = 0; m < 3; ++m)
+            {
+                const int field = (m + rotation) % 3;
+                if (!SideKnown(mask, field)) { columns.side[field][row] = scratch.side[m][slot]; }
+                if (!AngleKnown(mask, field)) { columns.angle[field][row] = static_cast<double>(scratch.angle[m][slot]) * fromRadians; }
+            }
+            columns.known[row] = KnownField::All;
+        }
+
+        void Scatter(const ColumnPointers& columns, std::size_t blockBegin, const Bucket& bucket,
+                     const Scratch& scratch, double fromRadians, bool checkSolved)
+        {
+            for (std::size_t slot = 0; slot < bucket.count; ++slot)
+            {
+                const std::size_t row = blockBegin + bucket.rows[slot];
+                columns.codes[row] = ResultCode::Success;
+                if (!checkSolved || scratch.solved[slot])
+                {
+                    ScatterRow(columns, row, scratch, slot, fromRadians);
+                }
+            }
+        }
+
+        enum class RowOutcome
+        {
+            Solved,
+            NoSolution,
+            IllConditioned // float could decide or solve the row differently than double, solve it in double
+        };
+
+        // mirrors ResolveSSA followed by SimpleSolveAngles and SolveSides, on one canonical row with angle A known,
+        // computed in T; the float row is checked before anything is logged or written
+        template <typename Math, typename T>
+        RowOutcome SolveSSARow(Scratch& scratch, std::size_t slot, std::uint8_t flags, AmbiguousCaseSolution ambiguousCaseSolution)
+        {
+            constexpr T pi = std::numbers::pi_v<T>;
+            const bool fromC = flags & SSASolvesFromC;
+            const T a = static_cast<T>(scratch.side[0][slot]);
+            const T A = static_cast<T>(scratch.angle[0][slot]);
+            const T S = static_cast<T>(fromC ? scratch.side[2][slot] : scratch.side[1][slot]);
+            const T sinA = Math::sin(A);
+            const T h = S * sinA;
+
+            if constexpr (std::is_same_v<T, float>)
+            {
+                const double sourceS = fromC ? scratch.side[2][slot] : scratch.side[1][slot];
+                if (!FitsFloat(scratch.side[0][slot]) || !FitsFloat(scratch.angle[0][slot]) || !FitsFloat(sourceS))
+                {
+                    return RowOutcome::IllConditioned;
+                }
+                // the tolerance decisions below have to come out as in double, keep clear of a = h and a = S
+                constexpr T margin = 1e-4f;
+                if (IsEqual(a, h, margin) || IsEqual(a, S, margin))
+                {
+                    return RowOutcome::IllConditioned;
+                }
+            }
+
+            const bool noSolution = IsLess(a, h) && !IsEqual(a, h);
+            const bool rightAngle = IsEqual(a, h);
+            const bool hasTwoSolutions = !rightAngle && IsLess(h, a) && IsLess(a, S);
+
+            const T sinX = std::max(T(-1), std::min(T(1), S * sinA / a));
+            T X = pi / 2; // a == h: the solved angle is a right angle
+            if (!rightAngle)
+            {
+                X = Math::asin(sinX);
+                if (hasTwoSolutions && ambiguousCaseSolution == AmbiguousCaseSolution::SecondSolution)
+                {
+                    X = pi - X;
+                }
+            }
+
+            const T B = fromC ? pi - (X + A) : X;
+            const T C = fromC ? X : pi - (A + X);
+            const bool referenceIsA = flags & SSAReferenceIsA;
+            const T referenceSide = referenceIsA ? a : S;
+            const T referenceAngle = referenceIsA ? A : X;
+            const T unknownAngle = fromC ? B : C;
+            const T sinUnknown = Math::sin(unknownAngle);
+            const T sinReference = Math::sin(referenceAngle);
+            const T unknownSide = referenceSide * sinUnknown / sinReference;
+
+            if constexpr (std::is_same_v<T, float>)
+            {
+                if (!noSolution)
+                {
+                    // errors in roundings as in the kernels: X from the law of sines, the third angle from pi - A - X
+                    const T errorX = (3 + A / sinA) * sinX / std::sqrt(1 - sinX * sinX);
+                    const T errorThird = errorX + 4;
+                    const T errorSide = 3 + errorThird / sinUnknown + (referenceIsA ? A : errorX) / sinReference;
+                    const T condition = std::max(errorThird / std::min({X, B, C}), errorSide);
+                    if (!(condition <= MixedConditionLimit) || !std::isfinite(unknownSide))
+                    {
+                        return RowOutcome::IllConditioned;
+                    }
+                }
+            }
+
+            if (noSolution)
+            {
+                LOGIFACE_LOG(warn, "The provided triangle data results in no valid triangle (side a < h)");
+                return RowOutcome::NoSolution;
+            }
+            if (hasTwoSolutions && ambiguousCaseSolution == AmbiguousCaseSolution::NoSolution)
+            {
+                LOGIFACE_LOG(warn, "The provided triangle data results in an ambiguous SSA case with two possible solutions, either provide more information or specify which solution to use, by default the first solution is used");
+            }
+
+            scratch.angle[1][slot] = B;
+            scratch.angle[2][slot] = C;
+            scratch.side[fromC ? 1 : 2][slot] = unknownSide;
+            return RowOutcome::Solved;
+        }
+
+        // T is the scalar the rows are solved in: float rows that are ill-conditioned are solved again in double
+        template <typename Math, typename T>
+        void SolveSSA(const ColumnPointers& columns, std::size_t blockBegin, const Bucket& bucket, Scratch& scratch,
+                      AmbiguousCaseSolution ambiguousCaseSolution)
+        {
+            for (std::size_t slot = 0; slot < bucket.count; ++slot)
+            {
+                const std::uint8_t flags = CaseTable[columns.known[blockBegin + bucket.rows[slot]] & KnownField::All].flags;
+                RowOutcome outcome = SolveSSARow<Math, T>(scratch, slot, flags, ambiguousCaseSolution);
+                if (outcome == RowOutcome::IllConditioned)
+                {
+                    outcome = SolveSSARow<Math, double>(scratch, slot, flags, ambiguousCaseSolution);
+                }
+                scratch.solved[slot] = outcome == RowOutcome::Solved;
+            }
+        }
+
+        // rows outside the kernel cases go through the scalar backend one at a time
+        void SolveGeneric(const ColumnPointers& columns, std::size_t blockBegin, const Bucket& bucket,
+                          AmbiguousCaseSolution ambiguousCaseSolution, double toRadians, double fromRadians, Precision precision)
+        {
+            for (std::size_t slot = 0; slot < bucket.count; ++slot)
+            {
+                const std::size_t row = blockBegin + bucket.rows[slot];
+                const std::uint8_t mask = columns.known[row];
+                Triangle triangle;
+                const std::array<std::optional<double>*, 6> fields{&triangle.sideA, &triangle.sideB, &triangle.sideC,
+                                                                   &triangle.angleA, &triangle.angleB, &triangle.angleC};
+                for (int i = 0; i < 3; ++i)
+                {
+                    if (SideKnown(mask, i)) { *fields[i] = columns.side[i][row]; }
+                    if (AngleKnown(mask, i)) { *fields[3 + i] = columns.angle[i][row] * toRadians; }
+                }
+
+                columns.codes[row] = TriangleCalculatorBackend::solve(triangle, precision, ambiguousCaseSolution);
+
+                std::uint8_t solvedMask = 0;
+                for (int i = 0; i < 3; ++i)
+                {
+                    if (fields[i]->has_value())
+                    {
+                        columns.side[i][row] = **fields[i];
+                        solvedMask |= static_cast<std::uint8_t>(1u << i);
+                    }
+                    if (fields[3 + i]->has_value())
+                    {
+                        columns.angle[i][row] = **fields[3 + i] * fromRadians;
+                        solvedMask |= static_cast<std::uint8_t>(1u << (3 + i));
+                    }
+                }
+                columns.known[row] = solvedMask;
+            }
+        }
+
+        // gather a bucket, run it through one kernel and scatter the solved fields back
+        template <typename Kernel>
+        void SolveKernelBucket(const ColumnPointers& columns, std::size_t blockBegin, const Bucket& bucket, Scratch& scratch,
+                               double toRadians, double fromRadians, Kernel kernel, bool completeAngles)
+        {
+            Gather(columns, blockBegin, bucket, scratch, toRadians, completeAngles);
+            kernel(scratch.side[0].data(), scratch.side[1].data(), scratch.side[2].data(),
+                   scratch.angle[0].data(), scratch.angle[1].data(), scratch.angle[2].data(), nullptr, PadLanes(bucket, scratch));
+            Scatter(columns, blockBegin, bucket, scratch, fromRadians, false);
+        }
+
+        // whether the float solution of a Mixed row can be kept: its known values fit float and the solved ones are finite
+        bool KeepsFloatSolution(const ColumnPointers& columns, std::size_t row, const FloatScratch& scratch, std::size_t slot,
+                                double toRadians)
+        {
+            const std::uint8_t mask = columns.known[row];
+            bool keep = scratch.condition[slot] <= MixedConditionLimit;
+            for (int i = 0; i < 3; ++i)
+            {
+                keep &= !SideKnown(mask, i) || FitsFloat(columns.side[i][row]);
+                keep &= !AngleKnown(mask, i) || FitsFloat(columns.angle[i][row] * toRadians);
+                keep &= std::isfinite(scratch.side[i][slot]) && std::isfinite(scratch.angle[i][slot]);
+            }
+            return keep;
+        }
+
+        // Precision::Mixed: the bucket goes through the float kernel, the rows over MixedConditionLimit
+        // or outside the range of float go through the double kernel afterwards
+        template <typename FloatKernel, typename Kernel>
+        void SolveKernelBucketMixed(const ColumnPointers& columns, std::size_t blockBegin, const Bucket& bucket,
+                                    Scratch& scratch, FloatScratch& floatScratch, double toRadians, double fromRadians,
+                                    FloatKernel floatKernel, Kernel kernel, bool completeAngles)
+        {
+            Gather(columns, blockBegin, bucket, floatScratch, toRadians, completeAngles);
+            floatKernel(floatScratch.side[0].data(), floatScratch.side[1].data(), floatScratch.side[2].data(),
+                        floatScratch.angle[0].data(), floatScratch.angle[1].data(), floatScratch.angle[2].data(),
+                        floatScratch.condition.data(), PadLanes(bucket, floatScratch));
+
+            Bucket rejected;
+            for (std::size_t slot = 0; slot < bucket.count; ++slot)
+            {
+                const std::size_t row = blockBegin + bucket.rows[slot];
+                if (KeepsFloatSolution(columns, row, floatScratch, slot, toRadians))
+                {
+                    columns.codes[row] = ResultCode::Success;
+                    ScatterRow(columns, row, floatScratch, slot, fromRadians);
+                }
+                else
+                {
+                    rejected.rows[rejected.count++] = bucket.rows[slot];
+                }
+            }
+
+            if (rejected.count > 0)
+            {
+                SolveKernelBucket(columns, blockBegin, rejected, scratch, toRadians, fromRadians, kernel, completeAngles);
+            }
+        }
+
+        // the stats case of each kernel case, Generic rows are counted by the backend they go through
+        constexpr SolveCase ToSolveCase(BatchCase kind)
+        {
+            switch (kind)
+            {
+                case BatchCase::Complete: return SolveCase::Complete;
+                case BatchCase::SSS: return SolveCase::SSS;
+                case BatchCase::SAS: return SolveCase::SAS;
+                case BatchCase::SSA: return SolveCase::SSA;
+                case BatchCase::AAS: return SolveCase::AAS;
+                default: return SolveCase::Insufficient;
+            }
+        }
+
+        // run solve over a non-empty bucket; with the stats on, time it and count its rows by result code
+        template <typename Solve>
+        void SolveBucket(const ColumnPointers& columns, std::size_t blockBegin, const Bucket& bucket, BatchCase kind,
+                         bool recordStats, Solve solve)
+        {
+            if (bucket.count == 0)
+            {
+                return;
+            }
+            if (!recordStats)
+            {
+                solve();
+                return;
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            solve();
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            std::array<std::uint64_t, SolverStats::CodeCount> codes{};
+            for (std::size_t slot = 0; slot < bucket.count; ++slot)
+            {
+                ++codes[static_cast<std::size_t>(columns.codes[blockBegin + bucket.rows[slot]])];
+            }
+            SolverStats::record(ToSolveCase(kind), codes, bucket.count, static_cast<std::uint64_t>(elapsed.count()));
+        }
+
+        void SolveBlock(const ColumnPointers& columns, std::size_t blockBegin, std::size_t blockEnd,
+                        AmbiguousCaseSolution ambiguousCaseSolution, double toRadians, double fromRadians,
+                        Precision precision, const TriangleKernelTable& kernels)
+        {
+            // classify and partition, keeping each row's index for the scatter back
+            std::array<Bucket, static_cast<std::size_t>(BatchCase::Count)> buckets;
+            for (std::size_t row = blockBegin; row < blockEnd; ++row)
+            {
+                const std::uint8_t mask = columns.known[row] & KnownField::All;
+                const BatchCase kind = IsClean(columns, row, mask) ? CaseTable[mask].kind : BatchCase::Generic;
+                Bucket& bucket = buckets[static_cast<std::size_t>(kind)];
+                bucket.rows[bucket.count++] = static_cast<std::uint16_t>(row - blockBegin);
+            }
+
+            auto bucketFor = [&buckets](BatchCase kind) -> const Bucket& { return buckets[static_cast<std::size_t>(kind)]; };
+            const bool recordStats = SolverStats::enabled();
+
+            const Bucket& insufficient = bucketFor(BatchCase::Insufficient);
+            SolveBucket(columns, blockBegin, insufficient, BatchCase::Insufficient, recordStats, [&] {
+                for (std::size_t slot = 0; slot < insufficient.count; ++slot)
+                {
+                    columns.codes[blockBegin + insufficient.rows[slot]] = ResultCode::InsufficientData;
+                }
+            });
+            if (insufficient.count > 0)
+            {
+                LOGIFACE_LOG(warn, "Not enough information to finalize some triangles of the batch");
+            }
+
+            const Bucket& complete = bucketFor(BatchCase::Complete);
+            SolveBucket(columns, blockBegin, complete, BatchCase::Complete, recordStats, [&] {
+                for (std::size_t slot = 0; slot < complete.count; ++slot)
+                {
+                    columns.codes[blockBegin + complete.rows[slot]] = ResultCode::Success;
+                }
+            });
+
+            Scratch scratch;
+
+            if (precision == Precision::Mixed)
+            {
+                const TriangleFloatKernelTable& floatKernels = ActiveFloatKernels();
+                FloatScratch floatScratch;
+                const Bucket& sss = bucketFor(BatchCase::SSS);
+                SolveBucket(columns, blockBegin, sss, BatchCase::SSS, recordStats, [&] {
+                    SolveKernelBucketMixed(columns, blockBegin, sss, scratch, floatScratch, toRadians, fromRadians,
+                                           floatKernels.solveSSS, kernels.solveSSS, false);
+                });
+                const Bucket& sas = bucketFor(BatchCase::SAS);
+                SolveBucket(columns, blockBegin, sas, BatchCase::SAS, recordStats, [&] {
+                    SolveKernelBucketMixed(columns, blockBegin, sas, scratch, floatScratch, toRadians, fromRadians,
+                                           floatKernels.solveSAS, kernels.solveSAS, false);
+                });
+                const Bucket& aas = bucketFor(BatchCase::AAS);
+                SolveBucket(columns, blockBegin, aas, BatchCase::AAS, recordStats, [&] {
+                    SolveKernelBucketMixed(columns, blockBegin, aas, scratch, floatScratch, toRadians, fromRadians,
+                                           floatKernels.solveAAS, kernels.solveAAS, true);
+                });
+            }
+            else
+            {
+                const Bucket& sss = bucketFor(BatchCase::SSS);
+                SolveBucket(columns, blockBegin, sss, BatchCase::SSS, recordStats, [&] {
+                    SolveKernelBucket(columns, blockBegin, sss, scratch, toRadians, fromRadians, kernels.solveSSS, false);
+                });
+                const Bucket& sas = bucketFor(BatchCase::SAS);
+                SolveBucket(columns, blockBegin, sas, BatchCase::SAS, recordStats, [&] {
+                    SolveKernelBucket(columns, blockBegin, sas, scratch, toRadians, fromRadians, kernels.solveSAS, false);
+                });
+                const Bucket& aas = bucketFor(BatchCase::AAS);
+                SolveBucket(columns, blockBegin, aas, BatchCase::AAS, recordStats, [&] {
+                    SolveKernelBucket(columns, blockBegin, aas, scratch, toRadians, fromRadians, kernels.solveAAS, true);
+                });
+            }
+
+            const Bucket& ssa = bucketFor(BatchCase::SSA);
+            SolveBucket(columns, blockBegin, ssa, BatchCase::SSA, recordStats, [&] {
+                Gather(columns, blockBegin, ssa, scratch, toRadians);
+                if (precision == Precision::Fast)
+                {
+                    SolveSSA<FastMath, double>(columns, blockBegin, ssa, scratch, ambiguousCaseSolution);
+                }
+                else if (precision == Precision::Mixed)
+                {
+                    SolveSSA<StdMath, float>(columns, blockBegin, ssa, scratch, ambiguousCaseSolution);
+                }
+                else
+                {
+                    SolveSSA<StdMath, double>(columns, blockBegin, ssa, scratch, ambiguousCaseSolution);
+                }
+                Scatter(columns, blockBegin, ssa, scratch, fromRadians, true);
+            });
+
+            SolveGeneric(columns, blockBegin, bucketFor(BatchCase::Generic), ambiguousCaseSolution, toRadians, fromRadians, precision);
+        }
+    } // namespace
+
+    void SolveBatch(const TriangleColumns& columns, AmbiguousCaseSolution ambiguousCaseSolution,
+                    double toRadians, double fromRadians, Precision precision)
+    {
+        const ColumnPointers pointers{
+            {columns.sideA.data(), columns.sideB.data(), columns.sideC.data()},
+            {columns.angleA.data(), columns.angleB.data(), columns.angleC.data()},
+            columns.known.data(),
+            columns.codes.data()};
+        const TriangleKernelTable& kernels = ActiveKernels(precision);
+
+        const std::size_t count = columns.size();
+        for (std::size_t blockBegin = 0; blockBegin < count; blockBegin += BlockSize)
+        {
+            const std::size_t blockEnd = std::min(count, blockBegin + BlockSize);
+            SolveBlock(pointers, blockBegin, blockEnd, ambiguousCaseSolution, toRadians, fromRadians, precision, kernels);
+        }
+    }
+
+    void SolveBatch(std::span<CompactTriangle> triangles, std::span<ResultCode> codes,
+                    AmbiguousCaseSolution ambiguousCaseSolution, double toRadians, double fromRadians, Precision precision)
+    {
+        // transpose one block at a time into columns on the stack, the bucket gather reads those
+        struct BlockColumns
+        {
+            std::array<std::array<double, BlockSize>, 3> side;
+            std::array<std::array<double, BlockSize>, 3> angle;
+            std::array<std::uint8_t, BlockSize> known;
+        } block;
+        const TriangleKernelTable& kernels = ActiveKernels(precision);
+
+        const std::size_t count = triangles.size();
+        for (std::size_t blockBegin = 0; blockBegin < count; blockBegin += BlockSize)
+        {
+            const std::size_t rows = std::min(count - blockBegin, BlockSize);
+            for (std::size_t i = 0; i < rows; ++i)
+            {
+                const CompactTriangle& triangle = triangles[blockBegin + i];
+                block.side[0][i] = triangle.sideA;
+                block.side[1][i] = triangle.sideB;
+                block.side[2][i] = triangle.sideC;
+                block.angle[0][i] = triangle.angleA;
+                block.angle[1][i] = triangle.angleB;
+                block.angle[2][i] = triangle.angleC;
+                block.known[i] = triangle.known;
+            }
+
+            const ColumnPointers pointers{
+                {block.side[0].data(), block.side[1].data(), block.side[2].data()},
+                {block.angle[0].data(), block.angle[1].data(), block.angle[2].data()},
+                block.known.data(),
+                codes.data() + blockBegin};
+            SolveBlock(pointers, 0, rows, ambiguousCaseSolution, toRadians, fromRadians, precision, kernels);
+
+            for (std::size_t i = 0; i < rows; ++i)
+            {
+                CompactTriangle& triangle = triangles[blockBegin + i];
+                triangle.sideA = block.side[0][i];
+                triangle.sideB = block.side[1][i];
+                triangle.sideC = block.side[2][i];
+                triangle.angleA = block.angle[0][i];
+                triangle.angleB = block.angle[1][i];
+                triangle.angleC = block.angle[2][i];
+                triangle.known = block.known[i];
+            }
+        }
+    }
+} // namespace TriangleCalculatorLib
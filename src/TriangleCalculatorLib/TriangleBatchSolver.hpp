@@ -0,0 +1,26 @@
+#ifndef TRIANGLE_BATCH_SOLVER_HPP
+#define TRIANGLE_BATCH_SOLVER_HPP
+
+#include <TriangleCalculatorLib/CompactTriangle.hpp>
+#include <TriangleCalculatorLib/ReturnCode.hpp>
+#include <TriangleCalculatorLib/Triangle.hpp>
+#include <TriangleCalculatorLib/TriangleBatch.hpp>
+
+#include <span>
+
+namespace TriangleCalculatorLib
+{
+    // Solve a batch of triangles in place.
+    // Rows are classified up front, grouped per case (keeping their row index for the scatter back)
+    // and every group runs through one straight-line kernel, so mixed batches run at homogeneous speed.
+    // toRadians converts the angle columns to radians, fromRadians converts back.
+    void SolveBatch(const TriangleColumns& columns, AmbiguousCaseSolution ambiguousCaseSolution,
+                    double toRadians, double fromRadians, Precision precision = Precision::Exact);
+
+    // Same for an array of compact triangles, one result code per triangle (codes must be as long as triangles).
+    void SolveBatch(std::span<CompactTriangle> triangles, std::span<ResultCode> codes,
+                    AmbiguousCaseSolution ambiguousCaseSolution, double toRadians, double fromRadians,
+                    Precision precision = Precision::Exact);
+} // namespace TriangleCalculatorLib
+
+#endif // TRIANGLE_BATCH_SOLVER_HPP
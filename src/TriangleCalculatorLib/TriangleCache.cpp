@@ -0,0 +1,245 @@
+#include <TriangleCalculatorLib/TriangleCache.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TriangleCalculatorLib
+{
+    namespace
+    {
+        constexpr std::uint32_t EmptyIndex = ~0u;
+
+        struct Key
+        {
+            std::array<std::uint64_t, 6> values{};
+            std::uint8_t known = 0;
+            std::uint8_t unit = 0;
+            std::uint8_t ambiguousCaseSolution = 0;
+
+            bool operator==(const Key&) const = default;
+        };
+
+        // unknown values are compared as 0, whatever the caller left in them
+        Key MakeKey(const CompactTriangle& input, AngleUnit unit, AmbiguousCaseSolution ambiguousCaseSolution)
+        {
+            Key key;
+            key.known = input.known & KnownField::All;
+            key.unit = static_cast<std::uint8_t>(unit);
+            key.ambiguousCaseSolution = static_cast<std::uint8_t>(ambiguousCaseSolution);
+            const std::array<double, 6> values{input.sideA, input.sideB, input.sideC, input.angleA, input.angleB, input.angleC};
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                key.values[i] = (key.known & (1u << i)) ? std::bit_cast<std::uint64_t>(values[i]) : 0;
+            }
+            return key;
+        }
+
+        // the words are mixed independently so the multiplies can run in parallel, then folded together
+        std::uint64_t Hash(const Key& key)
+        {
+            constexpr std::array<std::uint64_t, 6> Multipliers{0x9E3779B97F4A7C15ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull,
+                                                               0xD6E8FEB86659FD93ull, 0xFF51AFD7ED558CCDull, 0xC4CEB9FE1A85EC53ull};
+            std::uint64_t hash = key.known | (std::uint64_t{key.unit} << 8) | (std::uint64_t{key.ambiguousCaseSolution} << 16);
+            for (std::size_t i = 0; i < key.values.size(); ++i)
+            {
+                hash += (key.values[i] ^ (key.values[i] >> 32)) * Multipliers[i];
+            }
+            hash ^= hash >> 32;
+            hash *= 0x9E3779B97F4A7C15ull;
+            return hash ^ (hash >> 29);
+        }
+    } // namespace
+
+    // A fixed array of entries with a linear probing index over it (twice as many buckets as entries).
+    // CLOCK: every hit sets the entry's referenced bit, the hand clears bits until it finds an entry
+    // without one and evicts that.
+    struct alignas(64) TriangleCache::Shard
+    {
+        struct Entry
+        {
+            Key key;
+            std::uint64_t hash = 0;
+            CompactTriangle solved;
+            ResultCode code = ResultCode::Success;
+            bool referenced = false;
+        };
+
+        void reserve(std::size_t capacity)
+        {
+            entries.resize(capacity);
+            buckets.assign(std::bit_ceil(capacity * 2), EmptyIndex);
+        }
+
+        std::size_t bucketMask() const noexcept { return buckets.size() - 1; }
+
+        // the bucket holding the key, or the empty bucket where it would go
+        std::size_t findBucket(const Key& key, std::uint64_t hash) const noexcept
+        {
+            std::size_t bucket = hash & bucketMask();
+            while (buckets[bucket] != EmptyIndex)
+            {
+                const Entry& entry = entries[buckets[bucket]];
+                if (entry.hash == hash && entry.key == key)
+                {
+                    break;
+                }
+                bucket = (bucket + 1) & bucketMask();
+            }
+            return bucket;
+        }
+
+        // backward shift deletion, keeps every probe sequence free of holes without tombstones
+        void eraseBucket(std::size_t bucket) noexcept
+        {
+            std::size_t hole = bucket;
+            for (std::size_t next = (hole + 1) & bucketMask(); buckets[next] != EmptyIndex; next = (next + 1) & bucketMask())
+            {
+                const std::size_t home = entries[buckets[next]].hash & bucketMask();
+                // move the entry into the hole unless its home lies cyclically in (hole, next]
+                if (((next - home) & bucketMask()) >= ((next - hole) & bucketMask()))
+                {
+                    buckets[hole] = buckets[next];
+                    hole = next;
+                }
+            }
+            buckets[hole] = EmptyIndex;
+        }
+
+        // an entry to (re)use: a free one while there are any, else the CLOCK victim
+        std::uint32_t takeEntry() noexcept
+        {
+            if (used < entries.size())
+            {
+                return static_cast<std::uint32_t>(used++);
+            }
+            while (entries[hand].referenced)
+            {
+                entries[hand].referenced = false;
+                hand = (hand + 1) % entries.size();
+            }
+            const auto victim = static_cast<std::uint32_t>(hand);
+            hand = (hand + 1) % entries.size();
+            eraseBucket(findBucket(entries[victim].key, entries[victim].hash));
+            ++evictions;
+            return victim;
+        }
+
+        mutable std::mutex mutex;
+        std::vector<Entry> entries;
+        std::vector<std::uint32_t> buckets;
+        std::size_t used = 0;
+        std::size_t hand = 0;
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+    };
+
+    TriangleCache::TriangleCache(std::size_t capacity, std::size_t shardCount)
+    {
+        if (shardCount == 0)
+        {
+            shardCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        shardCount_ = std::max<std::size_t>(1, std::min(shardCount, capacity));
+        const std::size_t shardCapacity = std::max<std::size_t>(1, (capacity + shardCount_ - 1) / shardCount_);
+        shards_ = std::make_unique<Shard[]>(shardCount_);
+        for (std::size_t i = 0; i < shardCount_; ++i)
+        {
+            shards_[i].reserve(shardCapacity);
+        }
+    }
+
+    TriangleCache::~TriangleCache() = default;
+
+    TriangleCache::Shard& TriangleCache::shardFor(std::uint64_t hash) const noexcept
+    {
+        // the low bits pick the bucket inside the shard, the high bits the shard
+        return shards_[(hash >> 40) % shardCount_];
+    }
+
+    bool TriangleCache::find(const CompactTriangle& input, AngleUnit unit, AmbiguousCaseSolution ambiguousCaseSolution,
+                             CompactTriangle& solved, ResultCode& code)
+    {
+        const Key key = MakeKey(input, unit, ambiguousCaseSolution);
+        const std::uint64_t hash = Hash(key);
+        Shard& shard = shardFor(hash);
+
+        std::lock_guard lock(shard.mutex);
+        const std::uint32_t index = shard.buckets[shard.findBucket(key, hash)];
+        if (index == EmptyIndex)
+        {
+            ++shard.misses;
+            return false;
+        }
+        Shard::Entry& entry = shard.entries[index];
+        entry.referenced = true;
+        solved = entry.solved;
+        code = entry.code;
+        ++shard.hits;
+        return true;
+    }
+
+    void TriangleCache::insert(const CompactTriangle& input, AngleUnit unit, AmbiguousCaseSolution ambiguousCaseSolution,
+                               const CompactTriangle& solved, ResultCode code)
+    {
+        const Key key = MakeKey(input, unit, ambiguousCaseSolution);
+        const std::uint64_t hash = Hash(key);
+        Shard& shard = shardFor(hash);
+
+        std::lock_guard lock(shard.mutex);
+        std::size_t bucket = shard.findBucket(key, hash);
+        std::uint32_t index = shard.buckets[bucket];
+        if (index == EmptyIndex)
+        {
+            index = shard.takeEntry();
+            // evicting may have shifted the buckets
+            bucket = shard.findBucket(key, hash);
+            shard.buckets[bucket] = index;
+        }
+        Shard::Entry& entry = shard.entries[index];
+        entry.key = key;
+        entry.hash = hash;
+        entry.solved = solved;
+        entry.code = code;
+        entry.referenced = false;
+    }
+
+    void TriangleCache::clear()
+    {
+        for (std::size_t i = 0; i < shardCount_; ++i)
+        {
+            Shard& shard = shards_[i];
+            std::lock_guard lock(shard.mutex);
+            std::fill(shard.buckets.begin(), shard.buckets.end(), EmptyIndex);
+            shard.used = 0;
+            shard.hand = 0;
+            shard.hits = 0;
+            shard.misses = 0;
+            shard.evictions = 0;
+        }
+    }
+
+    TriangleCache::Stats TriangleCache::stats() const
+    {
+        Stats stats;
+        for (std::size_t i = 0; i < shardCount_; ++i)
+        {
+            const Shard& shard = shards_[i];
+            std::lock_guard lock(shard.mutex);
+            stats.hits += shard.hits;
+            stats.misses += shard.misses;
+            stats.evictions += shard.evictions;
+            stats.size += shard.used;
+        }
+        return stats;
+    }
+
+    std::size_t TriangleCache::capacity() const noexcept
+    {
+        return shardCount_ * shards_[0].entries.size();
+    }
+} // namespace TriangleCalculatorLib
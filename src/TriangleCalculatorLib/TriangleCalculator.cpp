@@ -1,67 +1,250 @@
+#include <TriangleCalculatorLib/ThreadPool.hpp>
 #include <TriangleCalculatorLib/Triangle.hpp>
+#include <TriangleCalculatorLib/TriangleCache.hpp>
 #include <TriangleCalculatorLib/TriangleCalculator.hpp>
 
 #include "TriangleCalculatorBackend.hpp"
+#include "TriangleBatchSolver.hpp"
+
+#include <logging/logging.hpp>
 
 #include <cmath>
+#include <numbers>
+#include <utility>
 
 namespace TriangleCalculatorLib
 {
-    double degreesToRadians(double degrees)
+    // scale the known angles in place by multiplier / divisor, the degree API converts on the way in and out
+    template <typename T>
+    void ConvertAngles(BasicTriangle<T>& triangle, T multiplier, T divisor)
     {
-        return degrees * M_PI / 180.0;
+        if (triangle.angleA.has_value())
+        {
+            triangle.angleA = *triangle.angleA * multiplier / divisor;
+        }
+        if (triangle.angleB.has_value())
+        {
+            triangle.angleB = *triangle.angleB * multiplier / divisor;
+        }
+        if (triangle.angleC.has_value())
+        {
+            triangle.angleC = *triangle.angleC * multiplier / divisor;
+        }
     }
 
-    double radiansToDegrees(double radians)
+    template <typename T>
+    void DegreesToRadians(BasicTriangle<T>& triangle)
     {
-        return radians * 180.0 / M_PI;
+        ConvertAngles(triangle, std::numbers::pi_v<T>, T(180));
     }
 
-    Triangle ConvertTriangleToRadians(const Triangle& triangle)
+    template <typename T>
+    void RadiansToDegrees(BasicTriangle<T>& triangle)
     {
-        Triangle radTriangle = triangle;
-        if (radTriangle.angleA.has_value())
-        {
-            radTriangle.angleA = degreesToRadians(*radTriangle.angleA);
-        }
-        if (radTriangle.angleB.has_value())
+        ConvertAngles(triangle, T(180), std::numbers::pi_v<T>);
+    }
+
+    // factors the batch solver applies on gather and scatter
+    constexpr double ToRadiansFactor(AngleUnit unit)
+    {
+        return unit == AngleUnit::Degrees ? M_PI / 180.0 : 1.0;
+    }
+
+    constexpr double FromRadiansFactor(AngleUnit unit)
+    {
+        return unit == AngleUnit::Degrees ? 180.0 / M_PI : 1.0;
+    }
+
+    Result TriangleCalculator::finalizeTriangle(Triangle triangle, AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        return finalizeTriangle(std::move(triangle), AngleUnit::Degrees, ambiguousCaseSolution);
+    }
+
+    Result TriangleCalculator::finalizeTriangle(Triangle triangle, AngleUnit unit, AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        Result result{std::move(triangle), ResultCode::Success};
+        result.code = finalizeTriangleInPlace(result.triangle, unit, ambiguousCaseSolution);
+        return result;
+    }
+
+    ResultCode TriangleCalculator::finalizeTriangleInPlace(Triangle& triangle, AngleUnit unit, AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        return finalizeTriangleInPlace(triangle, unit, Precision::Exact, ambiguousCaseSolution);
+    }
+
+    Result TriangleCalculator::finalizeTriangle(Triangle triangle, AngleUnit unit, Precision precision,
+                                                AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        Result result{std::move(triangle), ResultCode::Success};
+        result.code = finalizeTriangleInPlace(result.triangle, unit, precision, ambiguousCaseSolution);
+        return result;
+    }
+
+    ResultCode TriangleCalculator::finalizeTriangleInPlace(Triangle& triangle, AngleUnit unit, Precision precision,
+                                                           AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        return finalizeTriangleInPlace<double>(triangle, unit, precision, ambiguousCaseSolution);
+    }
+
+    template <typename T>
+    ResultCode TriangleCalculator::finalizeTriangleInPlace(BasicTriangle<T>& triangle, AngleUnit unit, AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        return finalizeTriangleInPlace(triangle, unit, Precision::Exact, ambiguousCaseSolution);
+    }
+
+    template <typename T>
+    ResultCode TriangleCalculator::finalizeTriangleInPlace(BasicTriangle<T>& triangle, AngleUnit unit, Precision precision,
+                                                           AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        if (unit == AngleUnit::Radians)
         {
-            radTriangle.angleB = degreesToRadians(*radTriangle.angleB);
+            return TriangleCalculatorBackend::finalizeTriangle(triangle, precision, ambiguousCaseSolution);
         }
-        if (radTriangle.angleC.has_value())
+
+        DegreesToRadians(triangle);
+        const ResultCode code = TriangleCalculatorBackend::finalizeTriangle(triangle, precision, ambiguousCaseSolution);
+        RadiansToDegrees(triangle);
+        return code;
+    }
+
+    template ResultCode TriangleCalculator::finalizeTriangleInPlace(BasicTriangle<float>&, AngleUnit, AmbiguousCaseSolution);
+    template ResultCode TriangleCalculator::finalizeTriangleInPlace(BasicTriangle<float>&, AngleUnit, Precision, AmbiguousCaseSolution);
+    template ResultCode TriangleCalculator::finalizeTriangleInPlace(BasicTriangle<long double>&, AngleUnit, AmbiguousCaseSolution);
+    template ResultCode TriangleCalculator::finalizeTriangleInPlace(BasicTriangle<long double>&, AngleUnit, Precision, AmbiguousCaseSolution);
+
+    Result TriangleCalculator::finalizeTriangle(Triangle triangle, AngleUnit unit, TriangleCache& cache,
+                                                AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        const CompactTriangle input = CompactTriangle::fromTriangle(triangle);
+        CompactTriangle solved;
+        ResultCode code;
+        if (cache.find(input, unit, ambiguousCaseSolution, solved, code))
         {
-            radTriangle.angleC = degreesToRadians(*radTriangle.angleC);
+            return Result{solved.toTriangle(), code};
         }
-        return radTriangle;
+
+        code = finalizeTriangleInPlace(triangle, unit, ambiguousCaseSolution);
+        cache.insert(input, unit, ambiguousCaseSolution, CompactTriangle::fromTriangle(triangle), code);
+        return Result{std::move(triangle), code};
+    }
+
+    ResultCode TriangleCalculator::finalizeTriangle(CompactTriangle& triangle, AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        return finalizeTriangle(triangle, AngleUnit::Degrees, ambiguousCaseSolution);
+    }
+
+    ResultCode TriangleCalculator::finalizeTriangle(CompactTriangle& triangle, AngleUnit unit, AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        ResultCode code = ResultCode::Success;
+        SolveBatch(std::span<CompactTriangle>(&triangle, 1), std::span<ResultCode>(&code, 1),
+                   ambiguousCaseSolution, ToRadiansFactor(unit), FromRadiansFactor(unit));
+        return code;
+    }
+
+    ResultCode TriangleCalculator::finalizeTriangles(TriangleColumns columns, AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        return finalizeTriangles(columns, AngleUnit::Degrees, ambiguousCaseSolution);
+    }
+
+    ResultCode TriangleCalculator::finalizeTriangles(TriangleColumns columns, AngleUnit unit, AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        return finalizeTriangles(columns, unit, Precision::Exact, ambiguousCaseSolution);
     }
 
-    Triangle ConvertTriangleToDegrees(const Triangle& triangle)
+    ResultCode TriangleCalculator::finalizeTriangles(TriangleColumns columns, AngleUnit unit, Precision precision,
+                                                     AmbiguousCaseSolution ambiguousCaseSolution)
     {
-        Triangle degTriangle = triangle;
-        if (degTriangle.angleA.has_value())
+        if (!columns.hasConsistentSizes())
         {
-            degTriangle.angleA = radiansToDegrees(*degTriangle.angleA);
+            LOGIFACE_LOG(error, "Triangle batch columns have mismatching lengths");
+            return ResultCode::InvalidData;
         }
-        if (degTriangle.angleB.has_value())
+
+        SolveBatch(columns, ambiguousCaseSolution, ToRadiansFactor(unit), FromRadiansFactor(unit), precision);
+        return ResultCode::Success;
+    }
+
+    ResultCode TriangleCalculator::finalizeTriangles(TriangleColumns columns, ThreadPool& pool,
+                                                     AmbiguousCaseSolution ambiguousCaseSolution, std::size_t chunkSize)
+    {
+        return finalizeTriangles(columns, AngleUnit::Degrees, pool, ambiguousCaseSolution, chunkSize);
+    }
+
+    ResultCode TriangleCalculator::finalizeTriangles(TriangleColumns columns, AngleUnit unit, ThreadPool& pool,
+                                                     AmbiguousCaseSolution ambiguousCaseSolution, std::size_t chunkSize)
+    {
+        return finalizeTriangles(columns, unit, Precision::Exact, pool, ambiguousCaseSolution, chunkSize);
+    }
+
+    ResultCode TriangleCalculator::finalizeTriangles(TriangleColumns columns, AngleUnit unit, Precision precision, ThreadPool& pool,
+                                                     AmbiguousCaseSolution ambiguousCaseSolution, std::size_t chunkSize)
+    {
+        if (!columns.hasConsistentSizes())
         {
-            degTriangle.angleB = radiansToDegrees(*degTriangle.angleB);
+            LOGIFACE_LOG(error, "Triangle batch columns have mismatching lengths");
+            return ResultCode::InvalidData;
         }
-        if (degTriangle.angleC.has_value())
+
+        // rows are independent and written in place, so every chunk can be solved on its own
+        pool.parallelFor(columns.size(), chunkSize, [&](std::size_t begin, std::size_t end) {
+            SolveBatch(columns.subspan(begin, end - begin), ambiguousCaseSolution, ToRadiansFactor(unit), FromRadiansFactor(unit),
+                       precision);
+        });
+        return ResultCode::Success;
+    }
+
+    ResultCode TriangleCalculator::finalizeTriangles(std::span<CompactTriangle> triangles, std::span<ResultCode> codes,
+                                                     AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        return finalizeTriangles(triangles, codes, AngleUnit::Degrees, ambiguousCaseSolution);
+    }
+
+    ResultCode TriangleCalculator::finalizeTriangles(std::span<CompactTriangle> triangles, std::span<ResultCode> codes, AngleUnit unit,
+                                                     AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        return finalizeTriangles(triangles, codes, unit, Precision::Exact, ambiguousCaseSolution);
+    }
+
+    ResultCode TriangleCalculator::finalizeTriangles(std::span<CompactTriangle> triangles, std::span<ResultCode> codes, AngleUnit unit,
+                                                     Precision precision, AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        if (triangles.size() != codes.size())
         {
-            degTriangle.angleC = radiansToDegrees(*degTriangle.angleC);
+            LOGIFACE_LOG(error, "Triangle batch and result codes have mismatching lengths");
+            return ResultCode::InvalidData;
         }
-        return degTriangle;
+
+        SolveBatch(triangles, codes, ambiguousCaseSolution, ToRadiansFactor(unit), FromRadiansFactor(unit), precision);
+        return ResultCode::Success;
     }
 
-    Result TriangleCalculator::finalizeTriangle(Triangle triangle, AmbiguousCaseSolution ambiguousCaseSolution)
+    ResultCode TriangleCalculator::finalizeTriangles(std::span<CompactTriangle> triangles, std::span<ResultCode> codes, ThreadPool& pool,
+                                                     AmbiguousCaseSolution ambiguousCaseSolution, std::size_t chunkSize)
     {
-        triangle = ConvertTriangleToRadians(triangle);
-        
-        TriangleCalculatorBackend backend;
-        Result result = backend.finalizeTriangle(triangle, ambiguousCaseSolution);
+        return finalizeTriangles(triangles, codes, AngleUnit::Degrees, pool, ambiguousCaseSolution, chunkSize);
+    }
 
-        result.triangle = ConvertTriangleToDegrees(result.triangle);
-        return result;
+    ResultCode TriangleCalculator::finalizeTriangles(std::span<CompactTriangle> triangles, std::span<ResultCode> codes, AngleUnit unit,
+                                                     ThreadPool& pool, AmbiguousCaseSolution ambiguousCaseSolution, std::size_t chunkSize)
+    {
+        return finalizeTriangles(triangles, codes, unit, Precision::Exact, pool, ambiguousCaseSolution, chunkSize);
+    }
+
+    ResultCode TriangleCalculator::finalizeTriangles(std::span<CompactTriangle> triangles, std::span<ResultCode> codes, AngleUnit unit,
+                                                     Precision precision, ThreadPool& pool,
+                                                     AmbiguousCaseSolution ambiguousCaseSolution, std::size_t chunkSize)
+    {
+        if (triangles.size() != codes.size())
+        {
+            LOGIFACE_LOG(error, "Triangle batch and result codes have mismatching lengths");
+            return ResultCode::InvalidData;
+        }
+
+        pool.parallelFor(triangles.size(), chunkSize, [&](std::size_t begin, std::size_t end) {
+            SolveBatch(triangles.subspan(begin, end - begin), codes.subspan(begin, end - begin),
+                       ambiguousCaseSolution, ToRadiansFactor(unit), FromRadiansFactor(unit), precision);
+        });
+        return ResultCode::Success;
     }
 
     std::pair<double, double> TriangleCalculator::getBaseHeight(Triangle triangle)
@@ -1,58 +1,41 @@
 #include "TriangleCalculatorBackend.hpp"
 
-#include "TrianglePointerView.hpp"
+#include "TriangleView.hpp"
 
+#include <TriangleCalculatorLib/FastMath.hpp>
+#include <TriangleCalculatorLib/SolverStats.hpp>
 #include <TriangleCalculatorLib/Triangle.hpp>
 #include <TriangleCalculatorLib/ReturnCode.hpp>
 #include <logging/logging.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
-#include <iostream>
-#include <limits>
+#include <numbers>
 
 namespace TriangleCalculatorLib
 {
-    // Utility function for floating-point comparison with absolute tolerance
-    // Using absolute tolerance (1e-9) instead of relative to avoid precision issues
-    constexpr double EPSILON = std::numeric_limits<double>::epsilon();
-    constexpr double ABSOLUTE_TOLERANCE = 2e-7;
-    
-    bool IsEqual(double a, double b, double epsilon = ABSOLUTE_TOLERANCE)
+    // the angle at A is unknown, the other two are known
+    template <typename T, int Rotation>
+    void SimpleSolveAngles(TriangleView<Rotation, T> tri)
     {
-        return std::abs(a - b) <= epsilon * std::max({1.0, std::abs(a), std::abs(b)});
-    }
-    
-    bool IsLess(double a, double b, double epsilon = ABSOLUTE_TOLERANCE)
-    {
-        return a < b - epsilon * std::max({1.0, std::abs(a), std::abs(b)});
-    }
-    
-    bool IsLessOrEqual(double a, double b, double epsilon = ABSOLUTE_TOLERANCE)
-    {
-        return a < b + epsilon * std::max({1.0, std::abs(a), std::abs(b)});
-    }
-    
-    bool IsGreater(double a, double b, double epsilon = ABSOLUTE_TOLERANCE)
-    {
-        return a > b + epsilon * std::max({1.0, std::abs(a), std::abs(b)});
+        // Calculate the third angle
+        T angleSum = 0;
+        angleSum += *tri.angleB();
+        angleSum += *tri.angleC();
+        
+        // we use angles in radians here, so the sum of angles in a triangle is pi radians (180 degrees)
+        T thirdAngle = std::numbers::pi_v<T> - angleSum;
+        tri.angleA() = thirdAngle;
     }
 
     // if 2 out of 3 angles are known, we can calculate the third angle
-    void SimpleSolveAngles(TrianglePointerView& tri)
+    template <typename T>
+    void SimpleSolveAngles(BasicTriangle<T>& triangle)
     {
         LOGIFACE_LOG(trace, "2 angles known, calculating the third angle");
-        int unknownAngleIndex = tri.findFirstUnknownAngleIndex();
         // rotate so that the unknown angle is angleA
-        tri.Rotate(unknownAngleIndex);
-        
-        // Calculate the third angle
-        double angleSum = 0.0;
-        angleSum += **tri.angleB;
-        angleSum += **tri.angleC;
-        
-        // we use angles in radians here, so the sum of angles in a triangle is pi radians (180 degrees)
-        double thirdAngle = M_PI - angleSum;
-        *tri.angleA = thirdAngle;
+        WithRotation(triangle, FindFirstUnknownAngleIndex(triangle), [](auto tri) { SimpleSolveAngles(tri); });
     }
 
     // all sides known and 1 angle, we can solve all angles
@@ -68,120 +51,136 @@ namespace TriangleCalculatorLib
     // a / sin(A) = b / sin(B) = c / sin(C)
     // for example:
     // sin(B) = b * sin(A) / a
-    void SolveAnglesWithSides(TrianglePointerView& tri)
+    template <typename Math, typename T, int Rotation>
+    void SolveAnglesWithSides(TriangleView<Rotation, T> tri)
     {
-        LOGIFACE_LOG(trace, "all sides known and 1 angle, solving angles using law of cosines and law of sines");
-        // find the largest side
-        int largestSideIndex = tri.findLargestSideIndex();
-        tri.Rotate(largestSideIndex); // rotate so that largest side is sideA
-        
-        if(!tri.angleA->has_value())
+        // the largest side is sideA
+        const T a = *tri.sideA();
+        const T b = *tri.sideB();
+        const T c = *tri.sideC();
+
+        if(!tri.angleA().has_value())
         {
             // solve angleA using law of cosines
             // this is what we do, but by using fma to reduce floating point errors (less rounding steps)
-            // double a2 = **tri.sideA * **tri.sideA;
-            // double b2 = **tri.sideB * **tri.sideB;
-            // double c2 = **tri.sideC * **tri.sideC;
-            double step = std::fma(**tri.sideB, **tri.sideB, std::fma(**tri.sideC, **tri.sideC, -(**tri.sideA * **tri.sideA)));
-            double cosA = step / (2 * (**tri.sideB) * (**tri.sideC));
-            cosA = std::max(-1.0, std::min(1.0, cosA));
-            *tri.angleA = std::acos(cosA);
+            // T a2 = a * a;
+            // T b2 = b * b;
+            // T c2 = c * c;
+            T step = std::fma(b, b, std::fma(c, c, -(a * a)));
+            T cosA = step / (2 * b * c);
+            cosA = std::max(T(-1), std::min(T(1), cosA));
+            tri.angleA() = Math::acos(cosA);
         }
+        const T angleA = *tri.angleA();
         
-        double aSideAnglePreFactor = std::sin(**tri.angleA) / **tri.sideA;
+        T aSideAnglePreFactor = Math::sin(angleA) / a;
         
-        if(!tri.angleB->has_value())
+        if(!tri.angleB().has_value())
         {
-            if(tri.KnownAngleCount() == 2)
+            if(KnownAngleCount(tri.triangle()) == 2)
             {
                 // if 2 angles are known, we can calculate the third angle
-                *tri.angleB = M_PI - **tri.angleA - **tri.angleC;
+                tri.angleB() = std::numbers::pi_v<T> - angleA - *tri.angleC();
                 return;
             }
 
             // solve angleB using law of sines
-            double sinB = (**tri.sideB) * aSideAnglePreFactor;
-            sinB = std::max(-1.0, std::min(1.0, sinB));
-            *tri.angleB = std::asin(sinB);
+            T sinB = b * aSideAnglePreFactor;
+            sinB = std::max(T(-1), std::min(T(1), sinB));
+            const T angleB = Math::asin(sinB);
+            tri.angleB() = angleB;
 
-            if(!tri.angleC->has_value())
+            if(!tri.angleC().has_value())
             {
                 // now we can calculate angleC
-                *tri.angleC = M_PI - **tri.angleA - **tri.angleB;
+                tri.angleC() = std::numbers::pi_v<T> - angleA - angleB;
             }
         }
-        else if(!tri.angleC->has_value())
+        else if(!tri.angleC().has_value())
         {
-            *tri.angleC = M_PI - **tri.angleA - **tri.angleB;
+            tri.angleC() = std::numbers::pi_v<T> - angleA - *tri.angleB();
         }
     }
 
+    template <typename Math, typename T>
+    void SolveAnglesWithSides(BasicTriangle<T>& triangle)
+    {
+        LOGIFACE_LOG(trace, "all sides known and 1 angle, solving angles using law of cosines and law of sines");
+        // rotate so that largest side is sideA
+        WithRotation(triangle, FindLargestSideIndex(triangle), [](auto tri) { SolveAnglesWithSides<Math>(tri); });
+    }
+
     // all angles are known so we just solve the sides using the law of sines by multiplying with a common factor (one side)
     // sideA / sin(angleA) = sideB / sin(angleB) = sideC / sin(angleC)
-    // we pick the first known side to calculate the common factor
     // sideA * sin(angleB) / sin(angleA) = sideB
-    void SolveSides(TrianglePointerView& tri)
+    template <typename Math, typename T, int Rotation>
+    void SolveSides(TriangleView<Rotation, T> tri)
     {
-        LOGIFACE_LOG(trace, "all angles known, solving sides using law of sines");
-        if (!tri.sideB->has_value() || IsLessOrEqual(**tri.sideB, 0))
+        const T a = *tri.sideA();
+        const T sinA = Math::sin(*tri.angleA());
+        if (!tri.sideB().has_value() || IsLessOrEqual(*tri.sideB(), 0))
         {
-            double temp = **tri.sideA * std::sin(**tri.angleB);
-            *tri.sideB = temp / std::sin(**tri.angleA);
+            T temp = a * Math::sin(*tri.angleB());
+            tri.sideB() = temp / sinA;
         }
 
-        if (!tri.sideC->has_value() || IsLessOrEqual(**tri.sideC, 0))
+        if (!tri.sideC().has_value() || IsLessOrEqual(*tri.sideC(), 0))
         {
-            double temp = **tri.sideA * std::sin(**tri.angleC);
-            *tri.sideC = temp / std::sin(**tri.angleA);
+            T temp = a * Math::sin(*tri.angleC());
+            tri.sideC() = temp / sinA;
         }
     }
-    
 
-    double GetSSAHeight(TrianglePointerView& triView)
+    // we pick the first known side to calculate the common factor
+    template <typename Math, typename T>
+    void SolveSides(BasicTriangle<T>& triangle)
     {
-        // we simply asume its prerotated so that angleA and sidea are known
-        // int aIndex = triView.findFirstKnownAngleIndex();
-        // triView.Rotate(aIndex); // Rotate so that known angle is A
+        LOGIFACE_LOG(trace, "all angles known, solving sides using law of sines");
+        // rotate so that the known side is sideA
+        WithRotation(triangle, FindFirstKnownSideIndex(triangle), [](auto tri) { SolveSides<Math>(tri); });
+    }
+    
 
+    // the known angle is angleA and sidea is known
+    template <typename Math, typename T, int Rotation>
+    T GetSSAHeight(TriangleView<Rotation, T> triView)
+    {
         // now we determine what the "other" side is (c in calculations)
-        double c = 0;
-        if(triView.sideB->has_value() && IsGreater(**triView.sideB, 0))
+        T c = 0;
+        if(triView.sideB().has_value() && IsGreater(*triView.sideB(), 0))
         {
             // side b is known
-            c = **triView.sideB;
+            c = *triView.sideB();
         }
-        else if(triView.sideC->has_value() && IsGreater(**triView.sideC, 0))
+        else if(triView.sideC().has_value() && IsGreater(*triView.sideC(), 0))
         {
             // side c is known
-            c = **triView.sideC;
+            c = *triView.sideC();
         }
-        double h = c * std::sin(**triView.angleA);
+        T h = c * Math::sin(*triView.angleA());
         return h;
     }
 
     // in a side-side-angle (SSA) case, solve the triangle using the law of sines
-    bool ResolveSSA(TrianglePointerView& tri, AmbiguousCaseSolution ambiguousCaseSolution)
+    // the known angle is angleA
+    template <typename Math, typename T, int Rotation>
+    bool ResolveSSA(TriangleView<Rotation, T> tri, AmbiguousCaseSolution ambiguousCaseSolution)
     {
-        tri.Rotate(tri.findFirstKnownAngleIndex()); // Rotate so that known angle is angleA
-        
-        // a pointer to the side and angle we solve for
-        std::optional<double>* sideToSolveFrom = nullptr;
-        std::optional<double>* angleToSolve = nullptr;
-        if(tri.sideB->has_value())
+        // the side and angle we solve for
+        const bool fromSideB = tri.sideB().has_value();
+        if(fromSideB)
         {
-            sideToSolveFrom = tri.sideB;
-            angleToSolve = tri.angleB;
             LOGIFACE_LOG(trace, "Solving SSA case using sideB and angleB");
         }
-        else if(tri.sideC->has_value())
+        else
         {
-            sideToSolveFrom = tri.sideC;
-            angleToSolve = tri.angleC;
             LOGIFACE_LOG(trace, "Solving SSA case using sideC and angleC");
         }
+        std::optional<T>& sideToSolveFrom = fromSideB ? tri.sideB() : tri.sideC();
+        std::optional<T>& angleToSolve = fromSideB ? tri.angleB() : tri.angleC();
 
-        double h = GetSSAHeight(tri);
-        double a = **tri.sideA;
+        T h = GetSSAHeight<Math>(tri);
+        T a = *tri.sideA();
 
         bool hasTwoSolutions = false;
         
@@ -190,7 +189,7 @@ namespace TriangleCalculatorLib
         if(IsLess(a, h) && !IsEqual(a, h))
         {
             // No solution - a is genuinely less than h
-            LOGIFACE_LOG(warn, "The provided triangle data results in no valid triangle (side a < h) a: " + std::to_string(a) + " h: " + std::to_string(h));
+            LOGIFACE_LOGF(warn, "The provided triangle data results in no valid triangle (side a < h) a: {} h: {}", a, h);
             return false;
         }
         else if(IsEqual(a, h))
@@ -198,10 +197,10 @@ namespace TriangleCalculatorLib
             // Degenerate case: a ≈ h means angle B is 90 degrees
             // Treat as valid with one solution
             LOGIFACE_LOG(trace, "SSA degenerate case detected where a ≈ h (angle B is right angle)");
-            *angleToSolve = M_PI / 2.0; // 90 degrees in radians
+            angleToSolve = std::numbers::pi_v<T> / 2; // 90 degrees in radians
             return true;
         }
-        else if(IsLess(h, a) && IsLess(a, **sideToSolveFrom))
+        else if(IsLess(h, a) && IsLess(a, *sideToSolveFrom))
         {
             hasTwoSolutions = true;
             
@@ -216,52 +215,86 @@ namespace TriangleCalculatorLib
         }
         
         LOGIFACE_LOG(trace, "Solving for the unknown angle using the law of sines");
-        double sinB = (**sideToSolveFrom) * std::sin(**tri.angleA) / (**tri.sideA);
-        sinB = std::max(-1.0, std::min(1.0, sinB));
-        *angleToSolve = std::asin(sinB);
+        T sinB = (*sideToSolveFrom) * Math::sin(*tri.angleA()) / a;
+        sinB = std::max(T(-1), std::min(T(1), sinB));
+        angleToSolve = Math::asin(sinB);
 
         // if this angle becomes NaN something went wrong
-        if(!angleToSolve->has_value() || std::isnan(**angleToSolve))
+        if(std::isnan(*angleToSolve))
         {
-            LOGIFACE_LOG(warn, "Failed to solve SSA case, resulting angle is NaN\n"
+            LOGIFACE_LOGF(warn, "Failed to solve SSA case, resulting angle is NaN\n"
                 "here is a summary of the triangle data:\n"
-                "\tsideA: " + (tri.sideA->has_value() ? std::to_string(**tri.sideA) : "?") + "\n"
-                "\tsideB: " + (tri.sideB->has_value() ? std::to_string(**tri.sideB) : "?") + "\n"
-                "\tsideC: " + (tri.sideC->has_value() ? std::to_string(**tri.sideC) : "?") + "\n"
-                "\tangleA: " + (tri.angleA->has_value() ? std::to_string(**tri.angleA) : "?") + "\n"
-                "\tangleB: " + (tri.angleB->has_value() ? std::to_string(**tri.angleB) : "?") + "\n"
-                "\tangleC: " + (tri.angleC->has_value() ? std::to_string(**tri.angleC) : "?") + "\n"
-                "sideToSolveFrom value: " + std::to_string(**sideToSolveFrom) + "\n"
-                "angleToSolve value: " + std::to_string(**angleToSolve) + "\n"
-            );
+                "\tsideA: {}\n"
+                "\tsideB: {}\n"
+                "\tsideC: {}\n"
+                "\tangleA: {}\n"
+                "\tangleB: {}\n"
+                "\tangleC: {}\n"
+                "sideToSolveFrom value: {}\n"
+                "angleToSolve value: {}\n",
+                tri.sideA(), tri.sideB(), tri.sideC(), tri.angleA(), tri.angleB(), tri.angleC(),
+                sideToSolveFrom, angleToSolve);
             return false;
         }
 
         if( hasTwoSolutions && ambiguousCaseSolution == AmbiguousCaseSolution::SecondSolution)
         {
             LOGIFACE_LOG(trace, "Solving for the second solution of the ambiguous SSA case");
-            *angleToSolve = M_PI - **angleToSolve;
+            angleToSolve = std::numbers::pi_v<T> - *angleToSolve;
         }
 
         return true;
     }
 
     
-    // 2 sides are known and the angle between them is also known
-    void SolveSideWithAngleCos(TrianglePointerView& tri)
+    // 2 sides are known and the angle between them is also known, the angle is angleA
+    template <typename Math, typename T, int Rotation>
+    void SolveSideWithAngleCos(TriangleView<Rotation, T> tri)
     {
         LOGIFACE_LOG(trace, "2 sides known and the angle between them is also known, solving the unknown side using the law of cosines");
+        const T b = *tri.sideB();
+        const T c = *tri.sideC();
         // this is what we do, but by using fma to reduce floating point errors (less rounding steps)        
-        // double squaredSides = **tri.sideB * **tri.sideB +
-        //                       **tri.sideC * **tri.sideC;
-        double subtractor = 2 * **tri.sideB * **tri.sideC * std::cos(**tri.angleA);
-        // double result = squaredSides - subtractor;
-        double result = std::fma(**tri.sideB, **tri.sideB, std::fma(**tri.sideC, **tri.sideC, -subtractor));
-        result = std::max(0.0, result); // prevent negative values due to floating point errors
-        *tri.sideA = std::sqrt(result);
+        // T squaredSides = b * b + c * c;
+        T subtractor = 2 * b * c * Math::cos(*tri.angleA());
+        // T result = squaredSides - subtractor;
+        T result = std::fma(b, b, std::fma(c, c, -subtractor));
+        result = std::max(T(0), result); // prevent negative values due to floating point errors
+        tri.sideA() = std::sqrt(result);
     }
 
-    Result TriangleCalculatorBackend::finalizeTriangle(Triangle triangle, AmbiguousCaseSolution ambiguousCaseSolution)
+    // 2 sides and 1 angle known, the angle is angleA
+    template <typename Math, typename T, int Rotation>
+    void SolveTwoSidesOneAngle(TriangleView<Rotation, T> triView, AmbiguousCaseSolution ambiguousCaseSolution, SolveCase& solveCase)
+    {
+        // now we check if the known angle is included between the two known sides
+        bool sideBKnown = triView.sideB().has_value() && IsGreater(*triView.sideB(), 0);
+        bool sideCKnown = triView.sideC().has_value() && IsGreater(*triView.sideC(), 0);
+
+        if(sideBKnown && sideCKnown)
+        {
+            // SAS case
+            LOGIFACE_LOG(trace, "SAS case detected");
+            solveCase = SolveCase::SAS;
+            SolveSideWithAngleCos<Math>(triView);
+            SolveAnglesWithSides<Math>(triView.triangle());
+        }
+        else
+        {
+            // SSA case
+            LOGIFACE_LOG(trace, "SSA case detected");
+            solveCase = SolveCase::SSA;
+            if(ResolveSSA<Math>(triView, ambiguousCaseSolution))
+            {
+                SimpleSolveAngles(triView.triangle());
+                SolveSides<Math>(triView.triangle());
+            }
+        }
+    }
+
+    // solveCase receives the branch taken, for the stats
+    template <typename Math, typename T>
+    ResultCode Solve(BasicTriangle<T>& triangle, AmbiguousCaseSolution ambiguousCaseSolution, SolveCase& solveCase)
     {
         // this is a workflow based triangle calculator
 
@@ -277,122 +310,129 @@ namespace TriangleCalculatorLib
         
         // SSA - 2 sides and a non-included angle known (ambiguous case)
         
-        // here we init some values
-        TrianglePointerView triView = TrianglePointerView(triangle);
-        Result result;
-        result.code = ResultCode::Success;
-        result.triangle = triangle; // default to input triangle
-
-        std::string logMessage = std::string("got triangle:") +
-                                            "\n\ta=" + (triangle.sideA.has_value() ? std::to_string(triangle.sideA.value()) : "?") +
-                                            "\n\tb=" + (triangle.sideB.has_value() ? std::to_string(triangle.sideB.value()) : "?") +
-                                            "\n\tc=" + (triangle.sideC.has_value() ? std::to_string(triangle.sideC.value()) : "?") +
-                                            "\n\tA=" + (triangle.angleA.has_value() ? std::to_string(triangle.angleA.value()) : "?") +
-                                            "\n\tB=" + (triangle.angleB.has_value() ? std::to_string(triangle.angleB.value()) : "?") +
-                                            "\n\tC=" + (triangle.angleC.has_value() ? std::to_string(triangle.angleC.value()) : "?");
-        LOGIFACE_LOG(info, logMessage);
+        // the views reorder the fields of the triangle in place, so solving writes straight into it
+        const int knownAngles = KnownAngleCount(triangle);
+        const int knownSides = KnownSideCount(triangle);
         
         // check which case applies
 
         // not solvable cases
-        if(triView.KnownAngleCount() + triView.KnownSideCount() < 3)
+        if(knownAngles + knownSides < 3)
         {
             // Not enough information to finalize the triangle
             LOGIFACE_LOG(warn, "Not enough information to finalize the triangle");
-            result.code = ResultCode::InsufficientData;
-            return result;
+            solveCase = SolveCase::Insufficient;
+            return ResultCode::InsufficientData;
         }
-        else if (triView.KnownSideCount() == 0)
+        else if (knownSides == 0)
         {
             // Not enough information to finalize the triangle
             LOGIFACE_LOG(warn, "Not enough sides known to finalize the triangle");
-            result.code = ResultCode::InsufficientData;
-            return result;
+            solveCase = SolveCase::Insufficient;
+            return ResultCode::InsufficientData;
         }
 
         // harder multiple missing values cases
         // SSS case
-        else if(triView.KnownSideCount() == 3)
+        else if(knownSides == 3)
         {
             // SSS case
             LOGIFACE_LOG(trace, "SSS case detected");
 
-            if(triView.KnownAngleCount() == 3)
+            if(knownAngles == 3)
             {
                 // triangle is already complete
                 LOGIFACE_LOG(info, "Triangle is already complete");
-                result.triangle = triangle;
-                return result;
+                solveCase = SolveCase::Complete;
+                return ResultCode::Success;
             }
-            else if (triView.KnownAngleCount() == 2)
+            else if (knownAngles == 2)
             {
                 // two angles known, calculate the third angle
-                SimpleSolveAngles(triView);
+                solveCase = SolveCase::ThirdAngle;
+                SimpleSolveAngles(triangle);
             }
             else
             {
                 // all sides known and 1 angle, solve angles using law of cosines
-                SolveAnglesWithSides(triView);
+                solveCase = SolveCase::SSS;
+                SolveAnglesWithSides<Math>(triangle);
             }
 
         }
         // SAS SSA
-        else if(triView.KnownSideCount() == 2 && triView.KnownAngleCount() == 1)
+        else if(knownSides == 2 && knownAngles == 1)
         {
             // could be SAS or SSA
             LOGIFACE_LOG(trace, "2 sides and 1 angle known, determining if SAS or SSA case");
-            int knownAngleIndex = triView.findFirstKnownAngleIndex();
-            triView.Rotate(knownAngleIndex); // Rotate so that known angle is angleA
-
-            // now we check if the known angle is included between the two known sides
-            bool sideBKnown = triView.sideB->has_value() && IsGreater(**triView.sideB, 0);
-            bool sideCKnown = triView.sideC->has_value() && IsGreater(**triView.sideC, 0);
-
-            if(sideBKnown && sideCKnown)
-            {
-                // SAS case
-                LOGIFACE_LOG(trace, "SAS case detected");
-                SolveSideWithAngleCos(triView);
-                SolveAnglesWithSides(triView);
-            }
-            else
-            {
-                // SSA case
-                LOGIFACE_LOG(trace, "SSA case detected");
-                if(ResolveSSA(triView, ambiguousCaseSolution))
-                {
-                    SimpleSolveAngles(triView);
-                    triView.Rotate(triView.findFirstKnownSideIndex());
-                    SolveSides(triView);
-                }
-
-            }
+            // Rotate so that known angle is angleA
+            WithRotation(triangle, FindFirstKnownAngleIndex(triangle), [ambiguousCaseSolution, &solveCase](auto triView) {
+                SolveTwoSidesOneAngle<Math>(triView, ambiguousCaseSolution, solveCase);
+            });
         }
         // ASA or AAS
-        else if(triView.KnownAngleCount() >= 2 && triView.KnownSideCount() < 3)
+        else if(knownAngles >= 2 && knownSides < 3)
         {
             // ASA or AAS case
             LOGIFACE_LOG(trace, "ASA/AAS case detected");
-            if(triView.KnownAngleCount() == 2)
-            { SimpleSolveAngles(triView); }
-            int knownSideIndex = triView.findFirstKnownSideIndex();
-            // Rotate so that the known side is in the first position (sideA)
-            triView.Rotate(knownSideIndex);
-            SolveSides(triView);
+            solveCase = SolveCase::AAS;
+            if(knownAngles == 2)
+            { SimpleSolveAngles(triangle); }
+            SolveSides<Math>(triangle);
         }
 
-        // we are done, copy back the triangle
-        result.triangle = triangle;
+        return ResultCode::Success;
+    }
+
+    template <typename T>
+    ResultCode TriangleCalculatorBackend::finalizeTriangle(BasicTriangle<T>& triangle, Precision precision, AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        LOGIFACE_LOGF(info, "got triangle:\n\ta={}\n\tb={}\n\tc={}\n\tA={}\n\tB={}\n\tC={}",
+                      triangle.sideA, triangle.sideB, triangle.sideC, triangle.angleA, triangle.angleB, triangle.angleC);
+
+        const ResultCode code = solve(triangle, precision, ambiguousCaseSolution);
+
+        if(code != ResultCode::Success)
+        {
+            return code;
+        }
+
+        LOGIFACE_LOGF(info, "finalized triangle:\n\ta={}\n\tb={}\n\tc={}\n\tA={}\n\tB={}\n\tC={}",
+                      triangle.sideA, triangle.sideB, triangle.sideC, triangle.angleA, triangle.angleB, triangle.angleC);
 
-        std::string finalLogMessage = std::string("finalized triangle:") +
-                                                "\n\ta=" + (triangle.sideA.has_value() ? std::to_string(triangle.sideA.value()) : "?") +
-                                                "\n\tb=" + (triangle.sideB.has_value() ? std::to_string(triangle.sideB.value()) : "?") +
-                                                "\n\tc=" + (triangle.sideC.has_value() ? std::to_string(triangle.sideC.value()) : "?") +
-                                                "\n\tA=" + (triangle.angleA.has_value() ? std::to_string(triangle.angleA.value()) : "?") +
-                                                "\n\tB=" + (triangle.angleB.has_value() ? std::to_string(triangle.angleB.value()) : "?") +
-                                                "\n\tC=" + (triangle.angleC.has_value() ? std::to_string(triangle.angleC.value()) : "?");
-        LOGIFACE_LOG(info, finalLogMessage);
+        return code;
+    }
+
+    template <typename T>
+    ResultCode TriangleCalculatorBackend::solve(BasicTriangle<T>& triangle, Precision precision, AmbiguousCaseSolution ambiguousCaseSolution)
+    {
+        SolveCase solveCase = SolveCase::Insufficient;
+        auto dispatch = [&] {
+            return precision == Precision::Fast ? Solve<FastMath>(triangle, ambiguousCaseSolution, solveCase)
+                                                : Solve<StdMath>(triangle, ambiguousCaseSolution, solveCase);
+        };
+        if (!SolverStats::enabled())
+        {
+            return dispatch();
+        }
+        if (!SolverStats::sampleLatency())
+        {
+            const ResultCode code = dispatch();
+            SolverStats::record(solveCase, code);
+            return code;
+        }
 
-        return result;
+        const auto start = std::chrono::steady_clock::now();
+        const ResultCode code = dispatch();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        SolverStats::record(solveCase, code, static_cast<std::uint64_t>(elapsed.count()));
+        return code;
     }
+
+    template ResultCode TriangleCalculatorBackend::finalizeTriangle(BasicTriangle<float>&, Precision, AmbiguousCaseSolution);
+    template ResultCode TriangleCalculatorBackend::finalizeTriangle(BasicTriangle<double>&, Precision, AmbiguousCaseSolution);
+    template ResultCode TriangleCalculatorBackend::finalizeTriangle(BasicTriangle<long double>&, Precision, AmbiguousCaseSolution);
+    template ResultCode TriangleCalculatorBackend::solve(BasicTriangle<float>&, Precision, AmbiguousCaseSolution);
+    template ResultCode TriangleCalculatorBackend::solve(BasicTriangle<double>&, Precision, AmbiguousCaseSolution);
+    template ResultCode TriangleCalculatorBackend::solve(BasicTriangle<long double>&, Precision, AmbiguousCaseSolution);
 } // namespace TriangleCalculatorLib
\ No newline at end of file
@@ -3,16 +3,61 @@
 
 #include <TriangleCalculatorLib/Triangle.hpp>
 #include <TriangleCalculatorLib/ReturnCode.hpp>
+// the tolerance comparisons the solver uses
+#include <TriangleCalculatorLib/ConstexprMath.hpp>
 
 #include <logging/logging.hpp>
 
+#include <cmath>
+
 namespace TriangleCalculatorLib
 {
+    using detail::ABSOLUTE_TOLERANCE;
+    using detail::IsEqual;
+    using detail::IsGreater;
+    using detail::IsLess;
+    using detail::IsLessOrEqual;
+
+    // the trig functions of Precision::Exact, the solver steps take either this or FastMath
+    struct StdMath
+    {
+        template <typename T> static T sin(T x) { return std::sin(x); }
+        template <typename T> static T cos(T x) { return std::cos(x); }
+        template <typename T> static T asin(T x) { return std::asin(x); }
+        template <typename T> static T acos(T x) { return std::acos(x); }
+    };
+
+    // The solver for every scalar type, instantiated for float, double and long double
     class TriangleCalculatorBackend
     {
     public:
-        static Result finalizeTriangle(Triangle triangle, AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+        // solve the triangle in place (angles in radians), logging the input and the solved triangle
+        template <typename T>
+        static ResultCode finalizeTriangle(BasicTriangle<T>& triangle, AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution)
+        {
+            return finalizeTriangle(triangle, Precision::Exact, ambiguousCaseSolution);
+        }
+
+        template <typename T>
+        static ResultCode finalizeTriangle(BasicTriangle<T>& triangle, Precision precision, AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
+
+        // solve the triangle in place (angles in radians) without the per-call summary logging
+        template <typename T>
+        static ResultCode solve(BasicTriangle<T>& triangle, AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution)
+        {
+            return solve(triangle, Precision::Exact, ambiguousCaseSolution);
+        }
+
+        template <typename T>
+        static ResultCode solve(BasicTriangle<T>& triangle, Precision precision, AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution);
     };
+
+    extern template ResultCode TriangleCalculatorBackend::finalizeTriangle(BasicTriangle<float>&, Precision, AmbiguousCaseSolution);
+    extern template ResultCode TriangleCalculatorBackend::finalizeTriangle(BasicTriangle<double>&, Precision, AmbiguousCaseSolution);
+    extern template ResultCode TriangleCalculatorBackend::finalizeTriangle(BasicTriangle<long double>&, Precision, AmbiguousCaseSolution);
+    extern template ResultCode TriangleCalculatorBackend::solve(BasicTriangle<float>&, Precision, AmbiguousCaseSolution);
+    extern template ResultCode TriangleCalculatorBackend::solve(BasicTriangle<double>&, Precision, AmbiguousCaseSolution);
+    extern template ResultCode TriangleCalculatorBackend::solve(BasicTriangle<long double>&, Precision, AmbiguousCaseSolution);
 } // namespace TriangleCalculatorLib
 
 
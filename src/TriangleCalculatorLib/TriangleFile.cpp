@@ -0,0 +1,277 @@
+#include <TriangleCalculatorLib/TriangleFile.hpp>
+
+#include <logging/logging.hpp>
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TRIANGLE_FILE_MMAP 1
+#endif
+
+namespace TriangleCalculatorLib
+{
+    namespace
+    {
+        constexpr std::array<char, 8> Magic{'T', 'R', 'I', 'C', 'A', 'L', 'C', '\0'};
+        constexpr std::size_t ColumnAlignment = 64;
+
+        enum Column : std::size_t
+        {
+            Known,
+            SideA,
+            SideB,
+            SideC,
+            AngleA,
+            AngleB,
+            AngleC,
+            Codes,
+            ColumnCount
+        };
+
+        constexpr std::size_t ColumnWidth(std::size_t column)
+        {
+            return column == Known || column == Codes ? 1 : sizeof(double);
+        }
+
+        constexpr std::size_t AlignUp(std::size_t value)
+        {
+            return (value + ColumnAlignment - 1) / ColumnAlignment * ColumnAlignment;
+        }
+
+        static_assert(std::endian::native == std::endian::little, "triangle files are little endian");
+    } // namespace
+
+    struct TriangleFile::Header
+    {
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint64_t count;
+        std::uint64_t capacity;
+        std::uint32_t unit;
+        std::uint32_t reserved;
+        std::array<std::uint64_t, ColumnCount> offsets;
+        std::array<std::uint8_t, 128 - 40 - 8 * ColumnCount> padding;
+    };
+    TriangleFile::~TriangleFile()
+    {
+        close();
+    }
+
+    TriangleFile::TriangleFile(TriangleFile&& other) noexcept
+        : mapping_(std::exchange(other.mapping_, nullptr)), mappingSize_(std::exchange(other.mappingSize_, 0))
+    {
+    }
+
+    TriangleFile& TriangleFile::operator=(TriangleFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            mapping_ = std::exchange(other.mapping_, nullptr);
+            mappingSize_ = std::exchange(other.mappingSize_, 0);
+        }
+        return *this;
+    }
+
+    TriangleFile::Header* TriangleFile::header() const noexcept
+    {
+        static_assert(sizeof(Header) == 128, "the header layout is part of the file format");
+        return static_cast<Header*>(mapping_);
+    }
+
+    std::size_t TriangleFile::size() const noexcept
+    {
+        return isOpen() ? static_cast<std::size_t>(header()->count) : 0;
+    }
+
+    std::size_t TriangleFile::capacity() const noexcept
+    {
+        return isOpen() ? static_cast<std::size_t>(header()->capacity) : 0;
+    }
+
+    AngleUnit TriangleFile::unit() const noexcept
+    {
+        return isOpen() && header()->unit == 1 ? AngleUnit::Radians : AngleUnit::Degrees;
+    }
+
+    ResultCode TriangleFile::resize(std::size_t count) noexcept
+    {
+        if (!isOpen() || count > capacity())
+        {
+            LOGIFACE_LOG(error, "Triangle file row count exceeds its capacity");
+            return ResultCode::InvalidData;
+        }
+        header()->count = count;
+        return ResultCode::Success;
+    }
+
+    TriangleColumns TriangleFile::columns() noexcept
+    {
+        if (!isOpen())
+        {
+            return {};
+        }
+        auto* base = static_cast<std::byte*>(mapping_);
+        const std::size_t count = size();
+        auto doubles = [&](Column column) {
+            return std::span<double>(reinterpret_cast<double*>(base + header()->offsets[column]), count);
+        };
+        return TriangleColumns{
+            doubles(SideA), doubles(SideB), doubles(SideC),
+            doubles(AngleA), doubles(AngleB), doubles(AngleC),
+            std::span<std::uint8_t>(reinterpret_cast<std::uint8_t*>(base + header()->offsets[Known]), count),
+            std::span<ResultCode>(reinterpret_cast<ResultCode*>(base + header()->offsets[Codes]), count)};
+    }
+
+#if defined(TRIANGLE_FILE_MMAP)
+    ResultCode TriangleFile::map(int fd, std::size_t bytes, Access access)
+    {
+        const int flags = access == Access::ReadWrite ? MAP_SHARED : MAP_PRIVATE;
+        void* mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            LOGIFACE_LOGF(error, "Unable to map triangle file: {}", std::string_view(std::strerror(errno)));
+            return ResultCode::InvalidData;
+        }
+        // the solver streams through the columns front to back
+        ::madvise(mapping, bytes, MADV_SEQUENTIAL);
+        mapping_ = mapping;
+        mappingSize_ = bytes;
+        return ResultCode::Success;
+    }
+
+    ResultCode TriangleFile::open(const std::filesystem::path& path, Access access)
+    {
+        close();
+        const int fd = ::open(path.c_str(), access == Access::ReadWrite ? O_RDWR : O_RDONLY);
+        if (fd < 0)
+        {
+            LOGIFACE_LOGF(error, "Unable to open triangle file {}: {}", std::string_view(path.native()),
+                          std::string_view(std::strerror(errno)));
+            return ResultCode::InvalidData;
+        }
+        struct stat info{};
+        ResultCode code = ::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= sizeof(Header)
+                              ? map(fd, static_cast<std::size_t>(info.st_size), access)
+                              : ResultCode::InvalidData;
+        ::close(fd);
+        if (code != ResultCode::Success)
+        {
+            LOGIFACE_LOG(error, "Triangle file is too small or can not be mapped");
+            return code;
+        }
+
+        // every column must lie inside the file and the double columns must be aligned
+        const Header& h = *header();
+        bool valid = h.magic == Magic && h.version == FormatVersion && h.headerSize == sizeof(Header) &&
+                     h.count <= h.capacity && h.unit <= 1;
+        for (std::size_t column = 0; column < ColumnCount && valid; ++column)
+        {
+            const std::uint64_t offset = h.offsets[column];
+            valid = offset >= sizeof(Header) && offset % ColumnAlignment == 0 && offset <= mappingSize_ &&
+                    h.capacity <= (mappingSize_ - offset) / ColumnWidth(column);
+        }
+        if (!valid)
+        {
+            LOGIFACE_LOG(error, "Not a triangle file of a supported version, or the file is truncated");
+            close();
+            return ResultCode::InvalidData;
+        }
+        return ResultCode::Success;
+    }
+
+    ResultCode TriangleFile::create(const std::filesystem::path& path, std::size_t capacity, AngleUnit unit)
+    {
+        close();
+        Header h{};
+        h.magic = Magic;
+        h.version = FormatVersion;
+        h.headerSize = sizeof(Header);
+        h.count = 0;
+        h.capacity = capacity;
+        h.unit = unit == AngleUnit::Radians ? 1 : 0;
+        std::size_t offset = AlignUp(sizeof(Header));
+        for (std::size_t column = 0; column < ColumnCount; ++column)
+        {
+            h.offsets[column] = offset;
+            offset = AlignUp(offset + capacity * ColumnWidth(column));
+        }
+
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            LOGIFACE_LOGF(error, "Unable to create triangle file {}: {}", std::string_view(path.native()),
+                          std::string_view(std::strerror(errno)));
+            return ResultCode::InvalidData;
+        }
+        // the columns start out as a hole in the file, pages are only allocated once written
+        ResultCode code = ::ftruncate(fd, static_cast<off_t>(offset)) == 0 ? map(fd, offset, Access::ReadWrite)
+                                                                          : ResultCode::InvalidData;
+        ::close(fd);
+        if (code != ResultCode::Success)
+        {
+            LOGIFACE_LOG(error, "Unable to size the triangle file");
+            return code;
+        }
+        std::memcpy(mapping_, &h, sizeof(h));
+        return ResultCode::Success;
+    }
+
+    void TriangleFile::close() noexcept
+    {
+        if (mapping_)
+        {
+            ::munmap(mapping_, mappingSize_);
+            mapping_ = nullptr;
+            mappingSize_ = 0;
+        }
+    }
+
+    ResultCode TriangleFile::sync() noexcept
+    {
+        if (mapping_ && ::msync(mapping_, mappingSize_, MS_SYNC) != 0)
+        {
+            LOGIFACE_LOG(error, "Unable to flush the triangle file");
+            return ResultCode::InvalidData;
+        }
+        return ResultCode::Success;
+    }
+#else
+    ResultCode TriangleFile::map(int, std::size_t, Access)
+    {
+        return ResultCode::InvalidData;
+    }
+
+    ResultCode TriangleFile::open(const std::filesystem::path&, Access)
+    {
+        LOGIFACE_LOG(error, "Triangle files need mmap, which this platform does not provide");
+        return ResultCode::InvalidData;
+    }
+
+    ResultCode TriangleFile::create(const std::filesystem::path&, std::size_t, AngleUnit)
+    {
+        LOGIFACE_LOG(error, "Triangle files need mmap, which this platform does not provide");
+        return ResultCode::InvalidData;
+    }
+
+    void TriangleFile::close() noexcept
+    {
+        mapping_ = nullptr;
+        mappingSize_ = 0;
+    }
+
+    ResultCode TriangleFile::sync() noexcept
+    {
+        return ResultCode::Success;
+    }
+#endif
+} // namespace TriangleCalculatorLib
@@ -0,0 +1,423 @@
+#include <TriangleCalculatorLib/TriangleGenerator.hpp>
+
+#include <TriangleCalculatorLib/ThreadPool.hpp>
+#include <TriangleCalculatorLib/TriangleFile.hpp>
+
+#include <logging/logging.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <functional>
+#include <numbers>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace TriangleCalculatorLib
+{
+    namespace
+    {
+        constexpr double DegreesToRadians = std::numbers::pi / 180.0;
+
+        // the splitmix64 finalizer, spreads every input bit over the whole word
+        constexpr std::uint64_t Mix(std::uint64_t x) noexcept
+        {
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            return x ^ (x >> 31);
+        }
+
+        // splitmix64 started from the seed and the row index, every row draws from its own stream
+        class RowRandom
+        {
+        public:
+            RowRandom(std::uint64_t seed, std::uint64_t row) noexcept : state_(Mix(seed + Mix(row + 0x9E3779B97F4A7C15ull))) {}
+
+            std::uint64_t next() noexcept
+            {
+                state_ += 0x9E3779B97F4A7C15ull;
+                return Mix(state_);
+            }
+
+            // [0, 1) with all 53 bits of the mantissa random
+            double uniform() noexcept { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+            double uniform(double low, double high) noexcept { return low + (high - low) * uniform(); }
+
+            // [0, count)
+            std::size_t below(std::size_t count) noexcept { return static_cast<std::size_t>(uniform() * static_cast<double>(count)); }
+
+            // an index drawn with the given relative weights, the first one if none is positive
+            template <std::size_t N>
+            std::size_t pick(const std::array<double, N>& weights) noexcept
+            {
+                double total = 0.0;
+                for (const double weight : weights)
+                {
+                    total += std::max(0.0, weight);
+                }
+                double target = uniform() * total;
+                for (std::size_t i = 0; i < N; ++i)
+                {
+                    const double weight = std::max(0.0, weights[i]);
+                    if (target < weight)
+                    {
+                        return i;
+                    }
+                    target -= weight;
+                }
+                return 0;
+            }
+
+        private:
+            std::uint64_t state_;
+        };
+
+        // the three angles of a shape in degrees. Margins keep the categories apart and away from the
+        // cases where the solver has to decide within its tolerance (a side equal to the SSA height).
+        std::array<double, 3> ShapeAngles(TriangleShape shape, RowRandom& random)
+        {
+            switch (shape)
+            {
+            case TriangleShape::Right:
+            {
+                // legs at least 16% apart, so it never comes close to the isosceles right triangle
+                const double angle = random.uniform(15.0, 40.0);
+                return {90.0, angle, 90.0 - angle};
+            }
+            case TriangleShape::Equilateral:
+                return {60.0, 60.0, 60.0};
+            case TriangleShape::Isosceles:
+            {
+                // like the Python fixture the two equal sides are the longer ones
+                const double apex = random.uniform(20.0, 55.0);
+                const double base = (180.0 - apex) / 2.0;
+                return {apex, base, base};
+            }
+            case TriangleShape::Scalene:
+            case TriangleShape::Count:
+                break;
+            }
+
+            // at least 15 degrees each, 5 degrees apart and 5 away from a right angle
+            for (int attempt = 0; attempt < 32; ++attempt)
+            {
+                const double a = random.uniform(15.0, 150.0);
+                const double b = random.uniform(15.0, 165.0 - a);
+                const std::array<double, 3> angles{a, b, 180.0 - a - b};
+                const auto apart = [](double x, double y) { return std::abs(x - y) >= 5.0; };
+                if (angles[2] >= 15.0 && apart(a, b) && apart(a, angles[2]) && apart(b, angles[2]) &&
+                    apart(a, 90.0) && apart(b, 90.0) && apart(angles[2], 90.0))
+                {
+                    return angles;
+                }
+            }
+            return {40.0, 60.0, 80.0};
+        }
+
+        // a triangle as arrays, side i opposite angle i, so the cases can pick fields by index
+        struct Fields
+        {
+            std::array<double, 3> sides{};
+            std::array<double, 3> angles{};
+        };
+
+        // indices of the sides from the shortest to the longest
+        std::array<std::size_t, 3> BySideLength(const Fields& fields)
+        {
+            std::array<std::size_t, 3> order{0, 1, 2};
+            std::sort(order.begin(), order.end(), [&](std::size_t x, std::size_t y) { return fields.sides[x] < fields.sides[y]; });
+            return order;
+        }
+
+        // the two indices other than i, in random order
+        std::pair<std::size_t, std::size_t> Others(std::size_t i, RowRandom& random)
+        {
+            const std::size_t first = (i + 1 + random.below(2)) % 3;
+            return {first, 3 - i - first};
+        }
+
+        constexpr std::array<std::uint8_t, 3> SideBits{KnownField::SideA, KnownField::SideB, KnownField::SideC};
+        constexpr std::array<std::uint8_t, 3> AngleBits{KnownField::AngleA, KnownField::AngleB, KnownField::AngleC};
+
+        CompactTriangle ToCompact(const Fields& fields, std::uint8_t known, double angleFactor)
+        {
+            // unknown values stay 0, like CompactTriangle expects
+            const auto side = [&](std::size_t i) { return (known & SideBits[i]) ? fields.sides[i] : 0.0; };
+            const auto angle = [&](std::size_t i) { return (known & AngleBits[i]) ? fields.angles[i] * angleFactor : 0.0; };
+            return CompactTriangle{side(0), side(1), side(2), angle(0), angle(1), angle(2), known};
+        }
+
+        // which values of the complete triangle are given, and how an invalid row breaks them
+        std::uint8_t ChooseKnown(GeneratorCase generatorCase, GeneratedKind kind, Fields& fields, RowRandom& random)
+        {
+            const double breakFactor = random.uniform(1.05, 1.5);
+            switch (generatorCase)
+            {
+            case GeneratorCase::SSS:
+            {
+                if (kind == GeneratedKind::Invalid)
+                {
+                    // the longest side longer than the other two together
+                    const std::array<std::size_t, 3> order = BySideLength(fields);
+                    fields.sides[order[2]] = (fields.sides[order[0]] + fields.sides[order[1]]) * breakFactor;
+                }
+                return KnownField::Sides;
+            }
+            case GeneratorCase::SAS:
+            {
+                const std::size_t angle = random.below(3);
+                if (kind == GeneratedKind::Invalid)
+                {
+                    fields.angles[angle] = 180.0 * breakFactor;
+                }
+                return static_cast<std::uint8_t>(KnownField::Sides & ~SideBits[angle]) | AngleBits[angle];
+            }
+            case GeneratorCase::SSA:
+            {
+                const std::array<std::size_t, 3> order = BySideLength(fields);
+                if (kind == GeneratedKind::Valid)
+                {
+                    // the angle opposite the longest side, then the other side can only close one way
+                    const auto [other, unused] = Others(order[2], random);
+                    return SideBits[order[2]] | SideBits[other] | AngleBits[order[2]];
+                }
+                // the angle opposite the shortest side (always acute) and the middle side: shorter than the middle
+                // side but longer than the height two triangles fit, shorter than the height none does
+                if (kind == GeneratedKind::Invalid)
+                {
+                    const double height = fields.sides[order[1]] * std::sin(fields.angles[order[0]] * DegreesToRadians);
+                    fields.sides[order[0]] = height / breakFactor;
+                }
+                return SideBits[order[0]] | SideBits[order[1]] | AngleBits[order[0]];
+            }
+            case GeneratorCase::ASA:
+            case GeneratorCase::AAS:
+            case GeneratorCase::Count:
+                break;
+            }
+
+            // ASA gives the side between the two angles, AAS one opposite of them
+            const std::size_t side = random.below(3);
+            const auto [first, second] = Others(side, random);
+            const std::size_t angle = generatorCase == GeneratorCase::ASA ? second : side;
+            if (kind == GeneratedKind::Invalid)
+            {
+                // angles that add up to more than 180 degrees
+                const double scale = 180.0 * breakFactor / (fields.angles[first] + fields.angles[angle]);
+                fields.angles[first] *= scale;
+                fields.angles[angle] *= scale;
+            }
+            return SideBits[side] | AngleBits[first] | AngleBits[angle];
+        }
+
+        // whether name=weight pairs fill weights, names[i] naming weights[i]
+        template <std::size_t N, typename Name>
+        bool ParseWeights(std::string_view text, std::array<double, N>& weights, Name name)
+        {
+            std::array<double, N> parsed{};
+            while (!text.empty())
+            {
+                const std::size_t comma = text.find(',');
+                const std::string_view pair = text.substr(0, comma);
+                text.remove_prefix(comma == std::string_view::npos ? text.size() : comma + 1);
+
+                const std::size_t equals = pair.find('=');
+                if (equals == std::string_view::npos)
+                {
+                    return false;
+                }
+                const std::string_view key = pair.substr(0, equals);
+                const std::string_view value = pair.substr(equals + 1);
+                std::size_t index = 0;
+                while (index < N && name(index) != key)
+                {
+                    ++index;
+                }
+                double weight = 0.0;
+                const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), weight);
+                if (index == N || ec != std::errc{} || ptr != value.data() + value.size() || !std::isfinite(weight) || weight < 0.0)
+                {
+                    return false;
+                }
+                parsed[index] = weight;
+            }
+            if (std::all_of(parsed.begin(), parsed.end(), [](double weight) { return weight == 0.0; }))
+            {
+                return false;
+            }
+            weights = parsed;
+            return true;
+        }
+
+        // rows [first, first + count) of the whole run, on the pool if there is one
+        template <typename Body>
+        void ForEachShard(const GeneratorOptions& options, std::size_t count, Body&& body)
+        {
+            const std::size_t shardSize = std::max<std::size_t>(1, options.shardSize);
+            if (options.pool)
+            {
+                options.pool->parallelFor(count, shardSize, body);
+                return;
+            }
+            for (std::size_t begin = 0; begin < count; begin += shardSize)
+            {
+                body(begin, std::min(count, begin + shardSize));
+            }
+        }
+    } // namespace
+
+    GeneratedTriangle TriangleGenerator::generate(const GeneratorOptions& options, std::uint64_t row) noexcept
+    {
+        RowRandom random(options.seed, row);
+        const GeneratorMix& mix = options.mix;
+
+        GeneratedTriangle generated;
+        const double kind = random.uniform();
+        if (kind < mix.invalidFraction)
+        {
+            generated.kind = GeneratedKind::Invalid;
+        }
+        else if (kind < mix.invalidFraction + mix.ambiguousFraction)
+        {
+            generated.kind = GeneratedKind::Ambiguous;
+        }
+        generated.generatorCase = generated.kind == GeneratedKind::Ambiguous ? GeneratorCase::SSA
+                                                                              : static_cast<GeneratorCase>(random.pick(mix.cases));
+        generated.shape = static_cast<TriangleShape>(random.pick(mix.shapes));
+        if (generated.kind == GeneratedKind::Ambiguous && generated.shape == TriangleShape::Equilateral)
+        {
+            // two solutions need two sides of different length
+            generated.shape = TriangleShape::Isosceles;
+        }
+
+        // the angles in a random order, the sides follow from the law of sines
+        std::array<double, 3> angles = ShapeAngles(generated.shape, random);
+        const std::size_t rotation = random.below(6);
+        std::rotate(angles.begin(), angles.begin() + rotation % 3, angles.end());
+        if (rotation >= 3)
+        {
+            std::swap(angles[1], angles[2]);
+        }
+        const double scale = random.uniform(1.0, 100.0);
+        Fields fields;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            fields.angles[i] = angles[i];
+            fields.sides[i] = scale * std::sin(angles[i] * DegreesToRadians);
+        }
+
+        const double angleFactor = options.unit == AngleUnit::Radians ? DegreesToRadians : 1.0;
+        generated.complete = ToCompact(fields, KnownField::All, angleFactor);
+        const std::uint8_t known = ChooseKnown(generated.generatorCase, generated.kind, fields, random);
+        generated.input = ToCompact(fields, known, angleFactor);
+        return generated;
+    }
+
+    void TriangleGenerator::generate(const GeneratorOptions& options, const TriangleColumns& columns)
+    {
+        ForEachShard(options, columns.size(), [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                columns.set(i, generate(options, options.firstRow + i).input);
+            }
+        });
+    }
+
+    ResultCode TriangleGenerator::write(std::ostream& output, StreamFormat format, std::uint64_t count, const GeneratorOptions& options)
+    {
+        std::string header;
+        TriangleStream::appendHeader(header, format);
+        output.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+        // a wave holds a few shards per worker, they are formatted in parallel and written in order.
+        // With a pool a writer thread writes one wave while the workers format the next.
+        const std::size_t shardSize = std::max<std::size_t>(1, options.shardSize);
+        const std::size_t shardsPerWave = options.pool ? 2 * options.pool->threadCount() + 1 : 1;
+        std::vector<std::string> formatted(shardsPerWave);
+        std::vector<std::string> writing(shardsPerWave);
+        const auto writeShards = [&output](const std::vector<std::string>& texts) {
+            for (const std::string& text : texts)
+            {
+                output.write(text.data(), static_cast<std::streamsize>(text.size()));
+            }
+        };
+        std::thread writer;
+
+        bool good = output.good();
+        for (std::uint64_t waveBegin = 0; waveBegin < count && good; waveBegin += shardsPerWave * shardSize)
+        {
+            const auto formatShards = [&](std::size_t first, std::size_t last) {
+                for (std::size_t shard = first; shard < last; ++shard)
+                {
+                    std::string& text = formatted[shard];
+                    text.clear();
+                    const std::uint64_t begin = std::min<std::uint64_t>(count, waveBegin + shard * shardSize);
+                    const std::uint64_t end = std::min<std::uint64_t>(count, begin + shardSize);
+                    for (std::uint64_t row = begin; row < end; ++row)
+                    {
+                        TriangleStream::appendLine(text, format, generate(options, options.firstRow + row).input);
+                    }
+                }
+            };
+            if (options.pool)
+            {
+                options.pool->parallelFor(shardsPerWave, 1, formatShards);
+            }
+            else
+            {
+                formatShards(0, shardsPerWave);
+            }
+
+            if (writer.joinable())
+            {
+                writer.join();
+            }
+            good = output.good();
+            std::swap(formatted, writing);
+            if (options.pool)
+            {
+                writer = std::thread(writeShards, std::cref(writing));
+            }
+            else
+            {
+                writeShards(writing);
+            }
+        }
+        if (writer.joinable())
+        {
+            writer.join();
+        }
+
+        if (!output.flush())
+        {
+            LOGIFACE_LOG(error, "Writing the generated triangles failed");
+            return ResultCode::InvalidData;
+        }
+        return ResultCode::Success;
+    }
+
+    ResultCode TriangleGenerator::writeFile(const std::filesystem::path& path, std::uint64_t count, const GeneratorOptions& options)
+    {
+        TriangleFile file;
+        if (file.create(path, count, options.unit) != ResultCode::Success || file.resize(count) != ResultCode::Success)
+        {
+            return ResultCode::InvalidData;
+        }
+        generate(options, file.columns());
+        return file.sync();
+    }
+
+    bool TriangleGenerator::parseCases(std::string_view text, GeneratorMix& mix)
+    {
+        return ParseWeights(text, mix.cases, [](std::size_t i) { return to_string(static_cast<GeneratorCase>(i)); });
+    }
+
+    bool TriangleGenerator::parseShapes(std::string_view text, GeneratorMix& mix)
+    {
+        return ParseWeights(text, mix.shapes, [](std::size_t i) { return to_string(static_cast<TriangleShape>(i)); });
+    }
+} // namespace TriangleCalculatorLib
@@ -0,0 +1,598 @@
+#include <TriangleCalculatorLib/TriangleJson.hpp>
+
+#include <TriangleCalculatorLib/CompactTriangle.hpp>
+
+#include <logging/logging.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <string_view>
+#include <vector>
+
+namespace TriangleCalculatorLib
+{
+    namespace
+    {
+        // bytes read at a time from a stream, the buffer only grows for a single token longer than this
+        constexpr std::size_t BlockSize = 1 << 20;
+        // deeper nesting is not a triangle file, refusing it keeps the stack bounded
+        constexpr std::size_t MaxDepth = 256;
+
+        enum class Expect : std::uint8_t
+        {
+            KeyOrEnd,   // after '{'
+            Key,        // after ',' in an object
+            Colon,
+            ValueOrEnd, // after '['
+            Value,      // after ':' or ',' in an array
+            CommaOrEnd
+        };
+
+        // for arrays what their elements are, for objects what the value after the current key is
+        enum class Role : std::uint8_t
+        {
+            None,
+            Sides,
+            Angles
+        };
+
+        // what the value starting at the current token fills
+        enum class Slot : std::uint8_t
+        {
+            Other,
+            SidesArray,
+            AnglesArray,
+            SideValue,
+            AngleValue
+        };
+
+        // an open object or array
+        struct Frame
+        {
+            bool object = false;
+            Expect expect = Expect::Value;
+            Role role = Role::None;
+            std::uint8_t count = 0;   // elements so far, for sides and angles arrays
+            bool triangle = false;    // an object that holds sides or angles
+            bool malformed = false;
+            CompactTriangle value{};
+        };
+
+        constexpr std::array<double CompactTriangle::*, 3> SideMembers{&CompactTriangle::sideA, &CompactTriangle::sideB,
+                                                                       &CompactTriangle::sideC};
+        constexpr std::array<double CompactTriangle::*, 3> AngleMembers{&CompactTriangle::angleA, &CompactTriangle::angleB,
+                                                                        &CompactTriangle::angleC};
+        constexpr std::array<std::uint8_t, 3> SideBits{KnownField::SideA, KnownField::SideB, KnownField::SideC};
+        constexpr std::array<std::uint8_t, 3> AngleBits{KnownField::AngleA, KnownField::AngleB, KnownField::AngleC};
+
+        // powers of ten a double holds exactly
+        constexpr std::array<double, 16> ExactPowersOfTen{1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                                          1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+        enum CharClass : std::uint8_t
+        {
+            Space = 1,
+            Digit = 2,
+            NumberChar = 4 // digits, sign, point and exponent
+        };
+
+        constexpr std::array<std::uint8_t, 256> CharClasses = []
+        {
+            std::array<std::uint8_t, 256> classes{};
+            for (const unsigned char c : std::string_view(" \n\r\t"))
+            {
+                classes[c] = Space;
+            }
+            for (unsigned char c = '0'; c <= '9'; ++c)
+            {
+                classes[c] = Digit | NumberChar;
+            }
+            for (const unsigned char c : std::string_view(".-+eE"))
+            {
+                classes[c] = NumberChar;
+            }
+            return classes;
+        }();
+
+        bool Is(char c, CharClass charClass)
+        {
+            return (CharClasses[static_cast<unsigned char>(c)] & charClass) != 0;
+        }
+
+        constexpr std::uint64_t EightSpaces = 0x2020202020202020;
+
+        const char* SkipSpace(const char* p, const char* last)
+        {
+            while (p != last && Is(*p, Space))
+            {
+                ++p;
+                // the indentation of pretty printed input, eight spaces at a time
+                std::uint64_t word = 0;
+                while (last - p >= 8 && (std::memcpy(&word, p, sizeof(word)), word == EightSpaces))
+                {
+                    p += sizeof(word);
+                }
+            }
+            return p;
+        }
+
+        // Scan the number at first and parse it in the same pass: plain decimals of up to 15 digits are an exact
+        // integer divided by an exact power of ten, and that one division is correctly rounded (Clinger's fast path).
+        // Exponents and longer numbers go to from_chars. Returns the end of the number, valid is false if the
+        // number characters there are not a number (or out of range).
+        const char* ScanNumber(const char* first, const char* last, double& value, bool& valid)
+        {
+            const char* p = first;
+            const bool negative = *p == '-';
+            p += negative ? 1 : 0;
+
+            std::uint64_t mantissa = 0;
+            const char* integerBegin = p;
+            while (p != last && Is(*p, Digit))
+            {
+                mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p++ - '0');
+            }
+            const auto integer = static_cast<std::size_t>(p - integerBegin);
+            std::size_t fraction = 0;
+            bool point = false;
+            if (p != last && *p == '.')
+            {
+                point = true;
+                const char* fractionBegin = ++p;
+                while (p != last && Is(*p, Digit))
+                {
+                    mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p++ - '0');
+                }
+                fraction = static_cast<std::size_t>(p - fractionBegin);
+            }
+            if ((p == last || !Is(*p, NumberChar)) && integer > 0 && (!point || fraction > 0) &&
+                integer + fraction < ExactPowersOfTen.size())
+            {
+                value = static_cast<double>(mantissa) / ExactPowersOfTen[fraction];
+                value = negative ? -value : value;
+                valid = true;
+                return p;
+            }
+
+            while (p != last && Is(*p, NumberChar))
+            {
+                ++p;
+            }
+            const auto [ptr, ec] = std::from_chars(first, p, value);
+            valid = ec == std::errc{} && ptr == p;
+            return p;
+        }
+
+        void SetValue(CompactTriangle& triangle, bool side, std::size_t index, double value)
+        {
+            triangle.*(side ? SideMembers : AngleMembers)[index] = value;
+            triangle.known |= (side ? SideBits : AngleBits)[index];
+        }
+
+        // The common sides or angles array in one go: three numbers or nulls, all in the buffer.
+        // p is just past the '['. Returns the end of the array, nullptr for anything else (left to the
+        // token by token path, which also finds the errors).
+        const char* ScanTriple(const char* p, const char* last, std::array<double, 3>& values, std::uint8_t& known)
+        {
+            known = 0;
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                p = SkipSpace(p, last);
+                if (p == last)
+                {
+                    return nullptr;
+                }
+                if (*p == 'n')
+                {
+                    if (last - p < 4 || std::memcmp(p, "null", 4) != 0)
+                    {
+                        return nullptr;
+                    }
+                    p += 4;
+                }
+                else
+                {
+                    bool valid = false;
+                    if (!Is(*p, NumberChar) || (p = ScanNumber(p, last, values[i], valid), !valid))
+                    {
+                        return nullptr;
+                    }
+                    known |= static_cast<std::uint8_t>(1u << i);
+                }
+                // a number cut off by the end of the buffer has no separator after it
+                p = SkipSpace(p, last);
+                if (p == last || *p != (i + 1 < values.size() ? ',' : ']'))
+                {
+                    return nullptr;
+                }
+                ++p;
+            }
+            return p;
+        }
+    } // namespace
+
+    struct TriangleJsonReader::Parser
+    {
+        std::istream* input = nullptr;
+        std::vector<char> buffer;
+        const char* data = nullptr;
+        std::size_t size = 0;
+        std::size_t pos = 0;
+        std::size_t dropped = 0; // bytes moved out of the front of the buffer
+        bool ended = false;      // nothing follows data[size)
+        ResultCode status = ResultCode::Success;
+        JsonReadStats stats;
+        std::vector<Frame> stack;
+
+        std::size_t offset() const noexcept { return dropped + pos; }
+
+        void fail(std::string_view reason)
+        {
+            LOGIFACE_LOGF(error, "Reading triangle JSON failed at byte {}: {}", offset(), reason);
+            status = ResultCode::InvalidData;
+        }
+
+        // keep the unread rest, append the next block; false once the input is exhausted
+        bool refill()
+        {
+            if (ended)
+            {
+                return false;
+            }
+            const std::size_t rest = size - pos;
+            std::memmove(buffer.data(), buffer.data() + pos, rest);
+            dropped += pos;
+            pos = 0;
+            if (rest == buffer.size())
+            {
+                // a single token longer than the buffer
+                buffer.resize(buffer.size() * 2);
+            }
+            input->read(buffer.data() + rest, static_cast<std::streamsize>(buffer.size() - rest));
+            const auto count = static_cast<std::size_t>(input->gcount());
+            data = buffer.data();
+            size = rest + count;
+            if (input->bad())
+            {
+                fail("the input could not be read");
+                return false;
+            }
+            ended = count == 0;
+            return count > 0;
+        }
+
+        // the slot of a value starting here, false if no value may start here
+        bool beginValue(Slot& slot)
+        {
+            slot = Slot::Other;
+            if (stack.empty())
+            {
+                return true;
+            }
+            const Frame& top = stack.back();
+            if (top.object)
+            {
+                if (top.expect != Expect::Value)
+                {
+                    return false;
+                }
+                slot = top.role == Role::Sides ? Slot::SidesArray : top.role == Role::Angles ? Slot::AnglesArray : Slot::Other;
+                return true;
+            }
+            if (top.expect != Expect::Value && top.expect != Expect::ValueOrEnd)
+            {
+                return false;
+            }
+            slot = top.role == Role::Sides ? Slot::SideValue : top.role == Role::Angles ? Slot::AngleValue : Slot::Other;
+            return true;
+        }
+
+        // the object a slot belongs to: it holds the array, or the array holding the value
+        Frame& triangleOf(Slot slot)
+        {
+            return slot == Slot::SideValue || slot == Slot::AngleValue ? stack[stack.size() - 2] : stack.back();
+        }
+
+        // a number (or null, known false) for a slot
+        void storeValue(Slot slot, bool known, double value, bool valid)
+        {
+            if (slot == Slot::Other)
+            {
+                return;
+            }
+            Frame& triangle = triangleOf(slot);
+            triangle.triangle = true;
+            if (slot == Slot::SidesArray || slot == Slot::AnglesArray)
+            {
+                // "sides": null leaves all three unknown, a single number is not a triangle
+                triangle.malformed |= known || !valid;
+                return;
+            }
+            const std::size_t index = stack.back().count;
+            if (!valid || index >= 3)
+            {
+                triangle.malformed = true;
+                return;
+            }
+            if (known)
+            {
+                SetValue(triangle.value, slot == Slot::SideValue, index, value);
+            }
+        }
+
+        // a value ended, the enclosing container waits for a comma or its end
+        void endValue()
+        {
+            if (stack.empty())
+            {
+                return;
+            }
+            Frame& top = stack.back();
+            top.expect = Expect::CommaOrEnd;
+            if (!top.object && top.count < 255)
+            {
+                ++top.count;
+            }
+        }
+
+        bool push(Frame frame)
+        {
+            if (stack.size() == MaxDepth)
+            {
+                fail("nesting too deep");
+                return false;
+            }
+            stack.push_back(frame);
+            return true;
+        }
+
+        void emit(const TriangleColumns& rows, std::size_t row, const Frame& frame)
+        {
+            ++stats.triangles;
+            if (frame.malformed)
+            {
+                LOGIFACE_LOGF(warn, "Malformed triangle object ending at byte {}, it is read as unknown", offset());
+                ++stats.malformed;
+                rows.set(row, CompactTriangle{});
+                rows.codes[row] = ResultCode::InvalidData;
+                return;
+            }
+            rows.set(row, frame.value);
+        }
+
+        std::size_t read(const TriangleColumns& rows)
+        {
+            std::size_t filled = 0;
+            while (filled < rows.size() && status == ResultCode::Success)
+            {
+                pos = static_cast<std::size_t>(SkipSpace(data + pos, data + size) - data);
+                if (pos == size)
+                {
+                    if (!refill())
+                    {
+                        if (status == ResultCode::Success && !stack.empty())
+                        {
+                            fail("the input ended inside a value");
+                        }
+                        break;
+                    }
+                    continue;
+                }
+
+                const char c = data[pos];
+                Slot slot = Slot::Other;
+                switch (c)
+                {
+                case '{':
+                case '[':
+                {
+                    if (!beginValue(slot))
+                    {
+                        fail("unexpected value");
+                        break;
+                    }
+                    Frame frame;
+                    frame.object = c == '{';
+                    frame.expect = frame.object ? Expect::KeyOrEnd : Expect::ValueOrEnd;
+                    if (!frame.object && (slot == Slot::SidesArray || slot == Slot::AnglesArray))
+                    {
+                        std::array<double, 3> values{};
+                        std::uint8_t known = 0;
+                        if (const char* end = ScanTriple(data + pos + 1, data + size, values, known))
+                        {
+                            Frame& triangle = triangleOf(slot);
+                            triangle.triangle = true;
+                            for (std::size_t i = 0; i < values.size(); ++i)
+                            {
+                                if ((known >> i) & 1u)
+                                {
+                                    SetValue(triangle.value, slot == Slot::SidesArray, i, values[i]);
+                                }
+                            }
+                            endValue();
+                            pos = static_cast<std::size_t>(end - data);
+                            break;
+                        }
+                        frame.role = slot == Slot::SidesArray ? Role::Sides : Role::Angles;
+                        triangleOf(slot).triangle = true;
+                    }
+                    else
+                    {
+                        // a container where a number belongs
+                        storeValue(slot, false, 0.0, false);
+                    }
+                    if (push(frame))
+                    {
+                        ++pos;
+                    }
+                    break;
+                }
+                case '}':
+                case ']':
+                {
+                    const bool object = c == '}';
+                    if (stack.empty() || stack.back().object != object ||
+                        (stack.back().expect != Expect::CommaOrEnd &&
+                         stack.back().expect != (object ? Expect::KeyOrEnd : Expect::ValueOrEnd)))
+                    {
+                        fail("unexpected end of a container");
+                        break;
+                    }
+                    const Frame frame = stack.back();
+                    stack.pop_back();
+                    ++pos;
+                    if (object && frame.triangle)
+                    {
+                        emit(rows, filled++, frame);
+                    }
+                    else if (!object && frame.role != Role::None && frame.count != 3)
+                    {
+                        stack.back().malformed = true;
+                    }
+                    endValue();
+                    break;
+                }
+                case ':':
+                    if (stack.empty() || !stack.back().object || stack.back().expect != Expect::Colon)
+                    {
+                        fail("unexpected ':'");
+                        break;
+                    }
+                    stack.back().expect = Expect::Value;
+                    ++pos;
+                    break;
+                case ',':
+                    if (stack.empty() || stack.back().expect != Expect::CommaOrEnd)
+                    {
+                        fail("unexpected ','");
+                        break;
+                    }
+                    stack.back().expect = stack.back().object ? Expect::Key : Expect::Value;
+                    stack.back().role = stack.back().object ? Role::None : stack.back().role;
+                    ++pos;
+                    break;
+                case '"':
+                {
+                    // find the closing quote, skipping escaped characters
+                    std::size_t end = pos + 1;
+                    while (end < size && data[end] != '"')
+                    {
+                        end += data[end] == '\\' ? 2 : 1;
+                    }
+                    if (end >= size)
+                    {
+                        if (!refill())
+                        {
+                            fail("unterminated string");
+                        }
+                        break;
+                    }
+                    const std::string_view text(data + pos + 1, end - pos - 1);
+                    const bool key = !stack.empty() && stack.back().object &&
+                                     (stack.back().expect == Expect::KeyOrEnd || stack.back().expect == Expect::Key);
+                    if (key)
+                    {
+                        Frame& top = stack.back();
+                        top.role = text == "sides" ? Role::Sides : text == "angles" ? Role::Angles : Role::None;
+                        top.expect = Expect::Colon;
+                    }
+                    else if (beginValue(slot))
+                    {
+                        storeValue(slot, false, 0.0, false);
+                        endValue();
+                    }
+                    else
+                    {
+                        fail("unexpected string");
+                        break;
+                    }
+                    pos = end + 1;
+                    break;
+                }
+                case 't':
+                case 'f':
+                case 'n':
+                {
+                    const std::string_view literal = c == 't' ? "true" : c == 'f' ? "false" : "null";
+                    if (size - pos < literal.size() && refill())
+                    {
+                        break;
+                    }
+                    if (std::string_view(data + pos, std::min(literal.size(), size - pos)) != literal || !beginValue(slot))
+                    {
+                        fail("unexpected literal");
+                        break;
+                    }
+                    storeValue(slot, false, 0.0, c == 'n');
+                    endValue();
+                    pos += literal.size();
+                    break;
+                }
+                default:
+                {
+                    if (!Is(c, NumberChar))
+                    {
+                        fail("unexpected character");
+                        break;
+                    }
+                    double value = 0.0;
+                    bool valid = false;
+                    const char* end = ScanNumber(data + pos, data + size, value, valid);
+                    // a number running into the end of the buffer may go on in the next block
+                    if (end == data + size && !ended)
+                    {
+                        refill();
+                        break;
+                    }
+                    if (!beginValue(slot))
+                    {
+                        fail("unexpected number");
+                        break;
+                    }
+                    storeValue(slot, true, value, valid);
+                    endValue();
+                    pos = static_cast<std::size_t>(end - data);
+                    break;
+                }
+                }
+            }
+            stats.bytes = offset();
+            return filled;
+        }
+    };
+
+    TriangleJsonReader::TriangleJsonReader(std::istream& input) : parser_(std::make_unique<Parser>())
+    {
+        parser_->input = &input;
+        parser_->buffer.resize(BlockSize);
+        parser_->data = parser_->buffer.data();
+    }
+
+    TriangleJsonReader::TriangleJsonReader(std::string_view text) : parser_(std::make_unique<Parser>())
+    {
+        parser_->data = text.data();
+        parser_->size = text.size();
+        parser_->ended = true;
+    }
+
+    TriangleJsonReader::~TriangleJsonReader() = default;
+
+    std::size_t TriangleJsonReader::read(const TriangleColumns& rows)
+    {
+        return parser_->read(rows);
+    }
+
+    ResultCode TriangleJsonReader::status() const noexcept
+    {
+        return parser_->status;
+    }
+
+    const JsonReadStats& TriangleJsonReader::stats() const noexcept
+    {
+        return parser_->stats;
+    }
+} // namespace TriangleCalculatorLib
@@ -0,0 +1,94 @@
+#include "TriangleKernels.hpp"
+
+#include <TriangleCalculatorLib/SimdLevel.hpp>
+
+#include <atomic>
+
+namespace TriangleCalculatorLib
+{
+    namespace
+    {
+        SimdLevel DetectSimdLevel() noexcept
+        {
+#if defined(TRIANGLE_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+            {
+                return SimdLevel::AVX512;
+            }
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            {
+                return SimdLevel::AVX2;
+            }
+            return SimdLevel::SSE2; // part of the x86-64 baseline
+#else
+            return SimdLevel::Scalar;
+#endif
+        }
+
+        // the CPU is probed once, on first use
+        std::atomic<SimdLevel>& ActiveLevel() noexcept
+        {
+            static std::atomic<SimdLevel> level{detectedSimdLevel()};
+            return level;
+        }
+    } // namespace
+
+    SimdLevel detectedSimdLevel() noexcept
+    {
+        static const SimdLevel detected = DetectSimdLevel();
+        return detected;
+    }
+
+    SimdLevel activeSimdLevel() noexcept
+    {
+        return ActiveLevel().load(std::memory_order_relaxed);
+    }
+
+    bool setSimdLevel(SimdLevel level) noexcept
+    {
+        if (static_cast<int>(level) > static_cast<int>(detectedSimdLevel()))
+        {
+            return false;
+        }
+        ActiveLevel().store(level, std::memory_order_relaxed);
+        return true;
+    }
+
+    const TriangleKernelTable& KernelsFor(SimdLevel level, Precision precision) noexcept
+    {
+        const bool fast = precision == Precision::Fast;
+        switch (level)
+        {
+#if defined(TRIANGLE_KERNELS_X86)
+            case SimdLevel::AVX512: return fast ? Kernels::AVX512::FastTable : Kernels::AVX512::Table;
+            case SimdLevel::AVX2: return fast ? Kernels::AVX2::FastTable : Kernels::AVX2::Table;
+            case SimdLevel::SSE2: return fast ? Kernels::SSE2::FastTable : Kernels::SSE2::Table;
+#endif
+            default: return fast ? Kernels::Scalar::FastTable : Kernels::Scalar::Table;
+        }
+    }
+
+    const TriangleKernelTable& ActiveKernels(Precision precision) noexcept
+    {
+        return KernelsFor(activeSimdLevel(), precision);
+    }
+
+    const TriangleFloatKernelTable& FloatKernelsFor(SimdLevel level) noexcept
+    {
+        switch (level)
+        {
+#if defined(TRIANGLE_KERNELS_X86)
+            case SimdLevel::AVX512: return Kernels::AVX512::FloatTable;
+            case SimdLevel::AVX2: return Kernels::AVX2::FloatTable;
+            case SimdLevel::SSE2: return Kernels::SSE2::FloatTable;
+#endif
+            default: return Kernels::Scalar::FloatTable;
+        }
+    }
+
+    const TriangleFloatKernelTable& ActiveFloatKernels() noexcept
+    {
+        return FloatKernelsFor(activeSimdLevel());
+    }
+} // namespace TriangleCalculatorLib
@@ -0,0 +1,57 @@
+#ifndef TRIANGLE_KERNELS_HPP
+#define TRIANGLE_KERNELS_HPP
+
+#include <TriangleCalculatorLib/SimdLevel.hpp>
+#include <TriangleCalculatorLib/Triangle.hpp>
+
+#include <cstddef>
+
+namespace TriangleCalculatorLib
+{
+    // Straight-line solvers for runs of triangles that are all in the same case, in canonical rotation.
+    // All angles are in radians.
+    // The float solvers of Precision::Mixed also write a condition estimate per triangle: how many float
+    // roundings the worst solved value is off by, at most (NaN or infinity when float does not work at all).
+    // The double solvers leave condition alone, it may be null for them.
+    template <typename T>
+    struct BasicTriangleKernelTable
+    {
+        // SSS: all three sides known, no angles known. Writes all three angles.
+        void (*solveSSS)(const T* sideA, const T* sideB, const T* sideC,
+                         T* angleA, T* angleB, T* angleC, T* condition, std::size_t count);
+
+        // SAS: sides b and c known with the included angle A. Writes side a and angles B and C.
+        void (*solveSAS)(T* sideA, const T* sideB, const T* sideC,
+                         const T* angleA, T* angleB, T* angleC, T* condition, std::size_t count);
+
+        // ASA/AAS: side a and all three angles known. Writes sides b and c.
+        void (*solveAAS)(const T* sideA, T* sideB, T* sideC,
+                         const T* angleA, const T* angleB, const T* angleC, T* condition, std::size_t count);
+    };
+
+    using TriangleKernelTable = BasicTriangleKernelTable<double>;
+    using TriangleFloatKernelTable = BasicTriangleKernelTable<float>;
+
+    namespace Kernels
+    {
+        // Table solves with the exact VectorMath functions, FastTable with FastMath, FloatTable with the float VectorMath ones
+        namespace Scalar { extern const TriangleKernelTable Table, FastTable; extern const TriangleFloatKernelTable FloatTable; }
+#if defined(TRIANGLE_KERNELS_X86)
+        namespace SSE2 { extern const TriangleKernelTable Table, FastTable; extern const TriangleFloatKernelTable FloatTable; }
+        namespace AVX2 { extern const TriangleKernelTable Table, FastTable; extern const TriangleFloatKernelTable FloatTable; }
+        namespace AVX512 { extern const TriangleKernelTable Table, FastTable; extern const TriangleFloatKernelTable FloatTable; }
+#endif
+    } // namespace Kernels
+
+    // kernel table for the active SIMD level (Mixed gets the exact table, for the lanes float can not solve)
+    const TriangleKernelTable& ActiveKernels(Precision precision = Precision::Exact) noexcept;
+
+    // kernel table for a specific level, the scalar table if that level is not compiled in
+    const TriangleKernelTable& KernelsFor(SimdLevel level, Precision precision = Precision::Exact) noexcept;
+
+    // float kernel table of Precision::Mixed, for the active SIMD level and for a specific one
+    const TriangleFloatKernelTable& ActiveFloatKernels() noexcept;
+    const TriangleFloatKernelTable& FloatKernelsFor(SimdLevel level) noexcept;
+} // namespace TriangleCalculatorLib
+
+#endif // TRIANGLE_KERNELS_HPP
@@ -0,0 +1,2 @@
+#define TRIANGLE_KERNEL_NAMESPACE AVX2
+#include "TriangleKernelsImpl.hpp"
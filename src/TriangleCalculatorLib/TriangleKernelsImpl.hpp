@@ -0,0 +1,182 @@
+// Kernel bodies shared by every TriangleKernels<ISA>.cpp translation unit.
+// Each unit defines TRIANGLE_KERNEL_NAMESPACE and is compiled with its own instruction set flags,
+// the loops are written without branches so the compiler vectorizes them for that instruction set.
+#ifndef TRIANGLE_KERNEL_NAMESPACE
+#error "TRIANGLE_KERNEL_NAMESPACE must be defined before including TriangleKernelsImpl.hpp"
+#endif
+
+#include "TriangleKernels.hpp"
+#include "VectorMath.hpp"
+
+#include <TriangleCalculatorLib/FastMath.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <type_traits>
+
+namespace TriangleCalculatorLib::Kernels::TRIANGLE_KERNEL_NAMESPACE
+{
+    namespace
+    {
+        template <typename T>
+        inline T Clamp(T value, T low, T high)
+        {
+            value = value < low ? low : value;
+            return value > high ? high : value;
+        }
+
+        template <typename T>
+        inline T Min(T x, T y) { return x < y ? x : y; }
+
+        template <typename T>
+        inline T Max(T x, T y) { return x > y ? x : y; }
+
+        // only the float kernels of Precision::Mixed estimate their condition
+        template <typename T>
+        constexpr bool EstimatesCondition = std::is_same_v<T, float>;
+
+        // FastMath for this unit alone: the one of the library is compiled without these instruction set flags
+        struct KernelUnit;
+        using FastMath = TriangleCalculatorLib::detail::BasicFastMath<KernelUnit>;
+
+        // the trig functions of Precision::Exact (and Mixed in float), the kernels take either this or FastMath
+        struct ExactMath
+        {
+            template <typename T> static T sin(T x) { return VectorMath::Sin(x); }
+            template <typename T> static T cos(T x) { return VectorMath::Cos(x); }
+            template <typename T> static T asin(T x) { return VectorMath::Asin(x); }
+            template <typename T> static T acos(T x) { return VectorMath::Acos(x); }
+        };
+
+        // The condition estimates bound the error of every solved value relative to that value, in float roundings:
+        // law of cosines  cos L = (P^2 + Q^2 - L^2) / 2PQ is off by (P^2 + Q^2 + L^2) / 2PQ roundings, L by that over sin L
+        // law of sines    sin X is off by the relative errors of its factors, X by tan X times that
+        // third angle     pi - X - Y carries the absolute errors of X and Y, relative to the smallest angle
+        // and the sine of an angle X off by one rounding is off by X / sin X roundings.
+        // A third angle that rounds to 0 or below gives an infinite estimate.
+
+        // mirrors SolveAnglesWithSides in TriangleCalculatorBackend.cpp with no angle known:
+        // the angle opposite the largest side comes from the law of cosines, the next one from the law of sines
+        template <typename Math, typename T>
+        void SolveSSS(const T* __restrict sideA, const T* __restrict sideB, const T* __restrict sideC,
+                      T* __restrict angleA, T* __restrict angleB, T* __restrict angleC, T* __restrict condition,
+                      std::size_t count)
+        {
+            constexpr T pi = std::numbers::pi_v<T>;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const T a = sideA[i];
+                const T b = sideB[i];
+                const T c = sideC[i];
+
+                // rotate so that the largest side (first one on ties) is L, followed by P and Q
+                const bool bLargest = b > a && b >= c;
+                const bool cLargest = !bLargest && c > a;
+                const T L = bLargest ? b : (cLargest ? c : a);
+                const T P = bLargest ? c : (cLargest ? a : b);
+                const T Q = bLargest ? a : (cLargest ? b : c);
+
+                const T cosL = Clamp((P * P + (Q * Q - L * L)) / (2 * P * Q), T(-1), T(1));
+                const T angL = Math::acos(cosL);
+                const T sinL = Math::sin(angL);
+                const T sinP = Clamp(P * (sinL / L), T(-1), T(1));
+                const T angP = Math::asin(sinP);
+                const T angQ = (pi - angL) - angP;
+
+                angleA[i] = bLargest ? angQ : (cLargest ? angP : angL);
+                angleB[i] = bLargest ? angL : (cLargest ? angQ : angP);
+                angleC[i] = bLargest ? angP : (cLargest ? angL : angQ);
+
+                if constexpr (EstimatesCondition<T>)
+                {
+                    const T errorL = (P * P + Q * Q + L * L) / (2 * P * Q * std::abs(sinL));
+                    const T cosP = std::sqrt(1 - sinP * sinP);
+                    const T errorP = (3 + errorL * std::abs(cosL / sinL)) * std::abs(sinP) / cosP;
+                    condition[i] = (errorL + errorP + 4) / Max(Min(angQ, angP), T(0));
+                }
+            }
+        }
+
+        // mirrors SolveSideWithAngleCos followed by SolveAnglesWithSides
+        template <typename Math, typename T>
+        void SolveSAS(T* __restrict sideA, const T* __restrict sideB, const T* __restrict sideC,
+                      const T* __restrict angleA, T* __restrict angleB, T* __restrict angleC, T* __restrict condition,
+                      std::size_t count)
+        {
+            constexpr T pi = std::numbers::pi_v<T>;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const T b = sideB[i];
+                const T c = sideC[i];
+                const T A = angleA[i];
+
+                const T cosA = Math::cos(A);
+                const T subtractor = 2 * b * c * cosA;
+                const T squared = b * b + (c * c - subtractor);
+                const T a = std::sqrt(squared > T(0) ? squared : T(0));
+
+                const bool bLargest = b > a && b >= c;
+                const bool cLargest = !bLargest && c > a;
+
+                // a largest: B from the law of sines
+                const T sinA = Math::sin(A);
+                const T sinB = Clamp(b * (sinA / a), T(-1), T(1));
+                const T lawOfSinesB = Math::asin(sinB);
+
+                // b or c largest: the angle opposite it from the law of cosines
+                const T L = bLargest ? b : c;
+                const T P = bLargest ? c : a;
+                const T Q = bLargest ? a : b;
+                const T cosL = Clamp((P * P + (Q * Q - L * L)) / (2 * P * Q), T(-1), T(1));
+                const T angL = Math::acos(cosL);
+
+                const T B = bLargest ? angL : (cLargest ? (pi - angL) - A : lawOfSinesB);
+                const T C = cLargest ? angL : (bLargest ? (pi - angL) - A : (pi - A) - lawOfSinesB);
+
+                sideA[i] = a;
+                angleB[i] = B;
+                angleC[i] = C;
+
+                if constexpr (EstimatesCondition<T>)
+                {
+                    const T errorA = (b * b + c * c + 2 * b * c) / (a * a) + A / sinA;
+                    const T sinL = std::sqrt(1 - cosL * cosL);
+                    const T errorL = (1 + errorA) * (P * P + Q * Q + L * L) / (2 * P * Q * sinL);
+                    const T cosB = std::sqrt(1 - sinB * sinB);
+                    const T errorB = (3 + errorA + A / sinA) * sinB / cosB;
+                    const T errorAngle = (bLargest || cLargest ? errorL : errorB) + 4;
+                    condition[i] = Max(errorA, errorAngle / Max(Min(B, C), T(0)));
+                }
+            }
+        }
+
+        // mirrors SolveSides: both remaining sides from the law of sines, the caller keeps the ones that were known
+        template <typename Math, typename T>
+        void SolveAAS(const T* __restrict sideA, T* __restrict sideB, T* __restrict sideC,
+                      const T* __restrict angleA, const T* __restrict angleB, const T* __restrict angleC,
+                      T* __restrict condition, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const T a = sideA[i];
+                const T sinA = Math::sin(angleA[i]);
+                const T sinB = Math::sin(angleB[i]);
+                const T sinC = Math::sin(angleC[i]);
+                sideB[i] = (a * sinB) / sinA;
+                sideC[i] = (a * sinC) / sinA;
+
+                if constexpr (EstimatesCondition<T>)
+                {
+                    const T errorB = angleB[i] / sinB;
+                    const T errorC = angleC[i] / sinC;
+                    condition[i] = 4 + angleA[i] / sinA + Max(errorB, errorC);
+                }
+            }
+        }
+    } // namespace
+
+    extern const TriangleKernelTable Table{&SolveSSS<ExactMath, double>, &SolveSAS<ExactMath, double>, &SolveAAS<ExactMath, double>};
+    extern const TriangleKernelTable FastTable{&SolveSSS<FastMath, double>, &SolveSAS<FastMath, double>, &SolveAAS<FastMath, double>};
+    extern const TriangleFloatKernelTable FloatTable{&SolveSSS<ExactMath, float>, &SolveSAS<ExactMath, float>, &SolveAAS<ExactMath, float>};
+} // namespace TriangleCalculatorLib::Kernels::TRIANGLE_KERNEL_NAMESPACE
@@ -0,0 +1,2 @@
+#define TRIANGLE_KERNEL_NAMESPACE SSE2
+#include "TriangleKernelsImpl.hpp"
@@ -0,0 +1,2 @@
+#define TRIANGLE_KERNEL_NAMESPACE Scalar
+#include "TriangleKernelsImpl.hpp"
@@ -0,0 +1,761 @@
+#include <TriangleCalculatorLib/TriangleServer.hpp>
+
+#include <TriangleCalculatorLib/ThreadPool.hpp>
+#include <TriangleCalculatorLib/TriangleCalculator.hpp>
+#include <TriangleCalculatorLib/TriangleStream.hpp>
+
+#include <logging/logging.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define TRIANGLE_SERVER_EPOLL 1
+#endif
+
+namespace TriangleCalculatorLib
+{
+    namespace
+    {
+        static_assert(std::endian::native == std::endian::little, "the server protocol is little endian");
+
+        constexpr std::size_t MaxLineLength = 64 * 1024;
+        constexpr std::size_t ReadBlockSize = 64 * 1024;
+        // stop reading from a client with this many binary requests still on the pool
+        constexpr std::size_t MaxPendingJobs = 64;
+        constexpr int MaxEvents = 64;
+
+        // epoll data of the two descriptors that are not connections, connections count up from FirstConnectionId
+        constexpr std::uint64_t ListenerId = 0;
+        constexpr std::uint64_t WakeId = 1;
+        constexpr std::uint64_t FirstConnectionId = 2;
+
+        // record order of the values on the wire
+        constexpr std::array<double CompactTriangle::*, 6> WireValues{&CompactTriangle::sideA,  &CompactTriangle::sideB,
+                                                                      &CompactTriangle::sideC,  &CompactTriangle::angleA,
+                                                                      &CompactTriangle::angleB, &CompactTriangle::angleC};
+
+        template <typename T>
+        void Store(char* out, T value)
+        {
+            std::memcpy(out, &value, sizeof(value));
+        }
+
+        template <typename T>
+        T Load(const char* in)
+        {
+            T value;
+            std::memcpy(&value, in, sizeof(value));
+            return value;
+        }
+
+        void WriteHeader(char* out, std::uint32_t count)
+        {
+            out[0] = static_cast<char>(ServerProtocol::FrameMarker);
+            out[1] = out[2] = out[3] = 0;
+            Store(out + 4, count);
+        }
+
+        void WriteValues(char* out, const CompactTriangle& triangle)
+        {
+            for (std::size_t i = 0; i < WireValues.size(); ++i)
+            {
+                Store(out + i * sizeof(double), triangle.*WireValues[i]);
+            }
+        }
+
+        void ReadValues(const char* in, CompactTriangle& triangle)
+        {
+            for (std::size_t i = 0; i < WireValues.size(); ++i)
+            {
+                triangle.*WireValues[i] = Load<double>(in + i * sizeof(double));
+            }
+        }
+
+#if defined(TRIANGLE_SERVER_EPOLL)
+        CompactTriangle ReadRequestRecord(const char* in)
+        {
+            CompactTriangle triangle;
+            triangle.known = static_cast<std::uint8_t>(in[0]) & KnownField::All;
+            ReadValues(in + 1, triangle);
+            return triangle;
+        }
+
+        void WriteReplyRecord(char* out, const CompactTriangle& triangle, ResultCode code)
+        {
+            out[0] = static_cast<char>(code);
+            out[1] = static_cast<char>(triangle.known);
+            WriteValues(out + 2, triangle);
+        }
+
+        std::string_view TrimLine(std::string_view line)
+        {
+            const std::size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string_view::npos)
+            {
+                return {};
+            }
+            return line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+        }
+
+        void CloseDescriptor(int& fd)
+        {
+            if (fd >= 0)
+            {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+
+        // a binary request split over the pool, every piece writes its records straight into the reply
+        struct Job
+        {
+            std::vector<CompactTriangle> triangles;
+            std::vector<ResultCode> codes;
+            std::string reply;
+            std::atomic<std::size_t> remaining{0}; // pieces still running
+        };
+
+        // a reply still on the pool and the inline replies to the requests after it, sent once it is done
+        struct PendingReply
+        {
+            std::shared_ptr<Job> job;
+            std::string after;
+        };
+
+        struct Connection
+        {
+            std::uint64_t id = 0;
+            int fd = -1;
+            std::string input;
+            std::size_t inputPos = 0;
+            std::string output;
+            std::size_t outputPos = 0;
+            std::deque<PendingReply> pending;
+            std::uint32_t events = 0; // registered with epoll
+            bool hungUp = false;      // the client sent everything, close once it has its replies
+        };
+#endif
+    } // namespace
+
+    void ServerProtocol::appendRequest(std::string& out, std::span<const CompactTriangle> triangles)
+    {
+        const std::size_t begin = out.size();
+        out.resize(begin + HeaderSize + triangles.size() * RequestRecordSize);
+        char* record = out.data() + begin;
+        WriteHeader(record, static_cast<std::uint32_t>(triangles.size()));
+        record += HeaderSize;
+        for (const CompactTriangle& triangle : triangles)
+        {
+            record[0] = static_cast<char>(triangle.known);
+            WriteValues(record + 1, triangle);
+            record += RequestRecordSize;
+        }
+    }
+
+    std::size_t ServerProtocol::parseReply(std::string_view input, std::vector<CompactTriangle>& triangles,
+                                           std::vector<ResultCode>& codes)
+    {
+        if (input.size() < HeaderSize || static_cast<std::uint8_t>(input[0]) != FrameMarker)
+        {
+            return 0;
+        }
+        const auto count = Load<std::uint32_t>(input.data() + 4);
+        const std::size_t size = HeaderSize + std::size_t{count} * ReplyRecordSize;
+        if (input.size() < size)
+        {
+            return 0;
+        }
+        for (const char* record = input.data() + HeaderSize; record != input.data() + size; record += ReplyRecordSize)
+        {
+            CompactTriangle triangle;
+            triangle.known = static_cast<std::uint8_t>(record[1]);
+            ReadValues(record + 2, triangle);
+            triangles.push_back(triangle);
+            codes.push_back(static_cast<ResultCode>(record[0]));
+        }
+        return size;
+    }
+
+#if defined(TRIANGLE_SERVER_EPOLL)
+    struct TriangleServer::Loop
+    {
+        ServerOptions options;
+        int listener = -1;
+        int epoll = -1;
+        int wake = -1; // eventfd: stop() and finished pool jobs
+        bool listening = false;
+        std::atomic<bool> stopping{false};
+
+        std::unordered_map<std::uint64_t, Connection> connections;
+        std::uint64_t nextId = FirstConnectionId;
+
+        // scratch of the requests solved on the event loop
+        std::vector<CompactTriangle> triangles;
+        std::vector<ResultCode> codes;
+
+        // shared with the pool
+        std::mutex mutex;
+        std::condition_variable idle;
+        std::size_t inFlight = 0;              // pieces submitted and not finished
+        std::vector<std::uint64_t> completed;  // connections with a finished job
+
+        ~Loop()
+        {
+            closeAll();
+            CloseDescriptor(wake);
+        }
+
+        void signal() noexcept
+        {
+            const std::uint64_t one = 1;
+            [[maybe_unused]] const ssize_t written = ::write(wake, &one, sizeof(one));
+        }
+
+        ResultCode fail(std::string_view what)
+        {
+            LOGIFACE_LOGF(error, "Triangle server: {} failed: {}", what, std::string_view(std::strerror(errno)));
+            CloseDescriptor(listener);
+            CloseDescriptor(epoll);
+            return ResultCode::InvalidData;
+        }
+
+        bool watch(int fd, std::uint64_t id, std::uint32_t events, int operation)
+        {
+            epoll_event event{};
+            event.events = events;
+            event.data.u64 = id;
+            return ::epoll_ctl(epoll, operation, fd, &event) == 0;
+        }
+
+        ResultCode listen()
+        {
+            const std::string& path = options.socketPath.native();
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            if (listening || path.empty() || path.size() >= sizeof(address.sun_path))
+            {
+                LOGIFACE_LOGF(error, "Triangle server: invalid socket path {}", std::string_view(path));
+                return ResultCode::InvalidData;
+            }
+            std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+            // a socket left behind by a server that did not shut down refuses connections, one a server still
+            // accepts on is in use; anything else is not ours to remove (bind reports it)
+            std::error_code error;
+            if (std::filesystem::is_socket(options.socketPath, error))
+            {
+                int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+                const bool accepted = probe >= 0 && ::connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+                const bool refused = !accepted && errno == ECONNREFUSED;
+                CloseDescriptor(probe);
+                if (accepted)
+                {
+                    LOGIFACE_LOGF(error, "Triangle server: address in use, another server listens on {}", std::string_view(path));
+                    return ResultCode::InvalidData;
+                }
+                if (refused)
+                {
+                    ::unlink(path.c_str());
+                }
+            }
+
+            listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (listener < 0)
+            {
+                return fail("socket");
+            }
+            if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+            {
+                return fail("bind");
+            }
+            if (::listen(listener, SOMAXCONN) != 0)
+            {
+                return fail("listen");
+            }
+            epoll = ::epoll_create1(EPOLL_CLOEXEC);
+            if (epoll < 0)
+            {
+                return fail("epoll_create1");
+            }
+            if (wake < 0)
+            {
+                wake = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            }
+            if (wake < 0)
+            {
+                return fail("eventfd");
+            }
+            if (!watch(listener, ListenerId, EPOLLIN, EPOLL_CTL_ADD) || !watch(wake, WakeId, EPOLLIN, EPOLL_CTL_ADD))
+            {
+                return fail("epoll_ctl");
+            }
+            listening = true;
+            LOGIFACE_LOGF(info, "Triangle server listening on {}", std::string_view(path));
+            return ResultCode::Success;
+        }
+
+        ResultCode run()
+        {
+            if (!listening)
+            {
+                LOGIFACE_LOG(error, "Triangle server: run() without a successful listen()");
+                return ResultCode::InvalidData;
+            }
+            ResultCode result = ResultCode::Success;
+            std::array<epoll_event, MaxEvents> events;
+            while (!stopping.load(std::memory_order_acquire))
+            {
+                const int count = ::epoll_wait(epoll, events.data(), MaxEvents, -1);
+                if (count < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    LOGIFACE_LOGF(error, "Triangle server: epoll_wait failed: {}", std::string_view(std::strerror(errno)));
+                    result = ResultCode::InvalidData;
+                    break;
+                }
+                for (int i = 0; i < count; ++i)
+                {
+                    const std::uint64_t id = events[i].data.u64;
+                    if (id == ListenerId)
+                    {
+                        accept();
+                    }
+                    else if (id == WakeId)
+                    {
+                        std::uint64_t ignored = 0;
+                        [[maybe_unused]] const ssize_t read = ::read(wake, &ignored, sizeof(ignored));
+                        finishJobs();
+                    }
+                    else
+                    {
+                        serve(id, events[i].events);
+                    }
+                }
+            }
+            closeAll();
+            return result;
+        }
+
+        // stop listening, drop every client and wait for their jobs still on the pool
+        void closeAll()
+        {
+            if (listening)
+            {
+                ::unlink(options.socketPath.c_str());
+                listening = false;
+            }
+            CloseDescriptor(listener);
+            for (auto& [id, connection] : connections)
+            {
+                CloseDescriptor(connection.fd);
+            }
+            connections.clear();
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                idle.wait(lock, [this] { return inFlight == 0; });
+                completed.clear();
+            }
+            CloseDescriptor(epoll);
+        }
+
+        void accept()
+        {
+            while (true)
+            {
+                const int fd = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0)
+                {
+                    if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                    {
+                        LOGIFACE_LOGF(warn, "Triangle server: accept failed: {}", std::string_view(std::strerror(errno)));
+                    }
+                    if (errno != EINTR)
+                    {
+                        return;
+                    }
+                    continue;
+                }
+                const std::uint64_t id = nextId++;
+                Connection& connection = connections[id];
+                connection.id = id;
+                connection.fd = fd;
+                connection.events = EPOLLIN | EPOLLRDHUP;
+                if (!watch(fd, id, connection.events, EPOLL_CTL_ADD))
+                {
+                    close(id);
+                }
+            }
+        }
+
+        void close(std::uint64_t id)
+        {
+            const auto it = connections.find(id);
+            if (it != connections.end())
+            {
+                CloseDescriptor(it->second.fd);
+                connections.erase(it);
+            }
+        }
+
+        void serve(std::uint64_t id, std::uint32_t events)
+        {
+            const auto it = connections.find(id);
+            if (it == connections.end())
+            {
+                return;
+            }
+            Connection& connection = it->second;
+            // the client is gone in both directions (or the socket failed), its replies can not be delivered
+            if ((events & (EPOLLHUP | EPOLLERR)) != 0 ||
+                ((events & (EPOLLIN | EPOLLRDHUP)) != 0 && !receive(connection)) || !send(connection))
+            {
+                close(id);
+                return;
+            }
+            update(id, connection);
+        }
+
+        // read what the client sent and answer every complete request, false to drop the client
+        bool receive(Connection& connection)
+        {
+            for (std::size_t block = 0; block < 4 && !connection.hungUp; ++block)
+            {
+                const std::size_t size = connection.input.size();
+                connection.input.resize(size + ReadBlockSize);
+                const ssize_t count = ::read(connection.fd, connection.input.data() + size, ReadBlockSize);
+                connection.input.resize(size + static_cast<std::size_t>(std::max<ssize_t>(count, 0)));
+                if (count == 0)
+                {
+                    connection.hungUp = true;
+                }
+                else if (count < 0)
+                {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    {
+                        break;
+                    }
+                    if (errno != EINTR)
+                    {
+                        return false;
+                    }
+                }
+                else if (static_cast<std::size_t>(count) < ReadBlockSize)
+                {
+                    break;
+                }
+            }
+            return handleRequests(connection);
+        }
+
+        bool handleRequests(Connection& connection)
+        {
+            while (connection.inputPos < connection.input.size())
+            {
+                const char* data = connection.input.data() + connection.inputPos;
+                const std::size_t available = connection.input.size() - connection.inputPos;
+                if (static_cast<std::uint8_t>(data[0]) == ServerProtocol::FrameMarker)
+                {
+                    if (available < ServerProtocol::HeaderSize)
+                    {
+                        break;
+                    }
+                    const auto count = Load<std::uint32_t>(data + 4);
+                    if (count > ServerProtocol::MaxFrameTriangles)
+                    {
+                        LOGIFACE_LOGF(warn, "Triangle server: dropping a client sending a batch of {} triangles", count);
+                        return false;
+                    }
+                    const std::size_t size = ServerProtocol::HeaderSize + std::size_t{count} * ServerProtocol::RequestRecordSize;
+                    if (available < size)
+                    {
+                        break;
+                    }
+                    handleFrame(connection, data + ServerProtocol::HeaderSize, count);
+                    connection.inputPos += size;
+                    continue;
+                }
+
+                const auto* newline = static_cast<const char*>(std::memchr(data, '\n', available));
+                if (newline == nullptr && !connection.hungUp)
+                {
+                    if (available > MaxLineLength)
+                    {
+                        LOGIFACE_LOG(warn, "Triangle server: dropping a client sending an overlong line");
+                        return false;
+                    }
+                    break;
+                }
+                // the last line may go without its line end
+                const std::size_t length = newline != nullptr ? static_cast<std::size_t>(newline - data) : available;
+                handleLine(connection, std::string_view(data, length));
+                connection.inputPos += std::min(available, length + 1);
+            }
+
+            if (connection.inputPos == connection.input.size())
+            {
+                connection.input.clear();
+                connection.inputPos = 0;
+            }
+            else if (connection.inputPos > connection.input.size() / 2)
+            {
+                connection.input.erase(0, connection.inputPos);
+                connection.inputPos = 0;
+            }
+            return true;
+        }
+
+        // where an inline reply goes: straight out, or behind the last reply still on the pool
+        static std::string& replies(Connection& connection)
+        {
+            return connection.pending.empty() ? connection.output : connection.pending.back().after;
+        }
+
+        void handleLine(Connection& connection, std::string_view line)
+        {
+            line = TrimLine(line);
+            if (line.empty())
+            {
+                return;
+            }
+            const StreamFormat format = line.front() == '{' ? StreamFormat::Ndjson : StreamFormat::Csv;
+            std::optional<CompactTriangle> triangle = format == StreamFormat::Csv ? TriangleStream::parseCsvLine(line)
+                                                                                  : TriangleStream::parseNdjsonLine(line);
+            if (!triangle)
+            {
+                TriangleStream::appendResult(replies(connection), format, CompactTriangle{}, ResultCode::InvalidData);
+                return;
+            }
+            const ResultCode code = TriangleCalculator::finalizeTriangle(*triangle, options.unit, options.ambiguousCaseSolution);
+            TriangleStream::appendResult(replies(connection), format, *triangle, code);
+        }
+
+        void handleFrame(Connection& connection, const char* records, std::uint32_t count)
+        {
+            // a threshold of 0 sends every batch to the pool, in pieces of one triangle
+            const std::size_t pieceSize = std::max<std::size_t>(options.poolThreshold, 1);
+            if (options.pool == nullptr || count < pieceSize)
+            {
+                triangles.resize(count);
+                codes.resize(count);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    triangles[i] = ReadRequestRecord(records + i * ServerProtocol::RequestRecordSize);
+                }
+                TriangleCalculator::finalizeTriangles(std::span(triangles), std::span(codes), options.unit,
+                                                      options.ambiguousCaseSolution);
+
+                std::string& out = replies(connection);
+                const std::size_t begin = out.size();
+                out.resize(begin + ServerProtocol::HeaderSize + std::size_t{count} * ServerProtocol::ReplyRecordSize);
+                WriteHeader(out.data() + begin, count);
+                char* reply = out.data() + begin + ServerProtocol::HeaderSize;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    WriteReplyRecord(reply + i * ServerProtocol::ReplyRecordSize, triangles[i], codes[i]);
+                }
+                return;
+            }
+
+            auto job = std::make_shared<Job>();
+            job->triangles.resize(count);
+            job->codes.resize(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                job->triangles[i] = ReadRequestRecord(records + i * ServerProtocol::RequestRecordSize);
+            }
+            job->reply.resize(ServerProtocol::HeaderSize + std::size_t{count} * ServerProtocol::ReplyRecordSize);
+            WriteHeader(job->reply.data(), count);
+            const std::size_t pieces = (count + pieceSize - 1) / pieceSize;
+            job->remaining.store(pieces, std::memory_order_relaxed);
+            connection.pending.push_back({job, {}});
+
+            const std::uint64_t id = connection.id;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                inFlight += pieces;
+            }
+            for (std::size_t begin = 0; begin < count; begin += pieceSize)
+            {
+                const std::size_t end = std::min<std::size_t>(count, begin + pieceSize);
+                options.pool->submit([this, job, id, begin, end] { solvePiece(*job, id, begin, end); });
+            }
+        }
+
+        // runs on the pool
+        void solvePiece(Job& job, std::uint64_t id, std::size_t begin, std::size_t end)
+        {
+            const std::span<CompactTriangle> triangles = std::span(job.triangles).subspan(begin, end - begin);
+            const std::span<ResultCode> codes = std::span(job.codes).subspan(begin, end - begin);
+            TriangleCalculator::finalizeTriangles(triangles, codes, options.unit, options.ambiguousCaseSolution);
+            char* reply = job.reply.data() + ServerProtocol::HeaderSize + begin * ServerProtocol::ReplyRecordSize;
+            for (std::size_t i = 0; i < triangles.size(); ++i)
+            {
+                WriteReplyRecord(reply + i * ServerProtocol::ReplyRecordSize, triangles[i], codes[i]);
+            }
+
+            const bool last = job.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1;
+            // under the lock, closeAll() does not return (and close the eventfd) before this is done
+            std::lock_guard<std::mutex> lock(mutex);
+            if (last)
+            {
+                completed.push_back(id);
+                signal();
+            }
+            --inFlight;
+            idle.notify_all();
+        }
+
+        // move the replies finished on the pool to their connections, in request order
+        void finishJobs()
+        {
+            std::vector<std::uint64_t> ids;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ids.swap(completed);
+            }
+            for (const std::uint64_t id : ids)
+            {
+                const auto it = connections.find(id);
+                if (it == connections.end())
+                {
+                    continue;
+                }
+                Connection& connection = it->second;
+                while (!connection.pending.empty() &&
+                       connection.pending.front().job->remaining.load(std::memory_order_acquire) == 0)
+                {
+                    connection.output += connection.pending.front().job->reply;
+                    connection.output += connection.pending.front().after;
+                    connection.pending.pop_front();
+                }
+                if (!send(connection))
+                {
+                    close(id);
+                    continue;
+                }
+                update(id, connection);
+            }
+        }
+
+        // write as much of the output as the socket takes, false to drop the client
+        bool send(Connection& connection)
+        {
+            while (connection.outputPos < connection.output.size())
+            {
+                const ssize_t count = ::send(connection.fd, connection.output.data() + connection.outputPos,
+                                             connection.output.size() - connection.outputPos, MSG_NOSIGNAL);
+                if (count < 0)
+                {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    {
+                        return true;
+                    }
+                    if (errno != EINTR)
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+                connection.outputPos += static_cast<std::size_t>(count);
+            }
+            connection.output.clear();
+            connection.outputPos = 0;
+            // everything answered after the client finished sending
+            return !(connection.hungUp && connection.pending.empty());
+        }
+
+        // read while the client is not too far behind with its replies, write while some are waiting
+        void update(std::uint64_t id, Connection& connection)
+        {
+            const bool backlogged = connection.output.size() - connection.outputPos >= options.maxPendingOutput ||
+                                    connection.pending.size() >= MaxPendingJobs;
+            std::uint32_t events = 0;
+            if (!connection.hungUp && !backlogged)
+            {
+                events |= EPOLLIN | EPOLLRDHUP;
+            }
+            if (connection.outputPos < connection.output.size())
+            {
+                events |= EPOLLOUT;
+            }
+            if (events != connection.events)
+            {
+                connection.events = events;
+                watch(connection.fd, id, events, EPOLL_CTL_MOD);
+            }
+        }
+    };
+
+    TriangleServer::TriangleServer(ServerOptions options) : loop_(std::make_unique<Loop>())
+    {
+        loop_->options = std::move(options);
+    }
+
+    TriangleServer::~TriangleServer() = default;
+
+    ResultCode TriangleServer::listen()
+    {
+        return loop_->listen();
+    }
+
+    ResultCode TriangleServer::run()
+    {
+        return loop_->run();
+    }
+
+    void TriangleServer::stop() noexcept
+    {
+        loop_->stopping.store(true, std::memory_order_release);
+        if (loop_->wake >= 0)
+        {
+            loop_->signal();
+        }
+    }
+#else
+    struct TriangleServer::Loop
+    {
+    };
+
+    TriangleServer::TriangleServer(ServerOptions) : loop_(std::make_unique<Loop>())
+    {
+    }
+
+    TriangleServer::~TriangleServer() = default;
+
+    ResultCode TriangleServer::listen()
+    {
+        LOGIFACE_LOG(error, "The triangle server needs epoll and Unix domain sockets, which this platform does not provide");
+        return ResultCode::InvalidData;
+    }
+
+    ResultCode TriangleServer::run()
+    {
+        return ResultCode::InvalidData;
+    }
+
+    void TriangleServer::stop() noexcept
+    {
+    }
+#endif
+} // namespace TriangleCalculatorLib
@@ -0,0 +1,663 @@
+#include <TriangleCalculatorLib/TriangleStream.hpp>
+
+#include <TriangleCalculatorLib/ThreadPool.hpp>
+#include <TriangleCalculatorLib/TriangleCalculator.hpp>
+
+#include <logging/logging.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace TriangleCalculatorLib
+{
+    namespace
+    {
+        // bytes moved per read and per write, large enough that the stream overhead disappears
+        constexpr std::size_t IoBlockSize = 1 << 20;
+
+        struct FieldInfo
+        {
+            std::string_view name;
+            double CompactTriangle::* value;
+            std::uint8_t bit;
+        };
+
+        // CSV column order, the same as the positional -c arguments
+        constexpr std::array<FieldInfo, 6> Fields{{
+            {"angleA", &CompactTriangle::angleA, KnownField::AngleA},
+            {"angleB", &CompactTriangle::angleB, KnownField::AngleB},
+            {"angleC", &CompactTriangle::angleC, KnownField::AngleC},
+            {"sideA", &CompactTriangle::sideA, KnownField::SideA},
+            {"sideB", &CompactTriangle::sideB, KnownField::SideB},
+            {"sideC", &CompactTriangle::sideC, KnownField::SideC},
+        }};
+
+        bool IsSpace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        std::string_view Trim(std::string_view text)
+        {
+            while (!text.empty() && IsSpace(text.front())) { text.remove_prefix(1); }
+            while (!text.empty() && IsSpace(text.back())) { text.remove_suffix(1); }
+            return text;
+        }
+
+        bool ParseNumber(std::string_view text, double& value)
+        {
+            const char* first = text.data();
+            const char* last = text.data() + text.size();
+            if (first != last && *first == '+')
+            {
+                ++first;
+            }
+            const auto [ptr, ec] = std::from_chars(first, last, value);
+            return ec == std::errc{} && ptr == last;
+        }
+
+        // '?' or nothing means unknown
+        bool ParseCsvField(std::string_view text, CompactTriangle& triangle, const FieldInfo& field)
+        {
+            text = Trim(text);
+            if (text.empty() || text == "?")
+            {
+                return true;
+            }
+            if (!ParseNumber(text, triangle.*field.value))
+            {
+                return false;
+            }
+            triangle.known |= field.bit;
+            return true;
+        }
+
+        // minimal reader for one flat JSON object per line, nested values are rejected
+        class FlatJsonReader
+        {
+        public:
+            explicit FlatJsonReader(std::string_view text) : text_(text) {}
+
+            bool consume(char c)
+            {
+                skipSpace();
+                if (pos_ < text_.size() && text_[pos_] == c)
+                {
+                    ++pos_;
+                    return true;
+                }
+                return false;
+            }
+
+            bool atEnd()
+            {
+                skipSpace();
+                return pos_ == text_.size();
+            }
+
+            // strings without escapes, that is all field names and "?" need
+            bool readString(std::string_view& value)
+            {
+                if (!consume('"'))
+                {
+                    return false;
+                }
+                const std::size_t end = text_.find_first_of("\"\\", pos_);
+                if (end == std::string_view::npos || text_[end] != '"')
+                {
+                    return false;
+                }
+                value = text_.substr(pos_, end - pos_);
+                pos_ = end + 1;
+                return true;
+            }
+
+            // number, null or a string: known is set for numbers, unknown for null, "" and "?"
+            bool readValue(double& value, bool& known, bool& unknown)
+            {
+                skipSpace();
+                known = false;
+                unknown = false;
+                if (pos_ == text_.size())
+                {
+                    return false;
+                }
+                if (text_[pos_] == '"')
+                {
+                    std::string_view text;
+                    if (!readString(text))
+                    {
+                        return false;
+                    }
+                    unknown = text.empty() || text == "?";
+                    return true;
+                }
+                if (text_.substr(pos_, 4) == "null")
+                {
+                    pos_ += 4;
+                    unknown = true;
+                    return true;
+                }
+                const std::size_t end = text_.find_first_of(",} \t\r", pos_);
+                const std::string_view number = text_.substr(pos_, end == std::string_view::npos ? std::string_view::npos : end - pos_);
+                if (!ParseNumber(number, value))
+                {
+                    return false;
+                }
+                pos_ += number.size();
+                known = true;
+                return true;
+            }
+
+        private:
+            void skipSpace()
+            {
+                while (pos_ < text_.size() && (IsSpace(text_[pos_]) || text_[pos_] == '\n'))
+                {
+                    ++pos_;
+                }
+            }
+
+            std::string_view text_;
+            std::size_t pos_ = 0;
+        };
+
+        // shortest text that reads back to the same double
+        void AppendNumber(std::string& out, double value)
+        {
+            std::array<char, 32> digits;
+            const auto result = std::to_chars(digits.data(), digits.data() + digits.size(), value);
+            out.append(digits.data(), result.ptr);
+        }
+
+        void AppendCsvColumnNames(std::string& out)
+        {
+            for (std::size_t i = 0; i < Fields.size(); ++i)
+            {
+                if (i > 0)
+                {
+                    out += ',';
+                }
+                out += Fields[i].name;
+            }
+        }
+
+        // the code column solved output ends with, read back and ignored
+        bool IsResultCodeName(std::string_view text)
+        {
+            for (const ResultCode code : {ResultCode::Success, ResultCode::InsufficientData, ResultCode::TriangleAmbiguous,
+                                          ResultCode::InvalidData})
+            {
+                if (text == to_string(code))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // a header line names the columns in order, a solved file's header also ends with the code column
+        bool IsCsvHeader(std::string_view line)
+        {
+            for (const FieldInfo& field : Fields)
+            {
+                const std::size_t comma = line.find(',');
+                if (Trim(line.substr(0, comma)) != field.name)
+                {
+                    return false;
+                }
+                line.remove_prefix(comma == std::string_view::npos ? line.size() : comma + 1);
+            }
+            line = Trim(line);
+            return line.empty() || line == "code";
+        }
+
+        // the six values of a CSV line without the line end, '?' for unknowns
+        void AppendCsvFields(std::string& out, const CompactTriangle& triangle)
+        {
+            for (std::size_t i = 0; i < Fields.size(); ++i)
+            {
+                const FieldInfo& field = Fields[i];
+                if (i > 0)
+                {
+                    out += ',';
+                }
+                if (triangle.isKnown(field.bit))
+                {
+                    AppendNumber(out, triangle.*field.value);
+                }
+                else
+                {
+                    out += '?';
+                }
+            }
+        }
+
+        // the six members of an NDJSON object without the braces, null for unknowns
+        void AppendNdjsonFields(std::string& out, const CompactTriangle& triangle)
+        {
+            for (std::size_t i = 0; i < Fields.size(); ++i)
+            {
+                const FieldInfo& field = Fields[i];
+                out += i == 0 ? "\"" : ",\"";
+                out += field.name;
+                out += "\":";
+                const double value = triangle.*field.value;
+                // JSON has no representation for nan or infinity
+                if (triangle.isKnown(field.bit) && std::isfinite(value))
+                {
+                    AppendNumber(out, value);
+                }
+                else
+                {
+                    out += "null";
+                }
+            }
+        }
+
+        class OutputBuffer
+        {
+        public:
+            explicit OutputBuffer(std::ostream& output) : output_(output)
+            {
+                buffer_.reserve(IoBlockSize + 1024);
+            }
+
+            std::string& text() noexcept { return buffer_; }
+
+            // write out once a block has built up
+            bool flushIfFull()
+            {
+                return buffer_.size() < IoBlockSize || flush();
+            }
+
+            bool flush()
+            {
+                output_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+                buffer_.clear();
+                return output_.good();
+            }
+
+        private:
+            std::ostream& output_;
+            std::string buffer_;
+        };
+
+        void WriteCsvHeader(OutputBuffer& output)
+        {
+            AppendCsvColumnNames(output.text());
+            output.text() += ",code\n";
+        }
+
+        // turns lines into triangles: skips blank lines and a CSV header, counts malformed lines
+        class LineParser
+        {
+        public:
+            explicit LineParser(StreamFormat format) : format_(format) {}
+
+            // false for lines that do not hold a triangle, malformed lines give an all unknown triangle
+            bool parse(std::string_view line, CompactTriangle& triangle, bool& malformed)
+            {
+                ++lineNumber_;
+                line = Trim(line);
+                if (line.empty())
+                {
+                    return false;
+                }
+
+                std::optional<CompactTriangle> parsed = format_ == StreamFormat::Csv ? TriangleStream::parseCsvLine(line)
+                                                                                     : TriangleStream::parseNdjsonLine(line);
+                const bool firstRow = !sawRow_;
+                sawRow_ = true;
+                if (!parsed)
+                {
+                    // a CSV file may start with a header naming the columns, anything else is a malformed row
+                    if (firstRow && format_ == StreamFormat::Csv && IsCsvHeader(line))
+                    {
+                        return false;
+                    }
+                    LOGIFACE_LOGF(warn, "Malformed triangle on input line {}, it is written as unknown", lineNumber_);
+                    ++stats.malformedLines;
+                }
+                triangle = parsed.value_or(CompactTriangle{});
+                malformed = !parsed;
+                ++stats.triangles;
+                return true;
+            }
+
+            StreamStats stats;
+
+        private:
+            StreamFormat format_;
+            std::size_t lineNumber_ = 0;
+            bool sawRow_ = false;
+        };
+
+        // read the whole input in large blocks and hand over one line at a time (without the newline),
+        // stops early when onLine returns false
+        template <typename OnLine>
+        bool ForEachLine(std::istream& input, OnLine&& onLine)
+        {
+            std::vector<char> buffer(IoBlockSize);
+            std::size_t begin = 0;
+            std::size_t end = 0;
+            bool good = true;
+
+            while (good)
+            {
+                // hand every complete line over, the unterminated rest waits for the next read
+                while (good)
+                {
+                    const char* first = buffer.data() + begin;
+                    const auto* newline = static_cast<const char*>(std::memchr(first, '\n', end - begin));
+                    if (!newline)
+                    {
+                        break;
+                    }
+                    good = onLine(std::string_view(first, static_cast<std::size_t>(newline - first)));
+                    begin = static_cast<std::size_t>(newline - buffer.data()) + 1;
+                }
+                if (!good || input.eof() || input.fail())
+                {
+                    break;
+                }
+
+                std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+                end -= begin;
+                begin = 0;
+                if (end == buffer.size())
+                {
+                    // a single line longer than the buffer
+                    buffer.resize(buffer.size() * 2);
+                }
+                input.read(buffer.data() + end, static_cast<std::streamsize>(buffer.size() - end));
+                end += static_cast<std::size_t>(input.gcount());
+            }
+
+            if (good && begin < end)
+            {
+                good = onLine(std::string_view(buffer.data() + begin, end - begin));
+            }
+            return good && !input.bad();
+        }
+
+        // collects triangles into a chunk, solves and writes each chunk once it is full
+        class ChunkedSolver
+        {
+        public:
+            ChunkedSolver(std::ostream& output, const StreamOptions& options)
+                : options_(options), output_(output)
+            {
+                chunkSize_ = std::max<std::size_t>(1, options.chunkSize);
+                triangles_.reserve(chunkSize_);
+                malformed_.reserve(chunkSize_);
+                codes_.resize(chunkSize_);
+                if (options_.outputFormat == StreamFormat::Csv)
+                {
+                    WriteCsvHeader(output_);
+                }
+            }
+
+            bool add(const CompactTriangle& triangle, bool malformed)
+            {
+                triangles_.push_back(triangle);
+                malformed_.push_back(malformed);
+                return triangles_.size() < chunkSize_ || solveChunk();
+            }
+
+            bool finish()
+            {
+                return solveChunk() && output_.flush();
+            }
+
+        private:
+            bool solveChunk()
+            {
+                const std::span<CompactTriangle> triangles(triangles_);
+                const std::span<ResultCode> codes(codes_.data(), triangles_.size());
+                if (options_.pool)
+                {
+                    TriangleCalculator::finalizeTriangles(triangles, codes, options_.unit, *options_.pool,
+                                                          options_.ambiguousCaseSolution);
+                }
+                else
+                {
+                    TriangleCalculator::finalizeTriangles(triangles, codes, options_.unit, options_.ambiguousCaseSolution);
+                }
+
+                bool good = true;
+                for (std::size_t i = 0; i < triangles_.size() && good; ++i)
+                {
+                    TriangleStream::appendResult(output_.text(), options_.outputFormat, triangles_[i],
+                                                 malformed_[i] ? ResultCode::InvalidData : codes[i]);
+                    good = output_.flushIfFull();
+                }
+
+                triangles_.clear();
+                malformed_.clear();
+                return good;
+            }
+
+            const StreamOptions& options_;
+            OutputBuffer output_;
+            std::size_t chunkSize_ = 0;
+            std::vector<CompactTriangle> triangles_;
+            std::vector<bool> malformed_;
+            std::vector<ResultCode> codes_;
+        };
+    } // namespace
+
+    ResultCode TriangleStream::solve(std::istream& input, std::ostream& output, const StreamOptions& options, StreamStats* stats)
+    {
+        ChunkedSolver solver(output, options);
+        LineParser parser(options.inputFormat);
+        bool good = ForEachLine(input, [&](std::string_view line) {
+            CompactTriangle triangle;
+            bool malformed = false;
+            return !parser.parse(line, triangle, malformed) || solver.add(triangle, malformed);
+        });
+        good = good && solver.finish();
+
+        if (stats)
+        {
+            *stats = parser.stats;
+        }
+        if (!good)
+        {
+            LOGIFACE_LOG(error, "Reading or writing the triangle stream failed");
+            return ResultCode::InvalidData;
+        }
+        return ResultCode::Success;
+    }
+
+    ResultCode TriangleStream::read(std::istream& input, StreamFormat format,
+                                    const std::function<bool(const CompactTriangle&, bool)>& onTriangle, StreamStats* stats)
+    {
+        LineParser parser(format);
+        const bool good = ForEachLine(input, [&](std::string_view line) {
+            CompactTriangle triangle;
+            bool malformed = false;
+            return !parser.parse(line, triangle, malformed) || onTriangle(triangle, malformed);
+        });
+
+        if (stats)
+        {
+            *stats = parser.stats;
+        }
+        if (!good)
+        {
+            LOGIFACE_LOG(error, "Reading the triangle stream failed");
+            return ResultCode::InvalidData;
+        }
+        return ResultCode::Success;
+    }
+
+    ResultCode TriangleStream::write(std::ostream& output, StreamFormat format, const TriangleColumns& columns)
+    {
+        if (!columns.hasConsistentSizes())
+        {
+            LOGIFACE_LOG(error, "Triangle batch columns have mismatching lengths");
+            return ResultCode::InvalidData;
+        }
+
+        OutputBuffer buffer(output);
+        if (format == StreamFormat::Csv)
+        {
+            WriteCsvHeader(buffer);
+        }
+        bool good = true;
+        for (std::size_t i = 0; i < columns.size() && good; ++i)
+        {
+            TriangleStream::appendResult(buffer.text(), format, columns.getCompact(i), columns.codes[i]);
+            good = buffer.flushIfFull();
+        }
+        if (!good || !buffer.flush())
+        {
+            LOGIFACE_LOG(error, "Writing the triangle stream failed");
+            return ResultCode::InvalidData;
+        }
+        return ResultCode::Success;
+    }
+
+    void TriangleStream::appendHeader(std::string& out, StreamFormat format)
+    {
+        if (format == StreamFormat::Csv)
+        {
+            AppendCsvColumnNames(out);
+            out += '\n';
+        }
+    }
+
+    void TriangleStream::appendLine(std::string& out, StreamFormat format, const CompactTriangle& triangle)
+    {
+        if (format == StreamFormat::Csv)
+        {
+            AppendCsvFields(out, triangle);
+            out += '\n';
+        }
+        else
+        {
+            out += '{';
+            AppendNdjsonFields(out, triangle);
+            out += "}\n";
+        }
+    }
+
+    void TriangleStream::appendResult(std::string& out, StreamFormat format, const CompactTriangle& triangle, ResultCode code)
+    {
+        if (format == StreamFormat::Csv)
+        {
+            AppendCsvFields(out, triangle);
+            out += ',';
+            out += to_string(code);
+            out += '\n';
+        }
+        else
+        {
+            out += '{';
+            AppendNdjsonFields(out, triangle);
+            out += ",\"code\":\"";
+            out += to_string(code);
+            out += "\"}\n";
+        }
+    }
+
+    std::optional<CompactTriangle> TriangleStream::parseCsvLine(std::string_view line)
+    {
+        CompactTriangle triangle;
+        bool hasCode = false;
+        for (std::size_t i = 0; i < Fields.size(); ++i)
+        {
+            const std::size_t comma = line.find(',');
+            const bool last = i + 1 == Fields.size();
+            // six fields, the last one may be followed by the code column of a solved file
+            if (comma == std::string_view::npos && !last)
+            {
+                return std::nullopt;
+            }
+            if (!ParseCsvField(line.substr(0, comma), triangle, Fields[i]))
+            {
+                return std::nullopt;
+            }
+            hasCode = comma != std::string_view::npos;
+            line.remove_prefix(hasCode ? comma + 1 : line.size());
+        }
+        if (hasCode && !IsResultCodeName(Trim(line)))
+        {
+            return std::nullopt;
+        }
+        return triangle;
+    }
+
+    std::optional<CompactTriangle> TriangleStream::parseNdjsonLine(std::string_view line)
+    {
+        CompactTriangle triangle;
+        FlatJsonReader reader(line);
+        if (!reader.consume('{'))
+        {
+            return std::nullopt;
+        }
+        if (!reader.consume('}'))
+        {
+            do
+            {
+                std::string_view key;
+                double value = 0.0;
+                bool known = false;
+                bool unknown = false;
+                if (!reader.readString(key) || !reader.consume(':') || !reader.readValue(value, known, unknown))
+                {
+                    return std::nullopt;
+                }
+                // other keys are allowed and ignored, triangle fields must hold a number or an unknown marker
+                for (const FieldInfo& field : Fields)
+                {
+                    if (field.name != key)
+                    {
+                        continue;
+                    }
+                    if (!known && !unknown)
+                    {
+                        return std::nullopt;
+                    }
+                    if (known)
+                    {
+                        triangle.*field.value = value;
+                        triangle.known |= field.bit;
+                    }
+                }
+            } while (reader.consume(','));
+            if (!reader.consume('}'))
+            {
+                return std::nullopt;
+            }
+        }
+        if (!reader.atEnd())
+        {
+            return std::nullopt;
+        }
+        return triangle;
+    }
+
+    std::optional<StreamFormat> TriangleStream::parseFormat(std::string_view name)
+    {
+        if (name == "csv")
+        {
+            return StreamFormat::Csv;
+        }
+        if (name == "ndjson" || name == "jsonl")
+        {
+            return StreamFormat::Ndjson;
+        }
+        return std::nullopt;
+    }
+} // namespace TriangleCalculatorLib
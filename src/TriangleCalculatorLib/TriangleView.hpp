@@ -0,0 +1,140 @@
+#ifndef TRIANGLE_VIEW_HPP
+#define TRIANGLE_VIEW_HPP
+
+#include <TriangleCalculatorLib/Triangle.hpp>
+
+#include <array>
+#include <optional>
+
+namespace TriangleCalculatorLib
+{
+    template <typename T>
+    inline constexpr std::array<std::optional<T> BasicTriangle<T>::*, 3> SideFields{
+        &BasicTriangle<T>::sideA, &BasicTriangle<T>::sideB, &BasicTriangle<T>::sideC};
+    template <typename T>
+    inline constexpr std::array<std::optional<T> BasicTriangle<T>::*, 3> AngleFields{
+        &BasicTriangle<T>::angleA, &BasicTriangle<T>::angleB, &BasicTriangle<T>::angleC};
+
+    // View that reorders the fields of a triangle by a rotation fixed at compile time:
+    // TriangleView<1> sees (b, c, a) as (a, b, c), TriangleView<2> sees (c, a, b); T is the scalar type of the triangle.
+    // Every accessor resolves to a fixed member of the triangle, so there are no pointers to chase
+    // and the compiler can keep the values in registers across the solver steps.
+    template <int Rotation, typename T = double>
+    class TriangleView
+    {
+        static_assert(Rotation >= 0 && Rotation < 3, "a triangle has three rotations");
+
+    public:
+        using value_type = T;
+
+        explicit TriangleView(BasicTriangle<T>& triangle) noexcept : triangle_(triangle) {}
+
+        std::optional<T>& sideA() const noexcept { return triangle_.*SideFields<T>[Rotation]; }
+        std::optional<T>& sideB() const noexcept { return triangle_.*SideFields<T>[(Rotation + 1) % 3]; }
+        std::optional<T>& sideC() const noexcept { return triangle_.*SideFields<T>[(Rotation + 2) % 3]; }
+        std::optional<T>& angleA() const noexcept { return triangle_.*AngleFields<T>[Rotation]; }
+        std::optional<T>& angleB() const noexcept { return triangle_.*AngleFields<T>[(Rotation + 1) % 3]; }
+        std::optional<T>& angleC() const noexcept { return triangle_.*AngleFields<T>[(Rotation + 2) % 3]; }
+
+        BasicTriangle<T>& triangle() const noexcept { return triangle_; }
+
+    private:
+        BasicTriangle<T>& triangle_;
+    };
+
+    // Call onView with the triangle rotated by a rotation only known at runtime (negative rotations wrap around).
+    // onView is instantiated once per rotation, so the dispatch happens once and the code behind it is inlined.
+    template <typename T, typename OnView>
+    decltype(auto) WithRotation(BasicTriangle<T>& triangle, int rotation, OnView&& onView)
+    {
+        switch ((rotation % 3 + 3) % 3)
+        {
+        case 1:
+            return onView(TriangleView<1, T>(triangle));
+        case 2:
+            return onView(TriangleView<2, T>(triangle));
+        default:
+            return onView(TriangleView<0, T>(triangle));
+        }
+    }
+
+    template <typename T>
+    int KnownAngleCount(const BasicTriangle<T>& triangle)
+    {
+        return static_cast<int>(triangle.angleA.has_value()) + static_cast<int>(triangle.angleB.has_value()) +
+               static_cast<int>(triangle.angleC.has_value());
+    }
+
+    // sides of length 0 or less count as unknown
+    template <typename T>
+    int KnownSideCount(const BasicTriangle<T>& triangle)
+    {
+        int count = 0;
+        for (auto field : SideFields<T>)
+        {
+            const std::optional<T>& side = triangle.*field;
+            if (side.has_value() && *side > 0) ++count;
+        }
+        return count;
+    }
+
+    // index (0 for a, 1 for b, 2 for c) of the first side that is known and positive, -1 if there is none
+    template <typename T>
+    int FindFirstKnownSideIndex(const BasicTriangle<T>& triangle)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            const std::optional<T>& side = triangle.*SideFields<T>[i];
+            if (side.has_value() && *side > 0)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    template <typename T>
+    int FindFirstKnownAngleIndex(const BasicTriangle<T>& triangle)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            if ((triangle.*AngleFields<T>[i]).has_value())
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    template <typename T>
+    int FindFirstUnknownAngleIndex(const BasicTriangle<T>& triangle)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            if (!(triangle.*AngleFields<T>[i]).has_value())
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    template <typename T>
+    int FindLargestSideIndex(const BasicTriangle<T>& triangle)
+    {
+        int largestIndex = -1;
+        T largestValue = -1;
+        for (int i = 0; i < 3; ++i)
+        {
+            const std::optional<T>& side = triangle.*SideFields<T>[i];
+            if (side.has_value() && *side > largestValue)
+            {
+                largestValue = *side;
+                largestIndex = i;
+            }
+        }
+        return largestIndex;
+    }
+} // namespace TriangleCalculatorLib
+
+#endif // TRIANGLE_VIEW_HPP
@@ -0,0 +1,275 @@
+#ifndef TRIANGLE_VECTOR_MATH_HPP
+#define TRIANGLE_VECTOR_MATH_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+// Branch-free double precision sin/cos/asin/acos built only from + - * / sqrt and selects,
+// so loops calling them auto-vectorize for whatever ISA the translation unit is compiled for.
+// The polynomial coefficients are the plain Taylor series generated at compile time, the
+// ranges they are evaluated on are small enough that the truncation error stays below 1e-17.
+// The float overloads (for Precision::Mixed) use fewer terms, their truncation error stays below 1e-9.
+namespace TriangleCalculatorLib::VectorMath
+{
+    // Internal linkage: the kernel units include this with different instruction set flags, an inline
+    // function shared between them could be linked from the AVX-512 unit into callers on any CPU.
+    namespace
+    {
+        // pi and pi/2 split into a high and a low part so range reductions do not lose precision
+        inline constexpr double PiHi = 3.141592653589793116;
+        inline constexpr double PiLo = 1.2246467991473532e-16;
+        inline constexpr double HalfPiHi = 1.5707963267948966192;
+        inline constexpr double HalfPiLo = 6.123233995736766e-17;
+        inline constexpr double TwoPiHi = 6.283185307179586232;
+        inline constexpr double TwoPiLo = 2.4492935982947064e-16;
+        inline constexpr double InvTwoPi = 0.15915494309189533577;
+
+        namespace detail
+        {
+            // sin(x) = sum (-1)^k x^(2k+1) / (2k+1)!, evaluated on |x| <= pi/2
+            template <std::size_t N>
+            constexpr std::array<double, N> SinCoefficients()
+            {
+                std::array<double, N> c{};
+                double term = 1.0;
+                for (std::size_t k = 0; k < N; ++k)
+                {
+                    c[k] = term;
+                    term = -term / static_cast<double>((2 * k + 2) * (2 * k + 3));
+                }
+                return c;
+            }
+
+            // cos(x) = sum (-1)^k x^(2k) / (2k)!, evaluated on |x| <= pi/2
+            template <std::size_t N>
+            constexpr std::array<double, N> CosCoefficients()
+            {
+                std::array<double, N> c{};
+                double term = 1.0;
+                for (std::size_t k = 0; k < N; ++k)
+                {
+                    c[k] = term;
+                    term = -term / static_cast<double>((2 * k + 1) * (2 * k + 2));
+                }
+                return c;
+            }
+
+            // asin(x) = sum (2k)! / (4^k (k!)^2 (2k+1)) x^(2k+1), evaluated on |x| <= 0.5
+            template <std::size_t N>
+            constexpr std::array<double, N> AsinCoefficients()
+            {
+                std::array<double, N> c{};
+                double central = 1.0; // (2k)! / (4^k (k!)^2)
+                for (std::size_t k = 0; k < N; ++k)
+                {
+                    c[k] = central / static_cast<double>(2 * k + 1);
+                    central = central * static_cast<double>(2 * k + 1) / static_cast<double>(2 * k + 2);
+                }
+                return c;
+            }
+
+            inline constexpr auto SinTable = SinCoefficients<11>();  // error < (pi/2)^23 / 23! ~ 1e-18
+            inline constexpr auto CosTable = CosCoefficients<11>();  // error < (pi/2)^22 / 22! ~ 2e-17
+            inline constexpr auto AsinTable = AsinCoefficients<25>(); // error < 0.25^25 / 51 ~ 2e-18 (relative)
+
+            template <std::size_t N>
+            constexpr std::array<float, N> ToFloat(const std::array<double, N>& c)
+            {
+                std::array<float, N> result{};
+                for (std::size_t k = 0; k < N; ++k)
+                {
+                    result[k] = static_cast<float>(c[k]);
+                }
+                return result;
+            }
+
+            inline constexpr auto SinTableFloat = ToFloat(SinCoefficients<7>());   // error < (pi/2)^15 / 15! ~ 7e-10
+            inline constexpr auto CosTableFloat = ToFloat(CosCoefficients<8>());   // error < (pi/2)^16 / 16! ~ 1e-10
+            inline constexpr auto AsinTableFloat = ToFloat(AsinCoefficients<12>()); // error < 0.25^12 / 25 ~ 3e-9 (relative)
+
+            // evaluate sum c[k] * z^k with Horner's scheme, expanded at compile time so the
+            // vectorizer sees straight-line code instead of an inner loop
+            template <typename T, std::size_t N, std::size_t... K>
+            inline T HornerExpanded(const std::array<T, N>& c, T z, std::index_sequence<K...>)
+            {
+                T result = c[N - 1];
+                ((result = result * z + c[N - 2 - K]), ...);
+                return result;
+            }
+
+            template <typename T, std::size_t N>
+            inline T Horner(const std::array<T, N>& c, T z)
+            {
+                return HornerExpanded(c, z, std::make_index_sequence<N - 1>{});
+            }
+
+            // round to nearest integer for |x| < 2^51 without a libm call
+            inline double RoundNearest(double x)
+            {
+                constexpr double shifter = 6755399441055744.0; // 1.5 * 2^52
+                return (x + shifter) - shifter;
+            }
+
+            // reduce x to r in [-pi, pi]
+            inline double ReduceToPi(double x)
+            {
+                const double k = RoundNearest(x * InvTwoPi);
+                return (x - k * TwoPiHi) - k * TwoPiLo;
+            }
+
+            inline double SinPoly(double r)
+            {
+                return r * Horner(SinTable, r * r);
+            }
+
+            inline double CosPoly(double r)
+            {
+                return Horner(CosTable, r * r);
+            }
+
+            // asin for |x| <= 0.5
+            inline double AsinPoly(double x)
+            {
+                return x * Horner(AsinTable, x * x);
+            }
+
+            inline float RoundNearest(float x)
+            {
+                constexpr float shifter = 12582912.0f; // 1.5 * 2^23
+                return (x + shifter) - shifter;
+            }
+
+            // 2 pi in three parts, the first with few enough bits that k * TwoPi1 is exact
+            inline float ReduceToPi(float x)
+            {
+                constexpr float TwoPi1 = 6.28125f;
+                constexpr float TwoPi2 = 0.0019353071693331003f;
+                constexpr float TwoPi3 = 1.0253376273028358e-11f;
+                const float k = RoundNearest(x * 0.15915493667125702f);
+                return ((x - k * TwoPi1) - k * TwoPi2) - k * TwoPi3;
+            }
+
+            inline float SinPoly(float r)
+            {
+                return r * Horner(SinTableFloat, r * r);
+            }
+
+            inline float CosPoly(float r)
+            {
+                return Horner(CosTableFloat, r * r);
+            }
+
+            inline float AsinPoly(float x)
+            {
+                return x * Horner(AsinTableFloat, x * x);
+            }
+        } // namespace detail
+
+        inline double Sin(double x)
+        {
+            double r = detail::ReduceToPi(x);
+            // fold [pi/2, pi] and [-pi, -pi/2] back onto [-pi/2, pi/2] using sin(pi - r) = sin(r)
+            const double upper = (PiHi - r) + PiLo;
+            const double lower = (-PiHi - r) - PiLo;
+            r = r > HalfPiHi ? upper : r;
+            r = r < -HalfPiHi ? lower : r;
+            return detail::SinPoly(r);
+        }
+
+        inline double Cos(double x)
+        {
+            const double r = std::abs(detail::ReduceToPi(x));
+            // cos(r) = -cos(pi - r) for r in [pi/2, pi]
+            const bool folded = r > HalfPiHi;
+            const double folded_r = (PiHi - r) + PiLo;
+            const double c = detail::CosPoly(folded ? folded_r : r);
+            return folded ? -c : c;
+        }
+
+        inline double Asin(double x)
+        {
+            const double ax = std::abs(x);
+            // asin(x) = pi/2 - 2 asin(sqrt((1 - x) / 2)) for x > 0.5
+            const bool large = ax > 0.5;
+            const double root = std::sqrt((1.0 - ax) * 0.5);
+            const double s = large ? root : ax;
+            const double p = detail::AsinPoly(s);
+            const double y = large ? (HalfPiHi - 2.0 * p) + HalfPiLo : p;
+            return x < 0.0 ? -y : y;
+        }
+
+        inline double Acos(double x)
+        {
+            const double ax = std::abs(x);
+            // acos(x) = 2 asin(sqrt((1 - x) / 2)) for x > 0.5 and pi - 2 asin(sqrt((1 + x) / 2)) for x < -0.5
+            const bool large = ax > 0.5;
+            const double root = std::sqrt((1.0 - ax) * 0.5);
+            const double s = large ? root : x;
+            const double p = detail::AsinPoly(s);
+            const double small = (HalfPiHi - p) + HalfPiLo;
+            const double positive = 2.0 * p;
+            const double negative = (PiHi - 2.0 * p) + PiLo;
+            return large ? (x > 0.0 ? positive : negative) : small;
+        }
+
+        namespace detail
+        {
+            inline constexpr float PiHiFloat = 3.1415927410125732f;
+            inline constexpr float PiLoFloat = -8.742277657347586e-08f;
+            inline constexpr float HalfPiHiFloat = 1.5707963705062866f;
+            inline constexpr float HalfPiLoFloat = -4.371138828673793e-08f;
+        } // namespace detail
+
+        // the same reductions in float, a vector holds twice as many lanes
+        inline float Sin(float x)
+        {
+            using namespace detail;
+            float r = ReduceToPi(x);
+            const float upper = (PiHiFloat - r) + PiLoFloat;
+            const float lower = (-PiHiFloat - r) - PiLoFloat;
+            r = r > HalfPiHiFloat ? upper : r;
+            r = r < -HalfPiHiFloat ? lower : r;
+            return SinPoly(r);
+        }
+
+        inline float Cos(float x)
+        {
+            using namespace detail;
+            const float r = std::abs(ReduceToPi(x));
+            const bool folded = r > HalfPiHiFloat;
+            const float folded_r = (PiHiFloat - r) + PiLoFloat;
+            const float c = CosPoly(folded ? folded_r : r);
+            return folded ? -c : c;
+        }
+
+        inline float Asin(float x)
+        {
+            using namespace detail;
+            const float ax = std::abs(x);
+            const bool large = ax > 0.5f;
+            const float root = std::sqrt((1.0f - ax) * 0.5f);
+            const float s = large ? root : ax;
+            const float p = AsinPoly(s);
+            const float y = large ? (HalfPiHiFloat - 2.0f * p) + HalfPiLoFloat : p;
+            return x < 0.0f ? -y : y;
+        }
+
+        inline float Acos(float x)
+        {
+            using namespace detail;
+            const float ax = std::abs(x);
+            const bool large = ax > 0.5f;
+            const float root = std::sqrt((1.0f - ax) * 0.5f);
+            const float s = large ? root : x;
+            const float p = AsinPoly(s);
+            const float small = (HalfPiHiFloat - p) + HalfPiLoFloat;
+            const float positive = 2.0f * p;
+            const float negative = (PiHiFloat - 2.0f * p) + PiLoFloat;
+            return large ? (x > 0.0f ? positive : negative) : small;
+        }
+    } // namespace
+} // namespace TriangleCalculatorLib::VectorMath
+
+#endif // TRIANGLE_VECTOR_MATH_HPP
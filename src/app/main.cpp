@@ -1,19 +1,51 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <stop_token>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <TriangleCalculatorLib/Triangle.hpp>
 #include <TriangleCalculatorLib/ReturnCode.hpp>
+#include <TriangleCalculatorLib/SolverStats.hpp>
+#include <TriangleCalculatorLib/ThreadPool.hpp>
 #include <TriangleCalculatorLib/TriangleCalculator.hpp>
+#include <TriangleCalculatorLib/TriangleFile.hpp>
+#include <TriangleCalculatorLib/TriangleGenerator.hpp>
+#include <TriangleCalculatorLib/TriangleJson.hpp>
+#include <TriangleCalculatorLib/TriangleServer.hpp>
+#include <TriangleCalculatorLib/TriangleStream.hpp>
 
+#include <logging/async_logger.hpp>
 #include <logging/logging.hpp>
+#include <logging/rate_limited_logger.hpp>
 #include "ostream_logger.hpp"
 #include "version.hpp"
 
 using namespace TriangleCalculatorLib;
 
+// output format of --stats, None while it is not given
+enum class StatsFormat { None, Json, Prometheus };
+
 // forward declarations
 void initializeLogger();
+bool setLogLevel(logiface::logger& lg, const std::string& name);
+bool parseStatsFormat(const std::string& name, StatsFormat& format);
+void printStats(StatsFormat format);
+int runBatch(const std::vector<std::string>& args);
+int runConvert(const std::vector<std::string>& args);
+int runSolveFile(const std::vector<std::string>& args);
+int runGenerate(const std::vector<std::string>& args);
+#if defined(__linux__)
+int runServe(const std::vector<std::string>& args);
+#endif
 
 int main(int argc, char** argv) {
     std::vector<std::string> args(argv + 1, argv + argc);
@@ -51,7 +83,53 @@ int main(int argc, char** argv) {
                   << "           2   second solution\n\n"
 
                   << "   -l, --log-level <level>\n"
-                  << "           Set log level (trace, debug, info, warn, error, critical)\n";
+                  << "           Set log level (trace, debug, info, warn, error, critical)\n\n"
+
+                  << "  -b, --batch <file> [batch options]\n"
+                  << "           Solve every triangle of a file (- for stdin), one result line per input line.\n"
+                  << "           CSV columns and NDJSON keys are angleA, angleB, angleC, sideA, sideB, sideC\n"
+                  << "           (the order of -c). Use ?, empty or null for unknown values. A CSV header line and\n"
+                  << "           the code column of solved output are skipped, so a solved file can be solved again.\n"
+                  << "           Batch options:\n"
+                  << "           --format <csv|ndjson>         input format (default: from the file extension, else csv)\n"
+                  << "           --output-format <csv|ndjson>  output format (default: the input format)\n"
+                  << "           -o, --output <file>           write to a file instead of stdout\n"
+                  << "           -t, --threads <n>             solve on n threads, 0 for all cores (default: 1)\n"
+                  << "           -s, --solution <n>            as above\n"
+                  << "           -l, --log-level <level>       as above\n"
+                  << "           --stats <json|prometheus>     print solver statistics (solves and latency per case,\n"
+                  << "                                         result codes) to stderr when done\n\n"
+
+                  << "  --convert <in> <out> [--format <csv|ndjson|json>]\n"
+                  << "           Convert between text (csv or ndjson) and the binary triangle format (.tcb).\n"
+                  << "           The format of the text side comes from --format or its file extension.\n"
+                  << "           json reads documents of {\"sides\":[a,b,c],\"angles\":[A,B,C]} objects\n"
+                  << "           (null for unknown values) like the test fixture, into a .tcb file.\n\n"
+
+                  << "  --solve-file <file.tcb> [-o <file.tcb>] [-t <n>] [-s <n>] [-l <level>] [--stats <json|prometheus>]\n"
+                  << "           Solve a binary triangle file in place (or into a copy given by -o),\n"
+                  << "           the solver works on the mapped file, nothing is parsed or copied.\n\n"
+
+                  << "  --generate <count> <file> [generate options]\n"
+                  << "           Write count synthetic triangles for load tests (- for stdout), as csv, ndjson\n"
+                  << "           or a .tcb file. The same seed always gives the same triangles.\n"
+                  << "           Generate options:\n"
+                  << "           --format <csv|ndjson>         text format (default: from the file extension, else csv)\n"
+                  << "           --seed <n>                    random seed (default: 42)\n"
+                  << "           --first <n>                   index of the first triangle, to split a load over runs\n"
+                  << "           --cases <SSS=w,SAS=w,..>      weights of the given values: SSS, SAS, SSA, ASA, AAS\n"
+                  << "                                         (default: all 1)\n"
+                  << "           --shapes <right=w,..>         weights of the shapes: right, equilateral, isosceles,\n"
+                  << "                                         scalene (default: 20,20,20,40)\n"
+                  << "           --ambiguous <fraction>        share of ambiguous SSA triangles (default: 0)\n"
+                  << "           --invalid <fraction>          share of values no triangle has (default: 0)\n"
+                  << "           -t, --threads <n>             generate on n threads, 0 for all cores (default: 1)\n\n"
+
+                  << "  --serve <socket> [-t <n>] [-s <n>] [-l <level>] [--stats <json|prometheus>]\n"
+                  << "           Solve triangles for clients of a Unix domain socket until SIGINT or SIGTERM (Linux only).\n"
+                  << "           Clients send lines like -b input (csv or ndjson, answered in the same format)\n"
+                  << "           or binary batches (see TriangleServer.hpp) and may pipeline any number of them,\n"
+                  << "           replies come in request order. Large binary batches are solved on n threads.\n";
         return 0;
     }
 
@@ -60,6 +138,31 @@ int main(int argc, char** argv) {
         return 0;
     }
 
+    if(args[0] == "--batch" || args[0] == "-b") {
+        return runBatch(args);
+    }
+
+    if(args[0] == "--convert") {
+        return runConvert(args);
+    }
+
+    if(args[0] == "--solve-file") {
+        return runSolveFile(args);
+    }
+
+    if(args[0] == "--generate") {
+        return runGenerate(args);
+    }
+
+    if(args[0] == "--serve") {
+#if defined(__linux__)
+        return runServe(args);
+#else
+        LOGIFACE_LOG(error, "Serve needs epoll and Unix domain sockets, it is only available on Linux.");
+        return 1;
+#endif
+    }
+
     if(args[iterator] == "--calculate" || args[iterator] == "-c") {
         ++iterator;
         if(args.size() < 7) {
@@ -129,39 +232,8 @@ int main(int argc, char** argv) {
                 LOGIFACE_LOG(error, "No logger initialized to set log level.");
                 return 1;
             }
-            if(args[iterator] == "trace")
-            {
-                lg->set_level(logiface::level::trace);
-                LOGIFACE_LOG(trace, "logging logs at trace level or above.");
-            }
-            else if(args[iterator] == "debug")
+            if(!setLogLevel(*lg, args[iterator]))
             {
-                lg->set_level(logiface::level::debug);
-                LOGIFACE_LOG(debug, "logging logs at debug level or above.");
-            }
-            else if(args[iterator] == "info")
-            {
-                lg->set_level(logiface::level::info);
-                LOGIFACE_LOG(info, "logging logs at info level or above.");
-            }
-            else if (args[iterator] == "warn")
-            {
-                lg->set_level(logiface::level::warn);
-                LOGIFACE_LOG(warn, "logging logs at warn level or above.");
-            }
-            else if (args[iterator] == "error")
-            {
-                lg->set_level(logiface::level::error);
-                LOGIFACE_LOG(error, "logging logs at error level or above.");
-            }
-            else if (args[iterator] == "critical")
-            {
-                lg->set_level(logiface::level::critical);
-                LOGIFACE_LOG(error, "logging logs at critical level."); // we cant use critical log here, that would cause a actual exception
-            }
-            else
-            {
-                LOGIFACE_LOG(error, "Invalid log level provided. Use either trace, debug, info, warn, error, or critical.");
                 return 1;
             }
             ++iterator;
@@ -183,7 +255,668 @@ int main(int argc, char** argv) {
 }
 
 void initializeLogger() {
-    static logiface::ostream_logger app_logger{};
+    // the stream logger only ever runs on the async logger's thread, so solving never waits on the terminal;
+    // statics are destroyed in reverse order, the async logger drains into the sink before the sink goes away
+    // repeated warnings from one call site (e.g. a bad input batch) are cut to a few lines plus a summary per second,
+    // the reporter thread reports a site that went quiet (a long --serve would otherwise only tell at exit)
+    static logiface::ostream_logger sink_logger{};
+    static logiface::async_logger async_logger{sink_logger, 4096, logiface::overflow_policy::block};
+    static logiface::rate_limited_logger app_logger{async_logger, 10, std::chrono::seconds(1)};
+    static std::jthread reporter([](std::stop_token stop) {
+        std::mutex mutex;
+        std::condition_variable_any wakeup;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!wakeup.wait_for(lock, stop, std::chrono::seconds(1), [] { return false; }) && !stop.stop_requested()) {
+            app_logger.flush_expired();
+        }
+    });
     app_logger.set_level(logiface::level::info);
     logiface::set_logger(&app_logger);
 }
+
+bool setLogLevel(logiface::logger& lg, const std::string& name) {
+    if(name == "trace")
+    {
+        lg.set_level(logiface::level::trace);
+        LOGIFACE_LOG(trace, "logging logs at trace level or above.");
+    }
+    else if(name == "debug")
+    {
+        lg.set_level(logiface::level::debug);
+        LOGIFACE_LOG(debug, "logging logs at debug level or above.");
+    }
+    else if(name == "info")
+    {
+        lg.set_level(logiface::level::info);
+        LOGIFACE_LOG(info, "logging logs at info level or above.");
+    }
+    else if (name == "warn")
+    {
+        lg.set_level(logiface::level::warn);
+        LOGIFACE_LOG(warn, "logging logs at warn level or above.");
+    }
+    else if (name == "error")
+    {
+        lg.set_level(logiface::level::error);
+        LOGIFACE_LOG(error, "logging logs at error level or above.");
+    }
+    else if (name == "critical")
+    {
+        lg.set_level(logiface::level::critical);
+        LOGIFACE_LOG(error, "logging logs at critical level."); // we cant use critical log here, that would cause a actual exception
+    }
+    else
+    {
+        LOGIFACE_LOG(error, "Invalid log level provided. Use either trace, debug, info, warn, error, or critical.");
+        return false;
+    }
+    return true;
+}
+
+bool parseStatsFormat(const std::string& name, StatsFormat& format) {
+    if(name == "json")
+    {
+        format = StatsFormat::Json;
+    }
+    else if(name == "prometheus")
+    {
+        format = StatsFormat::Prometheus;
+    }
+    else
+    {
+        LOGIFACE_LOG(error, "Invalid stats format provided. Use json or prometheus.");
+        return false;
+    }
+    // counting starts with the option, everything solved from here on is in the dump
+    SolverStats::setEnabled(true);
+    return true;
+}
+
+// stdout may carry the solved triangles, so the stats go to stderr
+void printStats(StatsFormat format) {
+    if(format == StatsFormat::None)
+    {
+        return;
+    }
+    const SolverStats::Snapshot snapshot = SolverStats::snapshot();
+    if(format == StatsFormat::Json)
+    {
+        std::cerr << SolverStats::toJson(snapshot) << "\n";
+    }
+    else
+    {
+        std::cerr << SolverStats::toPrometheus(snapshot);
+    }
+}
+
+int runBatch(const std::vector<std::string>& args) {
+    if(args.size() < 2)
+    {
+        LOGIFACE_LOG(error, "Batch mode requires an input file (- for stdin).");
+        return 1;
+    }
+
+    const std::string inputPath = args[1];
+    std::string outputPath = "-";
+    std::optional<StreamFormat> inputFormat;
+    std::optional<StreamFormat> outputFormat;
+    std::size_t threads = 1;
+    StatsFormat statsFormat = StatsFormat::None;
+    StreamOptions options;
+
+    for(std::size_t i = 2; i < args.size(); ++i)
+    {
+        const std::string& option = args[i];
+        if(i + 1 >= args.size())
+        {
+            LOGIFACE_LOGF(error, "Option {} requires an argument.", std::string_view(option));
+            return 1;
+        }
+        const std::string& value = args[++i];
+
+        if(option == "--format" || option == "--output-format")
+        {
+            const std::optional<StreamFormat> format = TriangleStream::parseFormat(value);
+            if(!format)
+            {
+                LOGIFACE_LOG(error, "Invalid format provided. Use csv or ndjson.");
+                return 1;
+            }
+            (option == "--format" ? inputFormat : outputFormat) = format;
+        }
+        else if(option == "-o" || option == "--output")
+        {
+            outputPath = value;
+        }
+        else if(option == "-t" || option == "--threads")
+        {
+            try {
+                threads = std::stoul(value);
+            } catch (const std::exception&) {
+                LOGIFACE_LOG(error, "Invalid thread count provided.");
+                return 1;
+            }
+        }
+        else if(option == "-s" || option == "--solution")
+        {
+            if(value != "0" && value != "1" && value != "2")
+            {
+                LOGIFACE_LOG(error, "Invalid solution option provided. Use 0, 1, or 2.");
+                return 1;
+            }
+            options.ambiguousCaseSolution = static_cast<AmbiguousCaseSolution>(value[0] - '0');
+        }
+        else if(option == "-l" || option == "--log-level")
+        {
+            logiface::logger* lg = logiface::get_logger();
+            if(!lg || !setLogLevel(*lg, value))
+            {
+                return 1;
+            }
+        }
+        else if(option == "--stats")
+        {
+            if(!parseStatsFormat(value, statsFormat))
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            LOGIFACE_LOGF(error, "Unknown batch option {}.", std::string_view(option));
+            return 1;
+        }
+    }
+
+    if(!inputFormat)
+    {
+        const bool ndjson = inputPath.ends_with(".ndjson") || inputPath.ends_with(".jsonl");
+        inputFormat = ndjson ? StreamFormat::Ndjson : StreamFormat::Csv;
+    }
+    options.inputFormat = *inputFormat;
+    options.outputFormat = outputFormat.value_or(*inputFormat);
+
+    std::ifstream inputFile;
+    if(inputPath != "-")
+    {
+        inputFile.open(inputPath, std::ios::binary);
+        if(!inputFile.is_open())
+        {
+            LOGIFACE_LOGF(error, "Unable to open input file {}.", std::string_view(inputPath));
+            return 1;
+        }
+    }
+    std::ofstream outputFile;
+    if(outputPath != "-")
+    {
+        outputFile.open(outputPath, std::ios::binary | std::ios::trunc);
+        if(!outputFile.is_open())
+        {
+            LOGIFACE_LOGF(error, "Unable to open output file {}.", std::string_view(outputPath));
+            return 1;
+        }
+    }
+
+    std::unique_ptr<ThreadPool> pool;
+    if(threads != 1)
+    {
+        pool = std::make_unique<ThreadPool>(threads);
+        options.pool = pool.get();
+    }
+
+    std::istream& input = inputPath == "-" ? std::cin : static_cast<std::istream&>(inputFile);
+    std::ostream& output = outputPath == "-" ? std::cout : static_cast<std::ostream&>(outputFile);
+
+    StreamStats stats;
+    const ResultCode code = TriangleStream::solve(input, output, options, &stats);
+    LOGIFACE_LOGF(info, "Solved {} triangles, {} malformed lines.", stats.triangles, stats.malformedLines);
+    printStats(statsFormat);
+    return code == ResultCode::Success ? 0 : 1;
+}
+
+bool isTriangleFile(const std::string& path) {
+    return path.ends_with(".tcb");
+}
+
+int runConvert(const std::vector<std::string>& args) {
+    if(args.size() < 3)
+    {
+        LOGIFACE_LOG(error, "Convert requires an input and an output file.");
+        return 1;
+    }
+
+    const std::string& inputPath = args[1];
+    const std::string& outputPath = args[2];
+    std::optional<StreamFormat> format;
+    // documents of {"sides":[..],"angles":[..]} objects like the test fixture, only read
+    bool json = false;
+    if(args.size() == 5 && args[3] == "--format")
+    {
+        format = TriangleStream::parseFormat(args[4]);
+        json = args[4] == "json";
+        if(!format && !json)
+        {
+            LOGIFACE_LOG(error, "Invalid format provided. Use csv, ndjson or json.");
+            return 1;
+        }
+    }
+    else if(args.size() != 3)
+    {
+        LOGIFACE_LOG(error, "Unknown convert options, only --format is supported.");
+        return 1;
+    }
+
+    if(isTriangleFile(inputPath) == isTriangleFile(outputPath))
+    {
+        LOGIFACE_LOG(error, "Convert needs exactly one .tcb file, the other side is text.");
+        return 1;
+    }
+    const std::string& textPath = isTriangleFile(inputPath) ? outputPath : inputPath;
+    if(!format && !json)
+    {
+        const bool ndjson = textPath.ends_with(".ndjson") || textPath.ends_with(".jsonl");
+        json = textPath.ends_with(".json");
+        format = ndjson ? StreamFormat::Ndjson : StreamFormat::Csv;
+    }
+    if(json && isTriangleFile(inputPath))
+    {
+        LOGIFACE_LOG(error, "JSON triangle documents are only read, convert to csv or ndjson.");
+        return 1;
+    }
+
+    if(isTriangleFile(inputPath))
+    {
+        TriangleFile file;
+        if(file.open(inputPath) != ResultCode::Success)
+        {
+            return 1;
+        }
+        std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+        if(!output.is_open())
+        {
+            LOGIFACE_LOGF(error, "Unable to open output file {}.", std::string_view(outputPath));
+            return 1;
+        }
+        return TriangleStream::write(output, *format, file.columns()) == ResultCode::Success ? 0 : 1;
+    }
+
+    std::ifstream input(inputPath, std::ios::binary);
+    if(!input.is_open())
+    {
+        LOGIFACE_LOGF(error, "Unable to open input file {}.", std::string_view(inputPath));
+        return 1;
+    }
+
+    // every triangle takes a line (a JSON triangle an object), so counting them bounds the rows the file needs
+    std::size_t lines = 1;
+    std::vector<char> block(1 << 20);
+    while(input.read(block.data(), static_cast<std::streamsize>(block.size())) || input.gcount() > 0)
+    {
+        lines += static_cast<std::size_t>(std::count(block.data(), block.data() + input.gcount(), json ? '{' : '\n'));
+    }
+    input.clear();
+    input.seekg(0);
+
+    TriangleFile file;
+    if(file.create(outputPath, lines) != ResultCode::Success || file.resize(lines) != ResultCode::Success)
+    {
+        return 1;
+    }
+    const TriangleColumns columns = file.columns();
+    if(json)
+    {
+        // the reader fills the mapped columns directly
+        TriangleJsonReader reader(input);
+        const std::size_t rows = reader.read(columns);
+        if(reader.status() != ResultCode::Success || file.resize(rows) != ResultCode::Success ||
+           file.sync() != ResultCode::Success)
+        {
+            return 1;
+        }
+        LOGIFACE_LOGF(info, "Converted {} triangles, {} malformed.", reader.stats().triangles, reader.stats().malformed);
+        return 0;
+    }
+    std::size_t row = 0;
+    StreamStats stats;
+    const ResultCode code = TriangleStream::read(input, *format, [&](const CompactTriangle& triangle, bool malformed) {
+        columns.set(row, triangle);
+        if(malformed)
+        {
+            columns.codes[row] = ResultCode::InvalidData;
+        }
+        return ++row < lines;
+    }, &stats);
+    if(code != ResultCode::Success || file.resize(row) != ResultCode::Success || file.sync() != ResultCode::Success)
+    {
+        return 1;
+    }
+    LOGIFACE_LOGF(info, "Converted {} triangles, {} malformed lines.", stats.triangles, stats.malformedLines);
+    return 0;
+}
+
+int runSolveFile(const std::vector<std::string>& args) {
+    if(args.size() < 2)
+    {
+        LOGIFACE_LOG(error, "Solve file requires a .tcb file.");
+        return 1;
+    }
+
+    std::string path = args[1];
+    std::size_t threads = 1;
+    AmbiguousCaseSolution ambiguousCaseSolution = AmbiguousCaseSolution::NoSolution;
+    StatsFormat statsFormat = StatsFormat::None;
+    for(std::size_t i = 2; i < args.size(); ++i)
+    {
+        const std::string& option = args[i];
+        if(i + 1 >= args.size())
+        {
+            LOGIFACE_LOGF(error, "Option {} requires an argument.", std::string_view(option));
+            return 1;
+        }
+        const std::string& value = args[++i];
+
+        if(option == "-o" || option == "--output")
+        {
+            // solving happens in place, so solve a copy of the input
+            std::error_code error;
+            std::filesystem::copy_file(path, value, std::filesystem::copy_options::overwrite_existing, error);
+            if(error)
+            {
+                LOGIFACE_LOGF(error, "Unable to copy {} to {}.", std::string_view(path), std::string_view(value));
+                return 1;
+            }
+            path = value;
+        }
+        else if(option == "-t" || option == "--threads")
+        {
+            try {
+                threads = std::stoul(value);
+            } catch (const std::exception&) {
+                LOGIFACE_LOG(error, "Invalid thread count provided.");
+                return 1;
+            }
+        }
+        else if(option == "-s" || option == "--solution")
+        {
+            if(value != "0" && value != "1" && value != "2")
+            {
+                LOGIFACE_LOG(error, "Invalid solution option provided. Use 0, 1, or 2.");
+                return 1;
+            }
+            ambiguousCaseSolution = static_cast<AmbiguousCaseSolution>(value[0] - '0');
+        }
+        else if(option == "-l" || option == "--log-level")
+        {
+            logiface::logger* lg = logiface::get_logger();
+            if(!lg || !setLogLevel(*lg, value))
+            {
+                return 1;
+            }
+        }
+        else if(option == "--stats")
+        {
+            if(!parseStatsFormat(value, statsFormat))
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            LOGIFACE_LOGF(error, "Unknown solve file option {}.", std::string_view(option));
+            return 1;
+        }
+    }
+
+    TriangleFile file;
+    if(file.open(path, TriangleFile::Access::ReadWrite) != ResultCode::Success)
+    {
+        return 1;
+    }
+
+    ResultCode code;
+    if(threads != 1)
+    {
+        ThreadPool pool(threads);
+        code = TriangleCalculator::finalizeTriangles(file.columns(), file.unit(), pool, ambiguousCaseSolution);
+    }
+    else
+    {
+        code = TriangleCalculator::finalizeTriangles(file.columns(), file.unit(), ambiguousCaseSolution);
+    }
+    if(code != ResultCode::Success || file.sync() != ResultCode::Success)
+    {
+        return 1;
+    }
+    LOGIFACE_LOGF(info, "Solved {} triangles.", file.size());
+    printStats(statsFormat);
+    return 0;
+}
+
+int runGenerate(const std::vector<std::string>& args) {
+    if(args.size() < 3)
+    {
+        LOGIFACE_LOG(error, "Generate requires a triangle count and an output file (- for stdout).");
+        return 1;
+    }
+
+    std::uint64_t count = 0;
+    try {
+        count = std::stoull(args[1]);
+    } catch (const std::exception&) {
+        LOGIFACE_LOG(error, "Invalid triangle count provided.");
+        return 1;
+    }
+    const std::string& outputPath = args[2];
+    std::optional<StreamFormat> format;
+    std::size_t threads = 1;
+    GeneratorOptions options;
+
+    for(std::size_t i = 3; i < args.size(); ++i)
+    {
+        const std::string& option = args[i];
+        if(i + 1 >= args.size())
+        {
+            LOGIFACE_LOGF(error, "Option {} requires an argument.", std::string_view(option));
+            return 1;
+        }
+        const std::string& value = args[++i];
+
+        try {
+            if(option == "--format")
+            {
+                format = TriangleStream::parseFormat(value);
+                if(!format)
+                {
+                    LOGIFACE_LOG(error, "Invalid format provided. Use csv or ndjson.");
+                    return 1;
+                }
+            }
+            else if(option == "--seed")
+            {
+                options.seed = std::stoull(value);
+            }
+            else if(option == "--first")
+            {
+                options.firstRow = std::stoull(value);
+            }
+            else if(option == "--cases")
+            {
+                if(!TriangleGenerator::parseCases(value, options.mix))
+                {
+                    LOGIFACE_LOG(error, "Invalid case weights provided. Use e.g. SSS=2,SAS=1 with SSS, SAS, SSA, ASA or AAS.");
+                    return 1;
+                }
+            }
+            else if(option == "--shapes")
+            {
+                if(!TriangleGenerator::parseShapes(value, options.mix))
+                {
+                    LOGIFACE_LOG(error, "Invalid shape weights provided. Use e.g. right=1,scalene=3 with right, equilateral, isosceles or scalene.");
+                    return 1;
+                }
+            }
+            else if(option == "--ambiguous" || option == "--invalid")
+            {
+                const double fraction = std::stod(value);
+                if(!(fraction >= 0.0 && fraction <= 1.0))
+                {
+                    LOGIFACE_LOG(error, "Fractions have to be between 0 and 1.");
+                    return 1;
+                }
+                (option == "--ambiguous" ? options.mix.ambiguousFraction : options.mix.invalidFraction) = fraction;
+            }
+            else if(option == "-t" || option == "--threads")
+            {
+                threads = std::stoul(value);
+            }
+            else
+            {
+                LOGIFACE_LOGF(error, "Unknown generate option {}.", std::string_view(option));
+                return 1;
+            }
+        } catch (const std::exception&) {
+            LOGIFACE_LOGF(error, "Invalid value {} for option {}.", std::string_view(value), std::string_view(option));
+            return 1;
+        }
+    }
+
+    if(options.mix.ambiguousFraction + options.mix.invalidFraction > 1.0)
+    {
+        LOGIFACE_LOG(error, "The ambiguous and invalid fractions add up to more than 1.");
+        return 1;
+    }
+
+    std::unique_ptr<ThreadPool> pool;
+    if(threads != 1)
+    {
+        pool = std::make_unique<ThreadPool>(threads);
+        options.pool = pool.get();
+    }
+
+    ResultCode code;
+    if(isTriangleFile(outputPath))
+    {
+        code = TriangleGenerator::writeFile(outputPath, count, options);
+    }
+    else
+    {
+        if(!format)
+        {
+            const bool ndjson = outputPath.ends_with(".ndjson") || outputPath.ends_with(".jsonl");
+            format = ndjson ? StreamFormat::Ndjson : StreamFormat::Csv;
+        }
+        std::ofstream outputFile;
+        if(outputPath != "-")
+        {
+            outputFile.open(outputPath, std::ios::binary | std::ios::trunc);
+            if(!outputFile.is_open())
+            {
+                LOGIFACE_LOGF(error, "Unable to open output file {}.", std::string_view(outputPath));
+                return 1;
+            }
+        }
+        std::ostream& output = outputPath == "-" ? std::cout : static_cast<std::ostream&>(outputFile);
+        code = TriangleGenerator::write(output, *format, count, options);
+    }
+    if(code != ResultCode::Success)
+    {
+        return 1;
+    }
+    LOGIFACE_LOGF(info, "Generated {} triangles.", count);
+    return 0;
+}
+
+#if defined(__linux__)
+// the server to stop on SIGINT and SIGTERM, stop() only writes to an eventfd
+TriangleServer* g_server = nullptr;
+
+void stopServer(int) {
+    if(g_server)
+    {
+        g_server->stop();
+    }
+}
+
+int runServe(const std::vector<std::string>& args) {
+    if(args.size() < 2)
+    {
+        LOGIFACE_LOG(error, "Serve requires a socket path.");
+        return 1;
+    }
+
+    ServerOptions options;
+    options.socketPath = args[1];
+    std::size_t threads = 1;
+    StatsFormat statsFormat = StatsFormat::None;
+    for(std::size_t i = 2; i < args.size(); ++i)
+    {
+        const std::string& option = args[i];
+        if(i + 1 >= args.size())
+        {
+            LOGIFACE_LOGF(error, "Option {} requires an argument.", std::string_view(option));
+            return 1;
+        }
+        const std::string& value = args[++i];
+
+        if(option == "-t" || option == "--threads")
+        {
+            try {
+                threads = std::stoul(value);
+            } catch (const std::exception&) {
+                LOGIFACE_LOG(error, "Invalid thread count provided.");
+                return 1;
+            }
+        }
+        else if(option == "-s" || option == "--solution")
+        {
+            if(value != "0" && value != "1" && value != "2")
+            {
+                LOGIFACE_LOG(error, "Invalid solution option provided. Use 0, 1, or 2.");
+                return 1;
+            }
+            options.ambiguousCaseSolution = static_cast<AmbiguousCaseSolution>(value[0] - '0');
+        }
+        else if(option == "-l" || option == "--log-level")
+        {
+            logiface::logger* lg = logiface::get_logger();
+            if(!lg || !setLogLevel(*lg, value))
+            {
+                return 1;
+            }
+        }
+        else if(option == "--stats")
+        {
+            if(!parseStatsFormat(value, statsFormat))
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            LOGIFACE_LOGF(error, "Unknown serve option {}.", std::string_view(option));
+            return 1;
+        }
+    }
+
+    std::unique_ptr<ThreadPool> pool;
+    if(threads != 1)
+    {
+        pool = std::make_unique<ThreadPool>(threads);
+        options.pool = pool.get();
+    }
+    TriangleServer server(options);
+    if(server.listen() != ResultCode::Success)
+    {
+        return 1;
+    }
+    g_server = &server;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+    const ResultCode code = server.run();
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    g_server = nullptr;
+    printStats(statsFormat);
+    return code == ResultCode::Success ? 0 : 1;
+}
+#endif
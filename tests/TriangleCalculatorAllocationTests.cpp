@@ -0,0 +1,236 @@
+// Every solve path has to run without touching the heap while logging is off or filtered out.
+// This binary replaces the global allocation functions with counting ones, so it is kept apart
+// from TriangleCalculatorTests (whose file logger allocates per record).
+#include <gtest/gtest.h>
+
+#include <logging/logging.hpp>
+#include <nlohmann/json.hpp>
+
+#include <TriangleCalculatorLib/CompactTriangle.hpp>
+#include <TriangleCalculatorLib/Triangle.hpp>
+#include <TriangleCalculatorLib/TriangleBatch.hpp>
+#include <TriangleCalculatorLib/TriangleCache.hpp>
+#include <TriangleCalculatorLib/TriangleCalculator.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <vector>
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* memory, std::size_t size);
+}
+#endif
+
+using nlohmann::json;
+
+namespace {
+// allocations made by the current thread, the tests compare it before and after a solve
+thread_local std::uint64_t t_allocations = 0;
+
+void* CountedAllocate(std::size_t size, std::size_t alignment) {
+    ++t_allocations;
+    void* memory = alignment <= alignof(std::max_align_t)
+                       ? std::malloc(size ? size : 1)
+                       : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+} // namespace
+
+void* operator new(std::size_t size) { return CountedAllocate(size, alignof(std::max_align_t)); }
+void* operator new[](std::size_t size) { return CountedAllocate(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return CountedAllocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return CountedAllocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return CountedAllocate(size, alignof(std::max_align_t));
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+
+#if defined(__GLIBC__)
+// C allocations as well (operator new above goes through these too, a solve that allocates counts at least once)
+extern "C" {
+void* malloc(std::size_t size) {
+    ++t_allocations;
+    return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size) {
+    ++t_allocations;
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* memory, std::size_t size) {
+    ++t_allocations;
+    return __libc_realloc(memory, size);
+}
+}
+#endif
+
+namespace {
+using namespace TriangleCalculatorLib;
+
+// takes records without allocating, so enabled levels can be told apart from filtered ones
+class CountingLogger final : public logiface::logger {
+public:
+    explicit CountingLogger(logiface::level lvl) : level_(lvl) {}
+
+    void log(const logiface::record&) override { ++records; }
+    void set_level(logiface::level lvl) noexcept override { level_ = lvl; }
+    logiface::level get_level() const noexcept override { return level_; }
+
+    std::size_t records = 0;
+
+private:
+    logiface::level level_;
+};
+
+// installs a logger for the lifetime of the scope
+class ScopedLogger {
+public:
+    explicit ScopedLogger(logiface::logger* logger) { logiface::set_logger(logger); }
+    ~ScopedLogger() { logiface::set_logger(nullptr); }
+};
+
+std::vector<CompactTriangle> LoadFixtureMasks() {
+    std::ifstream input(std::filesystem::path(__FILE__).parent_path() / "triangles_fp.json");
+    if (!input.is_open()) {
+        ADD_FAILURE() << "Unable to open the fixture file";
+        return {};
+    }
+    json fixture;
+    input >> fixture;
+
+    // every combination of known fields of every fixture triangle, in degrees
+    std::vector<CompactTriangle> triangles;
+    for (const auto& category : {"right", "equilateral", "isosceles", "scalene"}) {
+        for (const auto& entry : fixture.at(category)) {
+            const auto& sides = entry.at("sides");
+            const auto& angles = entry.at("angles");
+            CompactTriangle triangle{sides.at(0).get<double>(), sides.at(1).get<double>(), sides.at(2).get<double>(),
+                                     angles.at(0).get<double>(), angles.at(1).get<double>(), angles.at(2).get<double>(), 0};
+            for (std::uint8_t known = 0; known <= KnownField::All; ++known) {
+                triangle.known = known;
+                triangles.push_back(triangle);
+            }
+        }
+    }
+    return triangles;
+}
+
+constexpr std::array Solutions{AmbiguousCaseSolution::NoSolution, AmbiguousCaseSolution::FirstSolution,
+                               AmbiguousCaseSolution::SecondSolution};
+constexpr std::array Precisions{Precision::Exact, Precision::Fast, Precision::Mixed};
+
+// the allocations of every single triangle entry point over the fixtures
+std::uint64_t ScalarSolveAllocations(const std::vector<CompactTriangle>& fixture) {
+    TriangleCache cache(256);
+    const std::uint64_t before = t_allocations;
+    for (const CompactTriangle& compact : fixture) {
+        const Triangle triangle = compact.toTriangle();
+        for (const AmbiguousCaseSolution solution : Solutions) {
+            for (const Precision precision : Precisions) {
+                const Result result = TriangleCalculator::finalizeTriangle(triangle, AngleUnit::Degrees, precision, solution);
+                Triangle inPlace = triangle;
+                const ResultCode code = TriangleCalculator::finalizeTriangleInPlace(inPlace, AngleUnit::Degrees, precision, solution);
+                EXPECT_EQ(code, result.code);
+            }
+            TriangleCalculator::finalizeTriangle(triangle, AngleUnit::Degrees, cache, solution);
+
+            BasicTriangle<float> narrow{compact.sideA, compact.sideB, compact.sideC, compact.angleA, compact.angleB, compact.angleC};
+            TriangleCalculator::finalizeTriangleInPlace(narrow, AngleUnit::Degrees, solution);
+            BasicTriangle<long double> wide{compact.sideA, compact.sideB, compact.sideC, compact.angleA, compact.angleB, compact.angleC};
+            TriangleCalculator::finalizeTriangleInPlace(wide, AngleUnit::Degrees, solution);
+        }
+    }
+    return t_allocations - before;
+}
+
+// the allocations of the batch entry points over the fixtures, their buffers are allocated up front
+std::uint64_t BatchSolveAllocations(const std::vector<CompactTriangle>& fixture) {
+    TriangleBatch input(fixture.size());
+    for (std::size_t i = 0; i < fixture.size(); ++i) {
+        input.set(i, fixture[i]);
+    }
+    TriangleBatch batch(fixture.size());
+    std::vector<CompactTriangle> compact(fixture.size());
+    std::vector<ResultCode> codes(fixture.size());
+
+    const std::uint64_t before = t_allocations;
+    for (const AmbiguousCaseSolution solution : Solutions) {
+        for (const Precision precision : Precisions) {
+            batch = input;
+            TriangleCalculator::finalizeTriangles(batch.columns(), AngleUnit::Degrees, precision, solution);
+            std::copy(fixture.begin(), fixture.end(), compact.begin());
+            TriangleCalculator::finalizeTriangles(compact, codes, AngleUnit::Degrees, precision, solution);
+        }
+    }
+    return t_allocations - before;
+}
+} // namespace
+
+TEST(TriangleCalculatorAllocationTests, CountingHooksSeeAllocations) {
+    const std::uint64_t before = t_allocations;
+    std::vector<int> values(16);
+    EXPECT_GT(t_allocations, before);
+    EXPECT_EQ(values.size(), 16u);
+}
+
+TEST(TriangleCalculatorAllocationTests, ScalarSolvesDoNotAllocate) {
+    const std::vector<CompactTriangle> fixture = LoadFixtureMasks();
+    ASSERT_FALSE(fixture.empty());
+
+    // no logger at all
+    EXPECT_EQ(ScalarSolveAllocations(fixture), 0u);
+
+    // a logger that filters out every level the solver logs at
+    CountingLogger logger(logiface::level::critical);
+    const ScopedLogger scope(&logger);
+    EXPECT_EQ(ScalarSolveAllocations(fixture), 0u);
+    EXPECT_EQ(logger.records, 0u);
+}
+
+TEST(TriangleCalculatorAllocationTests, BatchSolvesDoNotAllocate) {
+    const std::vector<CompactTriangle> fixture = LoadFixtureMasks();
+    ASSERT_FALSE(fixture.empty());
+
+    EXPECT_EQ(BatchSolveAllocations(fixture), 0u);
+
+    CountingLogger logger(logiface::level::critical);
+    const ScopedLogger scope(&logger);
+    EXPECT_EQ(BatchSolveAllocations(fixture), 0u);
+    EXPECT_EQ(logger.records, 0u);
+}
+
+TEST(TriangleCalculatorAllocationTests, EnabledLoggingFormatsWithoutAllocating) {
+    // the messages themselves are built in stack buffers, only a logger that stores them would allocate
+    const std::vector<CompactTriangle> fixture = LoadFixtureMasks();
+    ASSERT_FALSE(fixture.empty());
+
+    CountingLogger logger(logiface::level::trace);
+    const ScopedLogger scope(&logger);
+    EXPECT_EQ(ScalarSolveAllocations(fixture), 0u);
+    EXPECT_EQ(BatchSolveAllocations(fixture), 0u);
+    EXPECT_GT(logger.records, 0u);
+}
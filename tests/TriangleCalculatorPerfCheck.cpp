@@ -0,0 +1,351 @@
+// Performance regression check: solves a fixed workload (the fixture triangles per solver case and a large
+// synthetic mix) through the scalar and the batch API, measures ns/triangle and the peak RSS (where the platform
+// reports it) and compares them against a checked-in baseline. A metric fails when it is slower (or larger) than
+// its baseline value times its tolerance on every one of three attempts, so a noisy moment on a shared machine
+// does not fail it.
+//
+// Usage: TriangleCalculatorPerfCheck <baseline.json> [--update] [--force]
+//   --update  write the measured values into the baseline (keeping the tolerances) instead of comparing
+//   --force   measure even in a build without optimizations (NDEBUG unset), which is skipped otherwise
+//
+// Exit codes: 0 within the baseline, 1 regressed or failed, 77 skipped (CTest SKIP_RETURN_CODE)
+#include <nlohmann/json.hpp>
+
+#include <TriangleCalculatorLib/CompactTriangle.hpp>
+#include <TriangleCalculatorLib/Triangle.hpp>
+#include <TriangleCalculatorLib/TriangleBatch.hpp>
+#include <TriangleCalculatorLib/TriangleCalculator.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#define TRIANGLE_PERF_PEAK_RSS 1
+#endif
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace TriangleCalculatorLib;
+using nlohmann::json;
+
+namespace {
+// the cases of TriangleCalculatorBenchmarks, so a regression here can be looked at there
+enum class SolverCase {
+    SSS,
+    SAS,
+    SSAOneSolution,
+    SSATwoSolutions,
+    ASA,
+    AAS,
+    InsufficientData,
+    Count
+};
+
+constexpr std::array<const char*, static_cast<std::size_t>(SolverCase::Count)> CaseNames{
+    "SSS", "SAS", "SSAOneSolution", "SSATwoSolutions", "ASA", "AAS", "InsufficientData"};
+
+// every timed round runs at least this long, the fastest of the rounds is the measurement
+constexpr auto MinRoundTime = std::chrono::milliseconds(20);
+constexpr int Rounds = 5;
+constexpr std::size_t SyntheticSize = 1 << 18;
+constexpr double DefaultTolerance = 1.5;
+
+CompactTriangle Masked(const CompactTriangle& full, std::uint8_t known) {
+    CompactTriangle triangle{};
+    triangle.known = known;
+    triangle.sideA = (known & KnownField::SideA) ? full.sideA : 0.0;
+    triangle.sideB = (known & KnownField::SideB) ? full.sideB : 0.0;
+    triangle.sideC = (known & KnownField::SideC) ? full.sideC : 0.0;
+    triangle.angleA = (known & KnownField::AngleA) ? full.angleA : 0.0;
+    triangle.angleB = (known & KnownField::AngleB) ? full.angleB : 0.0;
+    triangle.angleC = (known & KnownField::AngleC) ? full.angleC : 0.0;
+    return triangle;
+}
+
+struct Workload {
+    std::array<std::vector<CompactTriangle>, static_cast<std::size_t>(SolverCase::Count)> cases;
+    std::vector<CompactTriangle> synthetic;
+};
+
+bool LoadFixtureCases(Workload& workload) {
+    std::ifstream input(TRIANGLE_FIXTURE_PATH);
+    if (!input.is_open()) {
+        std::cerr << "Unable to open fixture file at " << TRIANGLE_FIXTURE_PATH << "\n";
+        return false;
+    }
+    json fixture;
+    input >> fixture;
+
+    auto add = [&workload](SolverCase solverCase, const CompactTriangle& triangle) {
+        workload.cases[static_cast<std::size_t>(solverCase)].push_back(triangle);
+    };
+    for (const auto& category : {"right", "equilateral", "isosceles", "scalene"}) {
+        for (const auto& entry : fixture.at(category)) {
+            const auto& sides = entry.at("sides");
+            const auto& angles = entry.at("angles");
+            const CompactTriangle full{sides.at(0).get<double>(), sides.at(1).get<double>(), sides.at(2).get<double>(),
+                                       angles.at(0).get<double>(), angles.at(1).get<double>(), angles.at(2).get<double>(),
+                                       KnownField::All};
+            add(SolverCase::SSS, Masked(full, KnownField::Sides));
+            add(SolverCase::SAS, Masked(full, KnownField::SideA | KnownField::SideB | KnownField::AngleC));
+            add(SolverCase::ASA, Masked(full, KnownField::AngleA | KnownField::AngleB | KnownField::SideC));
+            add(SolverCase::AAS, Masked(full, KnownField::AngleA | KnownField::AngleB | KnownField::SideA));
+            add(SolverCase::InsufficientData, Masked(full, KnownField::SideA | KnownField::AngleA));
+
+            // a, b and the angle opposite the longer side has one solution, opposite the shorter one two
+            if (std::abs(full.sideA - full.sideB) > 1e-6 * std::max(full.sideA, full.sideB)) {
+                const bool aLonger = full.sideA > full.sideB;
+                const std::uint8_t ab = KnownField::SideA | KnownField::SideB;
+                add(SolverCase::SSAOneSolution, Masked(full, ab | (aLonger ? KnownField::AngleA : KnownField::AngleB)));
+                add(SolverCase::SSATwoSolutions, Masked(full, ab | (aLonger ? KnownField::AngleB : KnownField::AngleA)));
+            }
+        }
+    }
+    return true;
+}
+
+// random triangles (angles of at least 1 degree, sides spanning three orders of magnitude) under random masks
+std::vector<CompactTriangle> GenerateSynthetic(std::size_t count) {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> angle(1.0, 178.0);
+    std::uniform_real_distribution<double> scale(0.01, 10.0);
+    std::uniform_int_distribution<int> mask(0, KnownField::All);
+
+    std::vector<CompactTriangle> triangles;
+    triangles.reserve(count);
+    while (triangles.size() < count) {
+        const double angleA = angle(rng);
+        const double angleB = angle(rng);
+        const double angleC = 180.0 - angleA - angleB;
+        if (angleC < 1.0) {
+            continue;
+        }
+        const double factor = scale(rng);
+        auto side = [factor](double degrees) { return factor * std::sin(degrees * std::numbers::pi / 180.0); };
+        const CompactTriangle full{side(angleA), side(angleB), side(angleC), angleA, angleB, angleC, KnownField::All};
+        triangles.push_back(Masked(full, static_cast<std::uint8_t>(mask(rng))));
+    }
+    return triangles;
+}
+
+// the fastest ns/triangle of a few rounds, pass solves every triangle once and returns the time it spent solving
+template <typename Pass>
+double MeasureNsPerTriangle(std::size_t triangles, Pass pass) {
+    double best = 0.0;
+    for (int round = 0; round < Rounds; ++round) {
+        std::chrono::nanoseconds elapsed{0};
+        std::size_t solved = 0;
+        while (elapsed < MinRoundTime) {
+            elapsed += pass();
+            solved += triangles;
+        }
+        const double nsPerTriangle = static_cast<double>(elapsed.count()) / static_cast<double>(solved);
+        best = round == 0 ? nsPerTriangle : std::min(best, nsPerTriangle);
+    }
+    return best;
+}
+
+// the buffers of a probe are allocated when it is made, so measuring it again does not move the peak RSS
+std::function<double()> ScalarProbe(const std::vector<CompactTriangle>& input) {
+    auto triangles = std::make_shared<std::vector<Triangle>>();
+    for (const CompactTriangle& triangle : input) {
+        triangles->push_back(triangle.toTriangle());
+    }
+    auto work = std::make_shared<std::vector<Triangle>>(*triangles);
+    return [triangles, work] {
+        return MeasureNsPerTriangle(triangles->size(), [&] {
+            std::copy(triangles->begin(), triangles->end(), work->begin());
+            const auto start = std::chrono::steady_clock::now();
+            for (Triangle& triangle : *work) {
+                TriangleCalculator::finalizeTriangleInPlace(triangle, AngleUnit::Degrees, AmbiguousCaseSolution::FirstSolution);
+            }
+            return std::chrono::steady_clock::now() - start;
+        });
+    };
+}
+
+std::function<double()> BatchProbe(const std::vector<CompactTriangle>& input) {
+    auto triangles = std::make_shared<TriangleBatch>(input.size());
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        triangles->set(i, input[i]);
+    }
+    auto work = std::make_shared<TriangleBatch>(*triangles);
+    return [triangles, work] {
+        return MeasureNsPerTriangle(triangles->size(), [&] {
+            *work = *triangles;
+            const auto start = std::chrono::steady_clock::now();
+            TriangleCalculator::finalizeTriangles(work->columns(), AngleUnit::Degrees, AmbiguousCaseSolution::FirstSolution);
+            return std::chrono::steady_clock::now() - start;
+        });
+    };
+}
+
+// one measured quantity; measuring it again is how a suspected regression is confirmed
+struct Probe {
+    std::string name;
+    const char* unit;
+    std::function<double()> measure;
+};
+
+// the throughput probes run in order, peak RSS last so it covers all of them
+std::vector<Probe> MakeProbes(const Workload& workload) {
+    std::vector<Probe> probes;
+    for (std::size_t i = 0; i < workload.cases.size(); ++i) {
+        const std::vector<CompactTriangle>& triangles = workload.cases[i];
+        if (triangles.empty()) {
+            continue;
+        }
+        probes.push_back({"scalar." + std::string(CaseNames[i]), "ns/triangle", ScalarProbe(triangles)});
+        probes.push_back({"batch." + std::string(CaseNames[i]), "ns/triangle", BatchProbe(triangles)});
+    }
+    probes.push_back({"scalar.synthetic", "ns/triangle", ScalarProbe(workload.synthetic)});
+    probes.push_back({"batch.synthetic", "ns/triangle", BatchProbe(workload.synthetic)});
+#if defined(TRIANGLE_PERF_PEAK_RSS)
+    probes.push_back({"peak_rss", "KiB", [] {
+                          rusage usage{};
+                          getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+                          return static_cast<double>(usage.ru_maxrss) / 1024.0; // bytes on macOS
+#else
+                          return static_cast<double>(usage.ru_maxrss); // kilobytes on Linux and the BSDs
+#endif
+                      }});
+#endif
+    return probes;
+}
+
+// baseline metrics this platform has no way to measure, they are reported but do not fail the check
+bool Unmeasurable(const std::string& name) {
+#if defined(TRIANGLE_PERF_PEAK_RSS)
+    return false;
+#else
+    return name == "peak_rss";
+#endif
+}
+
+// a busy machine only ever makes a measurement worse, so the best of a few attempts is the one to trust
+constexpr int Attempts = 3;
+
+int Update(const std::string& path, json baseline, const std::vector<Probe>& probes) {
+    json& stored = baseline["metrics"];
+    for (const Probe& probe : probes) {
+        double best = probe.measure();
+        for (int attempt = 1; attempt < Attempts; ++attempt) {
+            best = std::min(best, probe.measure());
+        }
+        stored[probe.name]["value"] = std::round(best * 10.0) / 10.0;
+        stored[probe.name]["unit"] = probe.unit;
+    }
+    std::ofstream output(path, std::ios::trunc);
+    if (!output.is_open()) {
+        std::cerr << "Unable to write baseline " << path << "\n";
+        return 1;
+    }
+    output << baseline.dump(2) << "\n";
+    std::cout << "Updated " << probes.size() << " metrics in " << path << "\n";
+    return 0;
+}
+
+int Compare(const json& baseline, const std::vector<Probe>& probes) {
+    const double defaultTolerance = baseline.value("tolerance", DefaultTolerance);
+    const json& stored = baseline.at("metrics");
+
+    std::vector<double> values;
+    for (const Probe& probe : probes) {
+        values.push_back(probe.measure());
+    }
+    auto limit = [&](const Probe& probe) {
+        return stored.at(probe.name).value("tolerance", defaultTolerance) * stored.at(probe.name).at("value").get<double>();
+    };
+    // suspects are measured again after a full pass, so a slow moment of the machine does not hit every attempt
+    for (int attempt = 1; attempt < Attempts; ++attempt) {
+        for (std::size_t i = 0; i < probes.size(); ++i) {
+            if (stored.contains(probes[i].name) && values[i] > limit(probes[i])) {
+                values[i] = std::min(values[i], probes[i].measure());
+            }
+        }
+    }
+
+    int regressions = 0;
+    std::printf("%-28s %12s %12s %8s %10s\n", "metric", "baseline", "measured", "ratio", "limit");
+    for (std::size_t i = 0; i < probes.size(); ++i) {
+        const Probe& probe = probes[i];
+        const double value = values[i];
+        if (!stored.contains(probe.name)) {
+            std::printf("%-28s %12s %12.1f %8s %10s  new, not in the baseline\n", probe.name.c_str(), "-", value, "-", "-");
+            continue;
+        }
+        const double expected = stored.at(probe.name).at("value").get<double>();
+        const double tolerance = stored.at(probe.name).value("tolerance", defaultTolerance);
+        const double ratio = expected > 0.0 ? value / expected : 0.0;
+        const bool regressed = value > limit(probe);
+        regressions += regressed;
+        std::printf("%-28s %12.1f %12.1f %7.2fx %9.2fx%s\n", probe.name.c_str(), expected, value, ratio, tolerance,
+                    regressed ? "  REGRESSED" : ratio * tolerance < 1.0 ? "  faster, consider --update" : "");
+    }
+    for (const auto& [name, value] : stored.items()) {
+        const bool measured = std::any_of(probes.begin(), probes.end(), [&name](const Probe& probe) { return probe.name == name; });
+        if (!measured && Unmeasurable(name)) {
+            std::printf("%-28s skipped, not measurable on this platform\n", name.c_str());
+        } else if (!measured) {
+            std::printf("%-28s missing, the check no longer measures it\n", name.c_str());
+            ++regressions;
+        }
+    }
+
+    if (regressions > 0) {
+        std::printf("%d metrics outside their tolerance\n", regressions);
+        return 1;
+    }
+    std::printf("all metrics within their tolerance\n");
+    return 0;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <baseline.json> [--update] [--force]\n";
+        return 1;
+    }
+    const std::string baselinePath = args[0];
+    const bool update = std::find(args.begin(), args.end(), "--update") != args.end();
+
+#ifndef NDEBUG
+    if (std::find(args.begin(), args.end(), "--force") == args.end()) {
+        std::cout << "Skipped: the baseline is for optimized builds (configure with -DCMAKE_BUILD_TYPE=Release)\n";
+        return 77;
+    }
+#endif
+
+    json baseline;
+    {
+        std::ifstream input(baselinePath);
+        if (input.is_open()) {
+            input >> baseline;
+        } else if (!update) {
+            std::cerr << "Unable to open baseline " << baselinePath << "\n";
+            return 1;
+        }
+    }
+
+    Workload workload;
+    if (!LoadFixtureCases(workload)) {
+        return 1;
+    }
+    workload.synthetic = GenerateSynthetic(SyntheticSize);
+
+    const std::vector<Probe> probes = MakeProbes(workload);
+    return update ? Update(baselinePath, baseline, probes) : Compare(baseline, probes);
+}
@@ -1,26 +1,59 @@
 #include <gtest/gtest.h>
 
+#include <logging/async_logger.hpp>
 #include <logging/logging.hpp>
+#include <logging/rate_limited_logger.hpp>
 #include <nlohmann/json.hpp>
 
 #include <TriangleCalculatorLib/Triangle.hpp>
 #include <TriangleCalculatorLib/ReturnCode.hpp>
+#include <TriangleCalculatorLib/ConstexprTriangleSolver.hpp>
+#include <TriangleCalculatorLib/FastMath.hpp>
+#include <TriangleCalculatorLib/SimdLevel.hpp>
+#include <TriangleCalculatorLib/SolverStats.hpp>
+#include <TriangleCalculatorLib/ThreadPool.hpp>
+#include <TriangleCalculatorLib/TriangleAsync.hpp>
+#include <TriangleCalculatorLib/TriangleBatch.hpp>
+#include <TriangleCalculatorLib/TriangleCache.hpp>
 #include <TriangleCalculatorLib/TriangleCalculator.hpp>
+#include <TriangleCalculatorLib/TriangleFile.hpp>
+#include <TriangleCalculatorLib/TriangleGenerator.hpp>
+#include <TriangleCalculatorLib/TriangleJson.hpp>
+#include <TriangleCalculatorLib/TriangleServer.hpp>
+#include <TriangleCalculatorLib/TriangleStream.hpp>
 
 #include <array>
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cmath>
+#include <coroutine>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <optional>
 #include <random>
 #include <sstream>
+#include <stop_token>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "test_logging.hpp"
 
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
 using TriangleCalculatorLib::Triangle;
+using TriangleCalculatorLib::TriangleBatch;
 using TriangleCalculatorLib::TriangleCalculator;
 using nlohmann::json;
 
@@ -396,6 +429,208 @@ void RunFinalizeTriangleTest(Difficulty difficulty) {
     
     GTEST_LOG_(INFO) << "All triangles tested successfully. Total triangles tested: " << trianglesTested;
 }
+
+void ExpectFieldMatches(const std::optional<double>& batch, const std::optional<double>& scalar, const char* name) {
+    ASSERT_EQ(batch.has_value(), scalar.has_value()) << name << " known state differs";
+    if (scalar) {
+        EXPECT_NEAR(*batch, *scalar, 1e-9) << name << " mismatch";
+    }
+}
+
+// The batch API must give the same answer as calling the scalar API on every row.
+void RunFinalizeTrianglesBatchTest(Difficulty difficulty) {
+    using TriangleCalculatorLib::AmbiguousCaseSolution;
+
+    const json fixture = LoadFixture();
+    std::mt19937 rng(fixture.at("seed").get<uint32_t>());
+
+    const auto expectedTriangles = CollectAllTriangles(fixture);
+    ASSERT_FALSE(expectedTriangles.empty());
+
+    std::vector<Triangle> partials;
+    TriangleBatch batch(expectedTriangles.size());
+    for (std::size_t i = 0; i < expectedTriangles.size(); ++i) {
+        partials.push_back(GeneratePartialTriangle(expectedTriangles[i], difficulty, rng).partial);
+        batch.set(i, partials.back());
+    }
+
+    ASSERT_EQ(TriangleCalculator::finalizeTriangles(batch.columns(), AmbiguousCaseSolution::FirstSolution),
+              TriangleCalculatorLib::ResultCode::Success);
+
+    for (std::size_t i = 0; i < partials.size(); ++i) {
+        const auto scalar = TriangleCalculator::finalizeTriangle(partials[i], AmbiguousCaseSolution::FirstSolution);
+        const Triangle solved = batch.get(i);
+        SCOPED_TRACE('\n' + FormatTrace(partials[i], scalar.triangle, solved));
+
+        EXPECT_EQ(batch.code(i), scalar.code);
+        ExpectFieldMatches(solved.sideA, scalar.triangle.sideA, "sideA");
+        ExpectFieldMatches(solved.sideB, scalar.triangle.sideB, "sideB");
+        ExpectFieldMatches(solved.sideC, scalar.triangle.sideC, "sideC");
+        ExpectFieldMatches(solved.angleA, scalar.triangle.angleA, "angleA");
+        ExpectFieldMatches(solved.angleB, scalar.triangle.angleB, "angleB");
+        ExpectFieldMatches(solved.angleC, scalar.triangle.angleC, "angleC");
+    }
+}
+
+// Build a batch where every triangle keeps only the fields in `keep` (KnownField bits).
+TriangleBatch MakeHomogeneousBatch(const std::vector<Triangle>& triangles, std::uint8_t keep) {
+    using namespace TriangleCalculatorLib;
+    TriangleBatch batch(triangles.size());
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+        Triangle t = triangles[i];
+        if (!(keep & KnownField::SideA)) { t.sideA.reset(); }
+        if (!(keep & KnownField::SideB)) { t.sideB.reset(); }
+        if (!(keep & KnownField::SideC)) { t.sideC.reset(); }
+        if (!(keep & KnownField::AngleA)) { t.angleA.reset(); }
+        if (!(keep & KnownField::AngleB)) { t.angleB.reset(); }
+        if (!(keep & KnownField::AngleC)) { t.angleC.reset(); }
+        batch.set(i, t);
+    }
+    return batch;
+}
+
+// Logger that keeps every record it receives, installed as the global logger for its lifetime unless used as a sink.
+class CapturingLogger final : public logiface::logger {
+public:
+    explicit CapturingLogger(logiface::level minLevel, bool install = true)
+        : minLevel_(minLevel), previous_(logiface::get_logger()), installed_(install) {
+        if (installed_) {
+            logiface::set_logger(this);
+        }
+    }
+    ~CapturingLogger() override {
+        if (installed_) {
+            logiface::set_logger(previous_);
+        }
+    }
+
+    void log(const logiface::record& r) override {
+        if (onLog) {
+            onLog();
+        }
+        messages.emplace_back(r.message);
+    }
+    void set_level(logiface::level lvl) noexcept override { minLevel_ = lvl; }
+    logiface::level get_level() const noexcept override { return minLevel_; }
+
+    std::vector<std::string> messages;
+    std::function<void()> onLog;
+
+private:
+    logiface::level minLevel_;
+    logiface::logger* previous_;
+    bool installed_;
+};
+
+logiface::record MakeRecord(std::string_view message) {
+    return logiface::record{logiface::level::info, message, __FILE__, __func__, __LINE__, std::chrono::system_clock::now()};
+}
+
+// Solve a homogeneous batch at every SIMD level the machine supports and compare against the scalar API.
+void RunSimdLevelTest(std::uint8_t keep, bool compareToFixture = true) {
+    using namespace TriangleCalculatorLib;
+
+    const auto expectedTriangles = CollectAllTriangles(LoadFixture());
+    ASSERT_FALSE(expectedTriangles.empty());
+    const SimdLevel original = activeSimdLevel();
+
+    for (int level = 0; level <= static_cast<int>(detectedSimdLevel()); ++level) {
+        const auto simdLevel = static_cast<SimdLevel>(level);
+        SCOPED_TRACE(std::string("SIMD level: ") + std::string(to_string(simdLevel)));
+        ASSERT_TRUE(setSimdLevel(simdLevel));
+
+        TriangleBatch batch = MakeHomogeneousBatch(expectedTriangles, keep);
+        const TriangleBatch input = batch;
+        ASSERT_EQ(TriangleCalculator::finalizeTriangles(batch.columns()), ResultCode::Success);
+
+        for (std::size_t i = 0; i < expectedTriangles.size(); ++i) {
+            const auto scalar = TriangleCalculator::finalizeTriangle(input.get(i));
+            const Triangle solved = batch.get(i);
+            SCOPED_TRACE('\n' + FormatTrace(input.get(i), scalar.triangle, solved));
+
+            EXPECT_EQ(batch.code(i), scalar.code);
+            ExpectFieldMatches(solved.sideA, scalar.triangle.sideA, "sideA");
+            ExpectFieldMatches(solved.sideB, scalar.triangle.sideB, "sideB");
+            ExpectFieldMatches(solved.sideC, scalar.triangle.sideC, "sideC");
+            ExpectFieldMatches(solved.angleA, scalar.triangle.angleA, "angleA");
+            ExpectFieldMatches(solved.angleB, scalar.triangle.angleB, "angleB");
+            ExpectFieldMatches(solved.angleC, scalar.triangle.angleC, "angleC");
+            if (compareToFixture) {
+                ExpectTriangleClose(solved, expectedTriangles[i]);
+            }
+        }
+    }
+
+    setSimdLevel(original);
+}
+
+// A file name in the temp directory no other test run uses at the same time.
+std::filesystem::path TempPath(const std::string& name) {
+#if defined(_WIN32)
+    const int pid = ::_getpid();
+#else
+    const int pid = ::getpid();
+#endif
+    return std::filesystem::temp_directory_path() / (std::to_string(pid) + '-' + name);
+}
+
+// Compare solved CSV text line by line: the header and the code column exactly, the values within
+// tolerance since their last digits depend on the kernels picked for the CPU.
+void ExpectSolvedCsv(const std::string& actual, const std::string& expected) {
+    using namespace TriangleCalculatorLib;
+
+    std::istringstream actualLines(actual);
+    std::istringstream expectedLines(expected);
+    std::string got;
+    std::string want;
+    ASSERT_TRUE(std::getline(actualLines, got));
+    ASSERT_TRUE(std::getline(expectedLines, want));
+    EXPECT_EQ(got, want);
+    while (std::getline(expectedLines, want)) {
+        ASSERT_TRUE(std::getline(actualLines, got)) << "missing row " << want;
+        SCOPED_TRACE(got + " vs " + want);
+        const std::size_t gotCode = got.rfind(',');
+        const std::size_t wantCode = want.rfind(',');
+        EXPECT_EQ(got.substr(gotCode + 1), want.substr(wantCode + 1));
+        const auto gotValues = TriangleStream::parseCsvLine(got.substr(0, gotCode));
+        const auto wantValues = TriangleStream::parseCsvLine(want.substr(0, wantCode));
+        ASSERT_TRUE(gotValues && wantValues);
+        const Triangle solved = gotValues->toTriangle();
+        const Triangle reference = wantValues->toTriangle();
+        ExpectFieldMatches(solved.sideA, reference.sideA, "sideA");
+        ExpectFieldMatches(solved.sideB, reference.sideB, "sideB");
+        ExpectFieldMatches(solved.sideC, reference.sideC, "sideC");
+        ExpectFieldMatches(solved.angleA, reference.angleA, "angleA");
+        ExpectFieldMatches(solved.angleB, reference.angleB, "angleB");
+        ExpectFieldMatches(solved.angleC, reference.angleC, "angleC");
+    }
+    EXPECT_FALSE(std::getline(actualLines, got)) << "extra row " << got;
+}
+
+// The same for NDJSON: numbers within tolerance, nulls and codes exactly.
+void ExpectSolvedNdjson(const std::string& actual, const std::string& expected) {
+    std::istringstream actualLines(actual);
+    std::istringstream expectedLines(expected);
+    std::string got;
+    std::string want;
+    while (std::getline(expectedLines, want)) {
+        ASSERT_TRUE(std::getline(actualLines, got)) << "missing row " << want;
+        SCOPED_TRACE(got + " vs " + want);
+        const json solved = json::parse(got);
+        const json reference = json::parse(want);
+        ASSERT_EQ(solved.size(), reference.size());
+        for (const auto& [key, value] : reference.items()) {
+            ASSERT_TRUE(solved.contains(key)) << key;
+            if (value.is_number()) {
+                ASSERT_TRUE(solved[key].is_number()) << key;
+                EXPECT_NEAR(solved[key].get<double>(), value.get<double>(), 1e-9) << key;
+            } else {
+                EXPECT_EQ(solved[key], value) << key;
+            }
+        }
+    }
+    EXPECT_FALSE(std::getline(actualLines, got)) << "extra row " << got;
+}
 }  // namespace
 
 TEST(TriangleCalculatorTests, FinalizeTriangleBasicSingleMissingValue) {
@@ -408,4 +643,1447 @@ TEST(TriangleCalculatorTests, FinalizeTriangleAdvancedMultipleMissingValues) {
 
 TEST(TriangleCalculatorTests, FinalizeTriangleHardEdgeCases) {
     RunFinalizeTriangleTest(Difficulty::HardEdge);
-}
\ No newline at end of file
+}
+
+TEST(TriangleCalculatorTests, FinalizeTrianglesBatchMatchesScalar) {
+    RunFinalizeTrianglesBatchTest(Difficulty::Basic);
+    RunFinalizeTrianglesBatchTest(Difficulty::Advanced);
+    RunFinalizeTrianglesBatchTest(Difficulty::HardEdge);
+}
+
+TEST(TriangleCalculatorTests, FinalizeTrianglesRejectsMismatchedColumns) {
+    TriangleBatch batch(4);
+    auto columns = batch.columns();
+    columns.sideB = columns.sideB.first(3);
+    EXPECT_EQ(TriangleCalculator::finalizeTriangles(columns), TriangleCalculatorLib::ResultCode::InvalidData);
+}
+
+TEST(TriangleCalculatorTests, SimdKernelsSolveSSSBatches) {
+    RunSimdLevelTest(TriangleCalculatorLib::KnownField::Sides);
+}
+
+TEST(TriangleCalculatorTests, SimdKernelsSolveSASBatches) {
+    using TriangleCalculatorLib::KnownField::AngleA;
+    using TriangleCalculatorLib::KnownField::SideB;
+    using TriangleCalculatorLib::KnownField::SideC;
+    RunSimdLevelTest(SideB | SideC | AngleA);
+}
+
+TEST(TriangleCalculatorTests, BatchKernelsSolveAASAndASABatches) {
+    using namespace TriangleCalculatorLib::KnownField;
+    RunSimdLevelTest(SideA | AngleA | AngleB);
+    RunSimdLevelTest(SideC | AngleA | AngleB);
+    RunSimdLevelTest(SideB | SideC | AngleA | AngleC);
+}
+
+TEST(TriangleCalculatorTests, BatchKernelsSolveRotatedSASAndSSABatches) {
+    using namespace TriangleCalculatorLib::KnownField;
+    RunSimdLevelTest(SideA | SideC | AngleB);
+    RunSimdLevelTest(SideA | SideB | AngleC);
+    // SSA may legitimately pick the other ambiguous solution than the fixture, only compare with the scalar path
+    RunSimdLevelTest(SideA | SideB | AngleA, false);
+    RunSimdLevelTest(SideC | SideA | AngleC, false);
+    RunSimdLevelTest(SideB | SideC | AngleC, false);
+}
+
+TEST(TriangleCalculatorTests, CompactTriangleRoundTripsThroughTriangle) {
+    using TriangleCalculatorLib::CompactTriangle;
+    namespace KnownField = TriangleCalculatorLib::KnownField;
+
+    Triangle triangle;
+    triangle.sideA = 3.0;
+    triangle.sideC = 5.0;
+    triangle.angleB = 90.0;
+
+    const CompactTriangle compact = CompactTriangle::fromTriangle(triangle);
+    EXPECT_EQ(compact.known, KnownField::SideA | KnownField::SideC | KnownField::AngleB);
+    EXPECT_TRUE(compact.isKnown(KnownField::SideA | KnownField::SideC));
+    EXPECT_FALSE(compact.isKnown(KnownField::SideB));
+    EXPECT_EQ(compact.sideB, 0.0);
+
+    const Triangle back = compact.toTriangle();
+    EXPECT_EQ(back.sideA, triangle.sideA);
+    EXPECT_EQ(back.sideB, std::nullopt);
+    EXPECT_EQ(back.sideC, triangle.sideC);
+    EXPECT_EQ(back.angleA, std::nullopt);
+    EXPECT_EQ(back.angleB, triangle.angleB);
+    EXPECT_EQ(back.angleC, std::nullopt);
+}
+
+TEST(TriangleCalculatorTests, FinalizeCompactTrianglesMatchesColumns) {
+    using TriangleCalculatorLib::AmbiguousCaseSolution;
+    using TriangleCalculatorLib::CompactTriangle;
+    using TriangleCalculatorLib::ResultCode;
+
+    const json fixture = LoadFixture();
+    std::mt19937 rng(fixture.at("seed").get<uint32_t>());
+    const auto expectedTriangles = CollectAllTriangles(fixture);
+
+    TriangleBatch batch(expectedTriangles.size());
+    std::vector<CompactTriangle> compact;
+    for (std::size_t i = 0; i < expectedTriangles.size(); ++i) {
+        const Triangle partial = GeneratePartialTriangle(expectedTriangles[i], Difficulty::HardEdge, rng).partial;
+        batch.set(i, partial);
+        compact.push_back(CompactTriangle::fromTriangle(partial));
+    }
+    std::vector<CompactTriangle> single = compact;
+
+    std::vector<ResultCode> codes(compact.size());
+    ASSERT_EQ(TriangleCalculator::finalizeTriangles(batch.columns(), AmbiguousCaseSolution::FirstSolution), ResultCode::Success);
+    ASSERT_EQ(TriangleCalculator::finalizeTriangles(compact, codes, AmbiguousCaseSolution::FirstSolution), ResultCode::Success);
+
+    for (std::size_t i = 0; i < compact.size(); ++i) {
+        SCOPED_TRACE("row " + std::to_string(i));
+        const CompactTriangle columns = batch.getCompact(i);
+        EXPECT_EQ(codes[i], batch.code(i));
+        EXPECT_EQ(TriangleCalculator::finalizeTriangle(single[i], AmbiguousCaseSolution::FirstSolution), batch.code(i));
+        for (const CompactTriangle& solved : {compact[i], single[i]}) {
+            EXPECT_EQ(solved.known, columns.known);
+            EXPECT_EQ(solved.sideA, columns.sideA);
+            EXPECT_EQ(solved.sideB, columns.sideB);
+            EXPECT_EQ(solved.sideC, columns.sideC);
+            EXPECT_EQ(solved.angleA, columns.angleA);
+            EXPECT_EQ(solved.angleB, columns.angleB);
+            EXPECT_EQ(solved.angleC, columns.angleC);
+        }
+    }
+
+    std::vector<ResultCode> tooShort(compact.size() - 1);
+    EXPECT_EQ(TriangleCalculator::finalizeTriangles(compact, tooShort), ResultCode::InvalidData);
+}
+
+TEST(TriangleCalculatorTests, RadianApiMatchesDegreeApi) {
+    using TriangleCalculatorLib::AmbiguousCaseSolution;
+    using TriangleCalculatorLib::AngleUnit;
+    using TriangleCalculatorLib::ResultCode;
+
+    const json fixture = LoadFixture();
+    std::mt19937 rng(fixture.at("seed").get<uint32_t>());
+    const auto expectedTriangles = CollectAllTriangles(fixture);
+
+    auto scaleAngles = [](Triangle triangle, double factor) {
+        for (auto* angle : {&triangle.angleA, &triangle.angleB, &triangle.angleC}) {
+            if (angle->has_value()) {
+                **angle *= factor;
+            }
+        }
+        return triangle;
+    };
+
+    TriangleBatch radianBatch(expectedTriangles.size());
+    std::vector<Triangle> partials;
+    for (std::size_t i = 0; i < expectedTriangles.size(); ++i) {
+        partials.push_back(GeneratePartialTriangle(expectedTriangles[i], Difficulty::Advanced, rng).partial);
+        radianBatch.set(i, scaleAngles(partials.back(), M_PI / 180.0));
+    }
+    ASSERT_EQ(TriangleCalculator::finalizeTriangles(radianBatch.columns(), AngleUnit::Radians, AmbiguousCaseSolution::FirstSolution),
+              ResultCode::Success);
+
+    for (std::size_t i = 0; i < partials.size(); ++i) {
+        const auto degrees = TriangleCalculator::finalizeTriangle(partials[i], AmbiguousCaseSolution::FirstSolution);
+        const auto radians = TriangleCalculator::finalizeTriangle(scaleAngles(partials[i], M_PI / 180.0), AngleUnit::Radians,
+                                                                  AmbiguousCaseSolution::FirstSolution);
+        Triangle inPlace = partials[i];
+        const ResultCode inPlaceCode = TriangleCalculator::finalizeTriangleInPlace(inPlace, AngleUnit::Degrees,
+                                                                                   AmbiguousCaseSolution::FirstSolution);
+        SCOPED_TRACE('\n' + FormatTrace(partials[i], degrees.triangle, radians.triangle));
+
+        EXPECT_EQ(radians.code, degrees.code);
+        EXPECT_EQ(inPlaceCode, degrees.code);
+        EXPECT_EQ(radianBatch.code(i), degrees.code);
+        const Triangle fromRadians = scaleAngles(radians.triangle, 180.0 / M_PI);
+        const Triangle fromBatch = scaleAngles(radianBatch.get(i), 180.0 / M_PI);
+        for (const Triangle* solved : std::initializer_list<const Triangle*>{&fromRadians, &fromBatch, &inPlace}) {
+            ExpectFieldMatches(solved->sideA, degrees.triangle.sideA, "sideA");
+            ExpectFieldMatches(solved->sideB, degrees.triangle.sideB, "sideB");
+            ExpectFieldMatches(solved->sideC, degrees.triangle.sideC, "sideC");
+            ExpectFieldMatches(solved->angleA, degrees.triangle.angleA, "angleA");
+            ExpectFieldMatches(solved->angleB, degrees.triangle.angleB, "angleB");
+            ExpectFieldMatches(solved->angleC, degrees.triangle.angleC, "angleC");
+        }
+    }
+}
+
+TEST(TriangleCalculatorTests, ConstexprSolverMatchesRuntimeSolver) {
+    using namespace TriangleCalculatorLib;
+
+    // solved entirely at compile time
+    constexpr CompactTriangle right = ConstexprTriangleSolver::solved({3, 4, 5, 0, 0, 0, KnownField::Sides});
+    static_assert(right.known == KnownField::All);
+    static_assert(detail::IsEqual(right.angleC, 90.0, 1e-12));
+    static_assert(detail::IsEqual(IntegerDegreeSines[30], 0.5, 1e-15));
+    static_assert(detail::IsEqual(IntegerDegreeCosines[60], 0.5, 1e-15));
+    constexpr CompactTriangle partial = ConstexprTriangleSolver::solved({1, 0, 0, 30, 0, 0, KnownField::SideA | KnownField::AngleA});
+    static_assert(partial.known == (KnownField::SideA | KnownField::AngleA));
+
+    for (std::size_t degrees = 0; degrees < 360; ++degrees) {
+        const double radians = static_cast<double>(degrees) * M_PI / 180.0;
+        EXPECT_NEAR(IntegerDegreeSines[degrees], std::sin(radians), 1e-15) << degrees;
+        EXPECT_NEAR(IntegerDegreeCosines[degrees], std::cos(radians), 1e-15) << degrees;
+    }
+    for (double x = -1.0; x <= 1.0; x += 1.0 / 64) {
+        EXPECT_NEAR(ConstexprMath::acos(x), std::acos(x), 1e-15) << x;
+        EXPECT_NEAR(ConstexprMath::asin(x), std::asin(x), 1e-15) << x;
+        EXPECT_NEAR(ConstexprMath::sqrt(x + 1.0), std::sqrt(x + 1.0), 1e-15) << x;
+    }
+
+    // the same case decisions and results as the runtime solver, for every mask of three or more fields
+    const auto triangles = CollectAllTriangles(LoadFixture());
+    ASSERT_FALSE(triangles.empty());
+    for (const auto& full : triangles) {
+        const CompactTriangle compact = CompactTriangle::fromTriangle(full);
+        for (std::uint8_t known = 0; known <= KnownField::All; ++known) {
+            CompactTriangle input = compact;
+            input.known = known;
+            const Triangle masked = input.toTriangle();
+            for (const auto solution : {AmbiguousCaseSolution::FirstSolution, AmbiguousCaseSolution::SecondSolution}) {
+                const Result expected = TriangleCalculator::finalizeTriangle(masked, solution);
+                CompactTriangle actual = CompactTriangle::fromTriangle(masked);
+                ASSERT_EQ(ConstexprTriangleSolver::solve(actual, AngleUnit::Degrees, solution), expected.code);
+                const CompactTriangle expectedCompact = CompactTriangle::fromTriangle(expected.triangle);
+                ASSERT_EQ(actual.known, expectedCompact.known) << PrintTriangle(masked);
+                EXPECT_NEAR(actual.sideA, expectedCompact.sideA, 1e-9 * std::max(1.0, expectedCompact.sideA));
+                EXPECT_NEAR(actual.sideB, expectedCompact.sideB, 1e-9 * std::max(1.0, expectedCompact.sideB));
+                EXPECT_NEAR(actual.sideC, expectedCompact.sideC, 1e-9 * std::max(1.0, expectedCompact.sideC));
+                EXPECT_NEAR(actual.angleA, expectedCompact.angleA, 1e-9);
+                EXPECT_NEAR(actual.angleB, expectedCompact.angleB, 1e-9);
+                EXPECT_NEAR(actual.angleC, expectedCompact.angleC, 1e-9);
+            }
+        }
+    }
+}
+
+TEST(TriangleCalculatorTests, FastPrecisionStaysWithinDocumentedBounds) {
+    using namespace TriangleCalculatorLib;
+
+    for (double x = -4 * M_PI; x <= 4 * M_PI; x += 1e-4) {
+        EXPECT_LE(std::abs(FastMath::sin(x) - std::sin(x)), FastMath::sinCosMaxRelativeError * std::abs(std::sin(x))) << x;
+        EXPECT_LE(std::abs(FastMath::cos(x) - std::cos(x)), FastMath::sinCosMaxRelativeError * std::abs(std::cos(x))) << x;
+    }
+    for (double x = -1.0; x <= 1.0; x += 1e-5) {
+        EXPECT_LE(std::abs(FastMath::asin(x) - std::asin(x)), FastMath::asinAcosMaxAbsoluteError) << x;
+        EXPECT_LE(std::abs(FastMath::acos(x) - std::acos(x)), FastMath::asinAcosMaxAbsoluteError) << x;
+    }
+
+    // every mask of the fixtures through the scalar and the batch solver, against the exact tier
+    auto expectWithinTolerance = [](const CompactTriangle& fast, const CompactTriangle& exact) {
+        ASSERT_EQ(fast.known, exact.known);
+        const std::array<double, 6> fastValues{fast.sideA, fast.sideB, fast.sideC, fast.angleA, fast.angleB, fast.angleC};
+        const std::array<double, 6> exactValues{exact.sideA, exact.sideB, exact.sideC, exact.angleA, exact.angleB, exact.angleC};
+        for (std::size_t i = 0; i < fastValues.size(); ++i) {
+            if (exact.known & (1u << i)) {
+                EXPECT_NEAR(fastValues[i], exactValues[i], FAST_PRECISION_TOLERANCE * std::max(1.0, std::abs(exactValues[i]))) << i;
+            }
+        }
+    };
+
+    const auto triangles = CollectAllTriangles(LoadFixture());
+    ASSERT_FALSE(triangles.empty());
+    std::vector<CompactTriangle> exactBatch;
+    for (const auto& full : triangles) {
+        const CompactTriangle compact = CompactTriangle::fromTriangle(full);
+        for (std::uint8_t known = 0; known <= KnownField::All; ++known) {
+            CompactTriangle input = compact;
+            input.known = known;
+            exactBatch.push_back(input);
+
+            const Triangle masked = input.toTriangle();
+            const Result exact = TriangleCalculator::finalizeTriangle(masked, AngleUnit::Degrees, AmbiguousCaseSolution::FirstSolution);
+            const Result fast = TriangleCalculator::finalizeTriangle(masked, AngleUnit::Degrees, Precision::Fast,
+                                                                     AmbiguousCaseSolution::FirstSolution);
+            SCOPED_TRACE(PrintTriangle(masked));
+            ASSERT_EQ(fast.code, exact.code);
+            expectWithinTolerance(CompactTriangle::fromTriangle(fast.triangle), CompactTriangle::fromTriangle(exact.triangle));
+        }
+    }
+
+    std::vector<CompactTriangle> fastBatch = exactBatch;
+    std::vector<ResultCode> exactCodes(exactBatch.size());
+    std::vector<ResultCode> fastCodes(fastBatch.size());
+    ASSERT_EQ(TriangleCalculator::finalizeTriangles(exactBatch, exactCodes, AngleUnit::Degrees, AmbiguousCaseSolution::FirstSolution),
+              ResultCode::Success);
+    ASSERT_EQ(TriangleCalculator::finalizeTriangles(fastBatch, fastCodes, AngleUnit::Degrees, Precision::Fast,
+                                                    AmbiguousCaseSolution::FirstSolution),
+              ResultCode::Success);
+    for (std::size_t i = 0; i < exactBatch.size(); ++i) {
+        SCOPED_TRACE(PrintTriangle(exactBatch[i].toTriangle()));
+        ASSERT_EQ(fastCodes[i], exactCodes[i]);
+        expectWithinTolerance(fastBatch[i], exactBatch[i]);
+    }
+}
+
+TEST(TriangleCalculatorTests, FloatAndLongDoubleSolversMatchDouble) {
+    using namespace TriangleCalculatorLib;
+
+    static_assert(ToleranceTraits<double>::absolute == detail::ABSOLUTE_TOLERANCE);
+    static_assert(detail::IsEqual(1.0f, 1.000005f) && !detail::IsEqual(1.0, 1.000005));
+
+    // the type's own tolerance plus what the degree conversion and a rounding error amplified
+    // through asin near right angles cost at its precision
+    auto expectClose = [](const auto& solved, const Triangle& expected, double relative) {
+        const std::array<std::optional<double>, 6> expectedValues{expected.sideA, expected.sideB, expected.sideC,
+                                                                  expected.angleA, expected.angleB, expected.angleC};
+        const std::array solvedValues{solved.sideA, solved.sideB, solved.sideC, solved.angleA, solved.angleB, solved.angleC};
+        for (std::size_t i = 0; i < expectedValues.size(); ++i) {
+            ASSERT_EQ(solvedValues[i].has_value(), expectedValues[i].has_value()) << i;
+            if (expectedValues[i]) {
+                EXPECT_NEAR(static_cast<double>(*solvedValues[i]), *expectedValues[i], relative * std::max(1.0, std::abs(*expectedValues[i])))
+                    << i;
+            }
+        }
+    };
+
+    const auto triangles = CollectAllTriangles(LoadFixture());
+    ASSERT_FALSE(triangles.empty());
+    for (const auto& full : triangles) {
+        const CompactTriangle compact = CompactTriangle::fromTriangle(full);
+        for (std::uint8_t known = 0; known <= KnownField::All; ++known) {
+            CompactTriangle input = compact;
+            input.known = known;
+            const Triangle masked = input.toTriangle();
+            SCOPED_TRACE(PrintTriangle(masked));
+            const Result expected = TriangleCalculator::finalizeTriangle(masked, AngleUnit::Degrees, AmbiguousCaseSolution::FirstSolution);
+
+            BasicTriangle<long double> wide;
+            BasicTriangle<float> narrow;
+            const std::array fields{&Triangle::sideA, &Triangle::sideB, &Triangle::sideC, &Triangle::angleA, &Triangle::angleB, &Triangle::angleC};
+            const std::array wideFields{&BasicTriangle<long double>::sideA, &BasicTriangle<long double>::sideB, &BasicTriangle<long double>::sideC,
+                                        &BasicTriangle<long double>::angleA, &BasicTriangle<long double>::angleB, &BasicTriangle<long double>::angleC};
+            const std::array narrowFields{&BasicTriangle<float>::sideA, &BasicTriangle<float>::sideB, &BasicTriangle<float>::sideC,
+                                          &BasicTriangle<float>::angleA, &BasicTriangle<float>::angleB, &BasicTriangle<float>::angleC};
+            for (std::size_t i = 0; i < fields.size(); ++i) {
+                if (const auto& value = masked.*fields[i]) {
+                    wide.*wideFields[i] = *value;
+                    narrow.*narrowFields[i] = static_cast<float>(*value);
+                }
+            }
+
+            ASSERT_EQ(TriangleCalculator::finalizeTriangleInPlace(wide, AngleUnit::Degrees, AmbiguousCaseSolution::FirstSolution),
+                      expected.code);
+            expectClose(wide, expected.triangle, 1e-9);
+            ASSERT_EQ(TriangleCalculator::finalizeTriangleInPlace(narrow, AngleUnit::Degrees, AmbiguousCaseSolution::FirstSolution),
+                      expected.code);
+            expectClose(narrow, expected.triangle, 1e-4);
+        }
+    }
+}
+
+TEST(TriangleCalculatorTests, MixedPrecisionStaysWithinTolerance) {
+    using namespace TriangleCalculatorLib;
+
+    // every mask of the fixtures, plus near-degenerate triangles the float pass has to hand to double:
+    // needles, flat SAS triangles and SSA with a close to h and to the other side
+    std::vector<CompactTriangle> inputs;
+    for (const auto& full : CollectAllTriangles(LoadFixture())) {
+        CompactTriangle input = CompactTriangle::fromTriangle(full);
+        for (std::uint8_t known = 0; known <= KnownField::All; ++known) {
+            input.known = known;
+            inputs.push_back(input);
+        }
+    }
+    for (double epsilon = 1e-9; epsilon < 1e-1; epsilon *= 3) {
+        inputs.push_back({1.0, 1.0, 2.0 - epsilon, 0, 0, 0, KnownField::Sides});
+        inputs.push_back({0, 5.0, 5.0 + epsilon, epsilon, 0, 0, KnownField::SideB | KnownField::SideC | KnownField::AngleA});
+        inputs.push_back({0, 3.0, 4.0, 180.0 - epsilon, 0, 0, KnownField::SideB | KnownField::SideC | KnownField::AngleA});
+        inputs.push_back({std::sin(M_PI / 6) * 2.0 * (1.0 + epsilon), 2.0, 0, 30.0, 0, 0,
+                          KnownField::SideA | KnownField::SideB | KnownField::AngleA});
+        inputs.push_back({2.0 * (1.0 - epsilon), 2.0, 0, 30.0, 0, 0, KnownField::SideA | KnownField::SideB | KnownField::AngleA});
+        inputs.push_back({1.0, 0, 0, 90.0 - epsilon, epsilon, 0, KnownField::SideA | KnownField::AngleA | KnownField::AngleB});
+    }
+    // every kernel case at scales where float, or the squares of the sides in float, overflow or lose precision
+    for (double scale : {1e-100, 1e-30, 1e-20, 1e-8, 1e20, 3e38, 1e40, 1e100}) {
+        inputs.push_back({3.0 * scale, 4.0 * scale, 5.0 * scale, 0, 0, 0, KnownField::Sides});
+        inputs.push_back({0, 3.0 * scale, 4.0 * scale, 60.0, 0, 0, KnownField::SideB | KnownField::SideC | KnownField::AngleA});
+        inputs.push_back({3.0 * scale, 0, 0, 40.0, 60.0, 0, KnownField::SideA | KnownField::AngleA | KnownField::AngleB});
+        inputs.push_back({3.0 * scale, 2.0 * scale, 0, 70.0, 0, 0, KnownField::SideA | KnownField::SideB | KnownField::AngleA});
+    }
+
+    for (const AngleUnit unit : {AngleUnit::Degrees, AngleUnit::Radians}) {
+        std::vector<CompactTriangle> exact = inputs;
+        if (unit == AngleUnit::Radians) {
+            for (CompactTriangle& triangle : exact) {
+                triangle.angleA *= M_PI / 180.0;
+                triangle.angleB *= M_PI / 180.0;
+                triangle.angleC *= M_PI / 180.0;
+            }
+        }
+        std::vector<CompactTriangle> mixed = exact;
+        std::vector<ResultCode> exactCodes(exact.size());
+        std::vector<ResultCode> mixedCodes(mixed.size());
+        ASSERT_EQ(TriangleCalculator::finalizeTriangles(exact, exactCodes, unit, AmbiguousCaseSolution::SecondSolution),
+                  ResultCode::Success);
+        ASSERT_EQ(TriangleCalculator::finalizeTriangles(mixed, mixedCodes, unit, Precision::Mixed, AmbiguousCaseSolution::SecondSolution),
+                  ResultCode::Success);
+
+        for (std::size_t i = 0; i < exact.size(); ++i) {
+            SCOPED_TRACE(PrintTriangle(inputs[i].toTriangle()));
+            ASSERT_EQ(mixedCodes[i], exactCodes[i]);
+            ASSERT_EQ(mixed[i].known, exact[i].known);
+            const std::array<double, 6> mixedValues{mixed[i].sideA, mixed[i].sideB, mixed[i].sideC,
+                                                    mixed[i].angleA, mixed[i].angleB, mixed[i].angleC};
+            const std::array<double, 6> exactValues{exact[i].sideA, exact[i].sideB, exact[i].sideC,
+                                                    exact[i].angleA, exact[i].angleB, exact[i].angleC};
+            for (std::size_t field = 0; field < exactValues.size(); ++field) {
+                if (exact[i].known & (1u << field)) {
+                    EXPECT_LE(std::abs(mixedValues[field] - exactValues[field]), MIXED_PRECISION_TOLERANCE * std::abs(exactValues[field]))
+                        << field;
+                }
+            }
+        }
+    }
+}
+
+TEST(TriangleCalculatorTests, DeferredLogFormatsOnlyEnabledLevels) {
+    CapturingLogger logger(logiface::level::warn);
+
+    int evaluations = 0;
+    auto expensive = [&evaluations] {
+        ++evaluations;
+        return 1.5;
+    };
+
+    LOGIFACE_LOGF(info, "filtered {}", expensive());
+    EXPECT_EQ(evaluations, 0);
+    EXPECT_TRUE(logger.messages.empty());
+
+    const std::optional<double> unknown;
+    LOGIFACE_LOGF(warn, "a={} b={} n={} s={} rest", expensive(), unknown, 3, std::string_view("abc"));
+    EXPECT_EQ(evaluations, 1);
+    ASSERT_EQ(logger.messages.size(), 1u);
+    EXPECT_EQ(logger.messages[0], "a=1.500000 b=? n=3 s=abc rest");
+
+    // the solver's summaries are info level, nothing is formatted for them at warn
+    TriangleCalculator::finalizeTriangle(Triangle{3.0, 4.0, 5.0, std::nullopt, std::nullopt, std::nullopt});
+    EXPECT_EQ(logger.messages.size(), 1u);
+
+    logger.set_level(logiface::level::info);
+    TriangleCalculator::finalizeTriangle(Triangle{3.0, 4.0, 5.0, std::nullopt, std::nullopt, std::nullopt});
+    ASSERT_EQ(logger.messages.size(), 3u);
+    EXPECT_EQ(logger.messages[1], "got triangle:\n\ta=3.000000\n\tb=4.000000\n\tc=5.000000\n\tA=?\n\tB=?\n\tC=?");
+    EXPECT_EQ(logger.messages[2].rfind("finalized triangle:\n\ta=3.000000", 0), 0u);
+}
+
+TEST(TriangleCalculatorTests, AsyncLoggerDeliversEveryRecordInProducerOrder) {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 1000;
+
+    CapturingLogger sink(logiface::level::trace, false);
+    logiface::async_logger logger(sink, 64, logiface::overflow_policy::block);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&logger, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                const std::string message = std::to_string(t) + ":" + std::to_string(i);
+                logger.log(MakeRecord(message));
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    logger.flush();
+
+    ASSERT_EQ(sink.messages.size(), static_cast<std::size_t>(kThreads * kPerThread));
+    EXPECT_EQ(logger.dropped(), 0u);
+    std::array<int, kThreads> next{};
+    for (const std::string& message : sink.messages) {
+        const auto colon = message.find(':');
+        const int thread = std::stoi(message.substr(0, colon));
+        EXPECT_EQ(std::stoi(message.substr(colon + 1)), next[thread]) << "records of one producer out of order";
+        next[thread] = std::stoi(message.substr(colon + 1)) + 1;
+    }
+}
+
+TEST(TriangleCalculatorTests, AsyncLoggerDropsWhenFullAndDrainsOnShutdown) {
+    CapturingLogger sink(logiface::level::trace, false);
+    std::atomic<bool> release{false};
+    sink.onLog = [&release] {
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    };
+
+    std::uint64_t dropped = 0;
+    {
+        logiface::async_logger logger(sink, 4, logiface::overflow_policy::drop);
+        logger.set_level(logiface::level::info);
+        logger.log(logiface::record{logiface::level::debug, "filtered", __FILE__, __func__, __LINE__, {}});
+        for (int i = 0; i < 100; ++i) {
+            logger.log(MakeRecord("record"));
+        }
+        dropped = logger.dropped();
+        EXPECT_GT(dropped, 0u);
+        release = true;
+    }
+
+    // the destructor drained whatever was queued
+    EXPECT_EQ(sink.messages.size() + dropped, 100u);
+    EXPECT_EQ(std::count(sink.messages.begin(), sink.messages.end(), "filtered"), 0);
+}
+
+TEST(TriangleCalculatorTests, RateLimitedLoggerSummarizesRepeatsPerCallSite) {
+    CapturingLogger sink(logiface::level::trace, false);
+    std::vector<std::string> expected;
+    {
+        logiface::rate_limited_logger logger(sink, 3, std::chrono::seconds(1));
+        const auto start = std::chrono::system_clock::now();
+        auto at = [](std::string_view message, int line, std::chrono::system_clock::time_point time) {
+            return logiface::record{logiface::level::warn, message, __FILE__, __func__, line, time};
+        };
+
+        for (int i = 0; i < 100; ++i) {
+            logger.log(at("storm", 1, start));
+        }
+        logger.log(at("other site", 2, start));
+        expected = {"storm", "storm", "storm", "other site"};
+        EXPECT_EQ(sink.messages, expected);
+
+        // the next occurrence after the period reports the suppressed ones first
+        logger.log(at("storm", 1, start + std::chrono::seconds(2)));
+        expected.insert(expected.end(), {"suppressed 97 occurrences of: storm", "storm"});
+        EXPECT_EQ(sink.messages, expected);
+
+        for (int i = 0; i < 5; ++i) {
+            logger.log(at("storm", 1, start + std::chrono::seconds(2)));
+        }
+        expected.insert(expected.end(), {"storm", "storm"});
+        EXPECT_EQ(sink.messages, expected);
+
+        // a quiet site is reported by flush_expired once its period is over, which starts the next one
+        logger.flush_expired(start + std::chrono::milliseconds(2500));
+        EXPECT_EQ(sink.messages, expected);
+        logger.flush_expired(start + std::chrono::seconds(3));
+        expected.push_back("suppressed 3 occurrences");
+        EXPECT_EQ(sink.messages, expected);
+        for (int i = 0; i < 4; ++i) {
+            logger.log(at("storm", 1, start + std::chrono::seconds(3)));
+        }
+        expected.insert(expected.end(), {"storm", "storm", "storm"});
+        EXPECT_EQ(sink.messages, expected);
+    }
+
+    // the rest is reported when the logger goes away
+    expected.push_back("suppressed 1 occurrences");
+    EXPECT_EQ(sink.messages, expected);
+}
+
+TEST(TriangleCalculatorTests, StreamParsesCsvAndNdjsonLines) {
+    using TriangleCalculatorLib::TriangleStream;
+    namespace KnownField = TriangleCalculatorLib::KnownField;
+
+    const auto csv = TriangleStream::parseCsvLine(" 30 ,?,, 1.5e1,+2, ? ");
+    ASSERT_TRUE(csv.has_value());
+    EXPECT_EQ(csv->known, KnownField::AngleA | KnownField::SideA | KnownField::SideB);
+    EXPECT_EQ(csv->angleA, 30.0);
+    EXPECT_EQ(csv->sideA, 15.0);
+    EXPECT_EQ(csv->sideB, 2.0);
+    EXPECT_FALSE(TriangleStream::parseCsvLine("1,2,3,4,5").has_value());
+    EXPECT_FALSE(TriangleStream::parseCsvLine("1,2,3,4,5,6,7").has_value());
+    EXPECT_FALSE(TriangleStream::parseCsvLine("1,2,3,4,5,6,").has_value());
+    // the code column of solved output
+    const auto solved = TriangleStream::parseCsvLine("?,?,?,3,4,5, InsufficientData");
+    ASSERT_TRUE(solved.has_value());
+    EXPECT_EQ(solved->known, KnownField::SideA | KnownField::SideB | KnownField::SideC);
+    EXPECT_FALSE(TriangleStream::parseCsvLine("1,2,3,4,5,x").has_value());
+
+    const auto ndjson = TriangleStream::parseNdjsonLine(R"({"sideA": 3, "angleB": null, "angleC": "?", "id": "t1", "sideC": -0.5e1})");
+    ASSERT_TRUE(ndjson.has_value());
+    EXPECT_EQ(ndjson->known, KnownField::SideA | KnownField::SideC);
+    EXPECT_EQ(ndjson->sideA, 3.0);
+    EXPECT_EQ(ndjson->sideC, -5.0);
+    EXPECT_TRUE(TriangleStream::parseNdjsonLine("{}").has_value());
+    EXPECT_FALSE(TriangleStream::parseNdjsonLine(R"({"sideA": {"x": 1}})").has_value());
+    EXPECT_FALSE(TriangleStream::parseNdjsonLine(R"({"sideA": 1} trailing)").has_value());
+    EXPECT_FALSE(TriangleStream::parseNdjsonLine(R"({"sideA" 1})").has_value());
+    EXPECT_FALSE(TriangleStream::parseNdjsonLine(R"({"sideA": "three"})").has_value());
+}
+
+TEST(TriangleCalculatorTests, StreamSolvesEveryLineInChunks) {
+    using namespace TriangleCalculatorLib;
+
+    const std::string input =
+        "angleA,angleB,angleC,sideA,sideB,sideC\n"
+        "?,?,?,3,4,5\n"
+        "\n"
+        "30,60,?,?,?,10\r\n"
+        "not a triangle\n"
+        ",,,1,1,\n"
+        "?,?,?,3,4,5";  // no trailing newline
+
+    for (std::size_t threads : {0u, 1u, 3u}) {
+        SCOPED_TRACE("threads " + std::to_string(threads));
+        std::optional<ThreadPool> pool;
+        StreamOptions options;
+        options.chunkSize = 2;
+        if (threads > 0) {
+            pool.emplace(threads);
+            options.pool = &*pool;
+        }
+
+        std::istringstream in(input);
+        std::ostringstream out;
+        StreamStats stats;
+        ASSERT_EQ(TriangleStream::solve(in, out, options, &stats), ResultCode::Success);
+        EXPECT_EQ(stats.triangles, 5u);
+        EXPECT_EQ(stats.malformedLines, 1u);
+        ExpectSolvedCsv(out.str(),
+                        "angleA,angleB,angleC,sideA,sideB,sideC,code\n"
+                        "36.86989764584403,53.13010235415597,90,3,4,5,Success\n"
+                        "30,60,90,4.999999999999999,8.660254037844386,10,Success\n"
+                        "?,?,?,?,?,?,InvalidData\n"
+                        "?,?,?,1,1,?,InsufficientData\n"
+                        "36.86989764584403,53.13010235415597,90,3,4,5,Success\n");
+    }
+
+    {
+        // only a line naming the columns is a header, a malformed first row keeps its place in the output
+        std::istringstream in("3,4,five\n?,?,?,3,4,5\n");
+        std::ostringstream out;
+        StreamStats stats;
+        ASSERT_EQ(TriangleStream::solve(in, out, StreamOptions{}, &stats), ResultCode::Success);
+        EXPECT_EQ(stats.triangles, 2u);
+        EXPECT_EQ(stats.malformedLines, 1u);
+        ExpectSolvedCsv(out.str(),
+                        "angleA,angleB,angleC,sideA,sideB,sideC,code\n"
+                        "?,?,?,?,?,?,InvalidData\n"
+                        "36.86989764584403,53.13010235415597,90,3,4,5,Success\n");
+
+        // solved output can be solved again, its header and code column are skipped
+        std::istringstream solvedInput(out.str());
+        std::ostringstream resolved;
+        ASSERT_EQ(TriangleStream::solve(solvedInput, resolved, StreamOptions{}, &stats), ResultCode::Success);
+        EXPECT_EQ(stats.triangles, 2u);
+        EXPECT_EQ(stats.malformedLines, 0u);
+        ExpectSolvedCsv(resolved.str(),
+                        "angleA,angleB,angleC,sideA,sideB,sideC,code\n"
+                        "?,?,?,?,?,?,InsufficientData\n"
+                        "36.86989764584403,53.13010235415597,90,3,4,5,Success\n");
+
+        std::istringstream spacedHeader(" angleA, angleB,angleC,sideA,sideB,sideC,code\n?,?,?,3,4,5\n");
+        std::ostringstream spacedOut;
+        ASSERT_EQ(TriangleStream::solve(spacedHeader, spacedOut, StreamOptions{}, &stats), ResultCode::Success);
+        EXPECT_EQ(stats.triangles, 1u);
+        EXPECT_EQ(stats.malformedLines, 0u);
+    }
+
+    std::istringstream in("{\"sideA\":3,\"sideB\":4,\"sideC\":5}\n{\"sideA\":1}\n");
+    std::ostringstream out;
+    StreamOptions options;
+    options.inputFormat = StreamFormat::Ndjson;
+    options.outputFormat = StreamFormat::Ndjson;
+    ASSERT_EQ(TriangleStream::solve(in, out, options), ResultCode::Success);
+    ExpectSolvedNdjson(out.str(),
+                       "{\"angleA\":36.86989764584403,\"angleB\":53.13010235415597,\"angleC\":90,"
+                       "\"sideA\":3,\"sideB\":4,\"sideC\":5,\"code\":\"Success\"}\n"
+                       "{\"angleA\":null,\"angleB\":null,\"angleC\":null,"
+                       "\"sideA\":1,\"sideB\":null,\"sideC\":null,\"code\":\"InsufficientData\"}\n");
+
+    std::istringstream solvedInput(out.str());
+    std::ostringstream resolved;
+    StreamStats stats;
+    ASSERT_EQ(TriangleStream::solve(solvedInput, resolved, options, &stats), ResultCode::Success);
+    EXPECT_EQ(stats.malformedLines, 0u);
+    ExpectSolvedNdjson(resolved.str(), out.str());
+}
+
+TEST(TriangleCalculatorTests, TriangleFileSolvesMappedColumnsInPlace) {
+    using namespace TriangleCalculatorLib;
+
+    const std::filesystem::path path = TempPath("TriangleFileSolvesMappedColumnsInPlace.tcb");
+    {
+        TriangleFile file;
+        ASSERT_EQ(file.create(path, 4), ResultCode::Success);
+        ASSERT_EQ(file.resize(4), ResultCode::Success);
+        const TriangleColumns columns = file.columns();
+        std::size_t row = 0;
+        std::istringstream in("?,?,?,3,4,5\n30,60,?,?,?,10\nnot a triangle\n");
+        ASSERT_EQ(TriangleStream::read(in, StreamFormat::Csv, [&](const CompactTriangle& triangle, bool) {
+            columns.set(row++, triangle);
+            return true;
+        }), ResultCode::Success);
+        ASSERT_EQ(file.resize(row), ResultCode::Success);
+        EXPECT_EQ(file.resize(5), ResultCode::InvalidData);
+        ASSERT_EQ(file.sync(), ResultCode::Success);
+    }
+
+    {
+        TriangleFile file;
+        ASSERT_EQ(file.open(path, TriangleFile::Access::ReadWrite), ResultCode::Success);
+        EXPECT_EQ(file.size(), 3u);
+        EXPECT_EQ(file.capacity(), 4u);
+        EXPECT_EQ(file.unit(), AngleUnit::Degrees);
+        ASSERT_EQ(TriangleCalculator::finalizeTriangles(file.columns(), file.unit()), ResultCode::Success);
+    }
+
+    const std::string solved =
+        "angleA,angleB,angleC,sideA,sideB,sideC,code\n"
+        "36.86989764584403,53.13010235415597,90,3,4,5,Success\n"
+        "30,60,90,4.999999999999999,8.660254037844386,10,Success\n"
+        "?,?,?,?,?,?,InsufficientData\n";
+    {
+        // a copy on write mapping can be changed without touching the file
+        TriangleFile file;
+        ASSERT_EQ(file.open(path), ResultCode::Success);
+        std::ostringstream out;
+        ASSERT_EQ(TriangleStream::write(out, StreamFormat::Csv, file.columns()), ResultCode::Success);
+        ExpectSolvedCsv(out.str(), solved);
+        file.columns().sideA[0] = 7.0;
+    }
+    {
+        TriangleFile file;
+        ASSERT_EQ(file.open(path), ResultCode::Success);
+        std::ostringstream out;
+        ASSERT_EQ(TriangleStream::write(out, StreamFormat::Csv, file.columns()), ResultCode::Success);
+        ExpectSolvedCsv(out.str(), solved);
+    }
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << std::string(256, 'x');
+    TriangleFile garbage;
+    EXPECT_EQ(garbage.open(path), ResultCode::InvalidData);
+    EXPECT_FALSE(garbage.isOpen());
+    std::filesystem::remove(path);
+}
+
+TEST(TriangleCalculatorTests, TriangleGeneratorRowsFollowTheirMix) {
+    using namespace TriangleCalculatorLib;
+
+    GeneratorOptions options;
+    options.seed = 7;
+    options.mix.ambiguousFraction = 0.2;
+    options.mix.invalidFraction = 0.1;
+    ASSERT_TRUE(TriangleGenerator::parseCases("SSS=1,SAS=1,SSA=2,ASA=1,AAS=1", options.mix));
+    EXPECT_FALSE(TriangleGenerator::parseCases("SSS=1,XYZ=1", options.mix));
+    EXPECT_FALSE(TriangleGenerator::parseCases("SSS=-1", options.mix));
+    EXPECT_FALSE(TriangleGenerator::parseShapes("right=0", options.mix));
+    EXPECT_EQ(options.mix.weight(GeneratorCase::SSA), 2.0);
+
+    const auto values = [](const CompactTriangle& t) {
+        return std::array<double, 6>{t.sideA, t.sideB, t.sideC, t.angleA, t.angleB, t.angleC};
+    };
+
+    constexpr std::size_t rows = 20000;
+    std::array<std::size_t, 3> kinds{};
+    std::array<std::size_t, GeneratorMix::CaseCount> cases{};
+    for (std::size_t row = 0; row < rows; ++row) {
+        SCOPED_TRACE("row " + std::to_string(row));
+        const GeneratedTriangle generated = TriangleGenerator::generate(options, row);
+        ++kinds[static_cast<std::size_t>(generated.kind)];
+        const CompactTriangle& input = generated.input;
+        ASSERT_EQ(std::popcount(input.known), 3);
+        ASSERT_EQ(generated.complete.known, KnownField::All);
+
+        const GeneratedTriangle again = TriangleGenerator::generate(options, row);
+        ASSERT_EQ(values(again.input), values(input));
+        ASSERT_EQ(again.input.known, input.known);
+
+        const std::array<double, 6> given = values(input);
+        if (generated.kind == GeneratedKind::Invalid) {
+            // the given values break the triangle the way of their case
+            const double sides = given[0] + given[1] + given[2];
+            const double angles = given[3] + given[4] + given[5];
+            const double longest = std::max({given[0], given[1], given[2]});
+            if (generated.generatorCase == GeneratorCase::SSS) {
+                EXPECT_GT(longest, sides - longest);
+            } else if (generated.generatorCase == GeneratorCase::SSA) {
+                CompactTriangle solved = input;
+                TriangleCalculator::finalizeTriangle(solved, AmbiguousCaseSolution::FirstSolution);
+                EXPECT_NE(solved.known, KnownField::All);
+            } else {
+                EXPECT_GE(angles, 180.0);
+            }
+            continue;
+        }
+        ++cases[static_cast<std::size_t>(generated.generatorCase)];
+
+        // valid rows solve to the triangle they were cut from, ambiguous ones have a second solution besides it
+        CompactTriangle solved = input;
+        ASSERT_EQ(TriangleCalculator::finalizeTriangle(solved, AmbiguousCaseSolution::FirstSolution), ResultCode::Success);
+        ASSERT_EQ(solved.known, KnownField::All);
+        const std::array<double, 6> expected = values(generated.complete);
+        const std::array<double, 6> actual = values(solved);
+        for (std::size_t i = 0; i < 6; ++i) {
+            EXPECT_NEAR(actual[i], expected[i], 1e-9 * std::max(1.0, expected[i]));
+        }
+        CompactTriangle second = input;
+        TriangleCalculator::finalizeTriangle(second, AmbiguousCaseSolution::SecondSolution);
+        const bool differs = values(second) != actual;
+        EXPECT_EQ(differs, generated.kind == GeneratedKind::Ambiguous);
+    }
+
+    EXPECT_NEAR(static_cast<double>(kinds[static_cast<std::size_t>(GeneratedKind::Invalid)]) / rows, 0.1, 0.01);
+    EXPECT_NEAR(static_cast<double>(kinds[static_cast<std::size_t>(GeneratedKind::Ambiguous)]) / rows, 0.2, 0.01);
+    // valid rows take their case from the weights, ambiguous ones are all SSA
+    const double valid = static_cast<double>(kinds[static_cast<std::size_t>(GeneratedKind::Valid)]);
+    const double ambiguous = static_cast<double>(kinds[static_cast<std::size_t>(GeneratedKind::Ambiguous)]);
+    EXPECT_NEAR(cases[static_cast<std::size_t>(GeneratorCase::SSS)] / valid, 1.0 / 6.0, 0.02);
+    EXPECT_NEAR((cases[static_cast<std::size_t>(GeneratorCase::SSA)] - ambiguous) / valid, 2.0 / 6.0, 0.02);
+}
+
+TEST(TriangleCalculatorTests, TriangleGeneratorOutputDoesNotDependOnThreadsOrFormat) {
+    using namespace TriangleCalculatorLib;
+
+    GeneratorOptions options;
+    options.mix.invalidFraction = 0.1;
+    options.mix.ambiguousFraction = 0.1;
+    options.shardSize = 100;
+    constexpr std::size_t count = 1234;
+    std::vector<CompactTriangle> expected;
+    for (std::size_t row = 0; row < count; ++row) {
+        expected.push_back(TriangleGenerator::generate(options, row).input);
+    }
+    const auto expectRows = [&](const std::vector<CompactTriangle>& actual, std::size_t first) {
+        ASSERT_EQ(actual.size() + first, count);
+        for (std::size_t i = 0; i < actual.size(); ++i) {
+            const CompactTriangle& e = expected[first + i];
+            const CompactTriangle& a = actual[i];
+            ASSERT_EQ(a.known, e.known) << "row " << first + i;
+            EXPECT_EQ(a.sideA, e.sideA);
+            EXPECT_EQ(a.sideB, e.sideB);
+            EXPECT_EQ(a.sideC, e.sideC);
+            EXPECT_EQ(a.angleA, e.angleA);
+            EXPECT_EQ(a.angleB, e.angleB);
+            EXPECT_EQ(a.angleC, e.angleC);
+        }
+    };
+
+    ThreadPool pool(3);
+    for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+        options.pool = threads;
+        options.firstRow = 0;
+
+        // text reads back exactly, the numbers are written in their shortest round trip form
+        for (const StreamFormat format : {StreamFormat::Csv, StreamFormat::Ndjson}) {
+            std::ostringstream out;
+            ASSERT_EQ(TriangleGenerator::write(out, format, count, options), ResultCode::Success);
+            std::istringstream in(out.str());
+            std::vector<CompactTriangle> read;
+            StreamStats stats;
+            ASSERT_EQ(TriangleStream::read(in, format, [&](const CompactTriangle& triangle, bool) {
+                read.push_back(triangle);
+                return true;
+            }, &stats), ResultCode::Success);
+            EXPECT_EQ(stats.malformedLines, 0u);
+            expectRows(read, 0);
+        }
+
+        // a later range of the same run
+        options.firstRow = 1000;
+        TriangleBatch batch(count - 1000);
+        TriangleGenerator::generate(options, batch.columns());
+        std::vector<CompactTriangle> rows;
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            rows.push_back(batch.getCompact(i));
+        }
+        expectRows(rows, 1000);
+    }
+
+    options.firstRow = 0;
+    const std::filesystem::path path = TempPath("TriangleGeneratorOutput.tcb");
+    ASSERT_EQ(TriangleGenerator::writeFile(path, count, options), ResultCode::Success);
+    {
+        TriangleFile file;
+        ASSERT_EQ(file.open(path), ResultCode::Success);
+        const TriangleColumns columns = file.columns();
+        std::vector<CompactTriangle> rows;
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            rows.push_back(columns.getCompact(i));
+        }
+        expectRows(rows, 0);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(TriangleCalculatorTests, TriangleJsonReaderMatchesTheFixture) {
+    using namespace TriangleCalculatorLib;
+
+    std::ifstream file(FixturePath());
+    ASSERT_TRUE(file.is_open());
+    const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const auto expected = CollectAllTriangles(LoadFixture());
+    const auto expectRow = [&](const TriangleColumns& rows, std::size_t i, std::size_t index) {
+        const Triangle& e = expected[index % expected.size()];
+        ASSERT_EQ(rows.known[i], KnownField::All) << "triangle " << index;
+        EXPECT_EQ(rows.codes[i], ResultCode::Success);
+        EXPECT_EQ(rows.sideA[i], *e.sideA);
+        EXPECT_EQ(rows.sideB[i], *e.sideB);
+        EXPECT_EQ(rows.sideC[i], *e.sideC);
+        EXPECT_EQ(rows.angleA[i], *e.angleA);
+        EXPECT_EQ(rows.angleB[i], *e.angleB);
+        EXPECT_EQ(rows.angleC[i], *e.angleC);
+    };
+
+    // in memory, in one read: the numbers parse the same as through the DOM
+    {
+        TriangleJsonReader reader(std::string_view{text});
+        TriangleBatch batch(expected.size() + 10);
+        ASSERT_EQ(reader.read(batch.columns()), expected.size());
+        EXPECT_EQ(reader.status(), ResultCode::Success);
+        EXPECT_EQ(reader.stats().triangles, expected.size());
+        EXPECT_EQ(reader.stats().bytes, text.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            expectRow(batch.columns(), i, i);
+        }
+    }
+
+    // streamed in small reads from input long enough that tokens are cut at block ends
+    std::string repeated;
+    constexpr std::size_t copies = 60;
+    for (std::size_t copy = 0; copy < copies; ++copy) {
+        repeated += text;
+    }
+    std::istringstream input(repeated);
+    TriangleJsonReader reader(input);
+    TriangleBatch batch(7);
+    std::size_t total = 0;
+    while (const std::size_t filled = reader.read(batch.columns())) {
+        for (std::size_t i = 0; i < filled; ++i) {
+            expectRow(batch.columns(), i, total + i);
+        }
+        total += filled;
+    }
+    EXPECT_EQ(reader.status(), ResultCode::Success);
+    EXPECT_EQ(total, copies * expected.size());
+    EXPECT_EQ(reader.stats().bytes, repeated.size());
+}
+
+TEST(TriangleCalculatorTests, TriangleJsonReaderHandlesUnknownsAndBadInput) {
+    using namespace TriangleCalculatorLib;
+
+    // NDJSON, nulls for unknown values, other keys and values skipped
+    const std::string ndjson =
+        R"({"id": "a", "sides": [3, 4, 5], "angles": [null, null, null]})" "\n"
+        R"({"angles": [30, 60.5e0, null], "tags": ["x", {"sides": null}], "sides": [null, -1.25, null]})" "\n"
+        R"({"sides": null})" "\n"
+        R"({"sides": [1, 2], "angles": [1, 2, 3]})" "\n"
+        R"({"sides": [1, 2, "3"]})" "\n"
+        R"({"angles": 5})" "\n"
+        R"({"sides": [1, 2, 3, 4]} 17 "not a triangle" [true, false])" "\n";
+    TriangleJsonReader reader{std::string_view{ndjson}};
+    TriangleBatch batch(16);
+    const TriangleColumns rows = batch.columns();
+    ASSERT_EQ(reader.read(rows), 8u);
+    EXPECT_EQ(reader.status(), ResultCode::Success);
+    EXPECT_EQ(reader.stats().malformed, 4u);
+
+    EXPECT_EQ(rows.known[0], KnownField::Sides);
+    EXPECT_EQ(rows.sideC[0], 5.0);
+    // the object nested under "tags" is a triangle of its own, it ends first
+    EXPECT_EQ(rows.known[1], 0u);
+    EXPECT_EQ(rows.codes[1], ResultCode::Success);
+    EXPECT_EQ(rows.known[2], KnownField::AngleA | KnownField::AngleB | KnownField::SideB);
+    EXPECT_EQ(rows.angleB[2], 60.5);
+    EXPECT_EQ(rows.sideB[2], -1.25);
+    EXPECT_EQ(rows.known[3], 0u);
+    for (std::size_t i = 4; i < 8; ++i) {
+        EXPECT_EQ(rows.known[i], 0u) << i;
+        EXPECT_EQ(rows.codes[i], ResultCode::InvalidData) << i;
+    }
+
+    // syntax errors stop the reader after the triangles before them
+    for (const std::string_view bad : {R"({"sides": [1, 2, 3]} {"sides": [1 2 3]})", R"({"sides": [1, 2, 3]} {"sides": [1, 2, 3])",
+                                       R"({"sides": [1, 2, 3]} {"sides" [1, 2, 3]})", R"({"sides": [1, 2, 3]} {"sides": [1, 2, 3]]})",
+                                       R"({"sides": [1, 2, 3]} , {"sides": [1, 2, 3]})", R"({"sides": [1, 2, 3]} {"sides": "1, 2, 3)",
+                                       R"({"sides": [1, 2, 3]} {"sides": [1, 2, 3], "angles": nul})"}) {
+        TriangleJsonReader broken{bad};
+        EXPECT_EQ(broken.read(rows), 1u) << bad;
+        EXPECT_EQ(broken.status(), ResultCode::InvalidData) << bad;
+        EXPECT_EQ(broken.read(rows), 0u) << bad;
+    }
+}
+
+// the server only exists on Linux, elsewhere listen() fails
+#if defined(__linux__)
+TEST(TriangleCalculatorTests, TriangleServerAnswersPipelinedRequestsInOrder) {
+    using namespace TriangleCalculatorLib;
+
+    ThreadPool pool(2);
+    ServerOptions options;
+    options.socketPath = TempPath("TriangleServerTest.sock");
+    options.pool = &pool;
+    options.poolThreshold = 100;
+    TriangleServer server(options);
+    ASSERT_EQ(server.listen(), ResultCode::Success);
+    std::thread loop([&server] { EXPECT_EQ(server.run(), ResultCode::Success); });
+    {
+        // the socket of a running server is not taken over
+        TriangleServer second(options);
+        EXPECT_EQ(second.listen(), ResultCode::InvalidData);
+    }
+
+    const auto connect = [&options] {
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, options.socketPath.c_str(), sizeof(address.sun_path) - 1);
+        EXPECT_EQ(::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)), 0);
+        return fd;
+    };
+    // send everything, then read the replies until the server closes the connection
+    const auto exchange = [](int fd, const std::string& requests) {
+        EXPECT_EQ(::send(fd, requests.data(), requests.size(), 0), static_cast<ssize_t>(requests.size()));
+        ::shutdown(fd, SHUT_WR);
+        std::string replies;
+        std::array<char, 4096> block;
+        ssize_t count = 0;
+        while ((count = ::read(fd, block.data(), block.size())) > 0) {
+            replies.append(block.data(), static_cast<std::size_t>(count));
+        }
+        ::close(fd);
+        return replies;
+    };
+
+    GeneratorOptions generator;
+    generator.mix.ambiguousFraction = 0.1;
+    generator.mix.invalidFraction = 0.1;
+    const auto batch = [&generator](std::size_t count, std::uint64_t first) {
+        std::vector<CompactTriangle> triangles;
+        for (std::size_t i = 0; i < count; ++i) {
+            triangles.push_back(TriangleGenerator::generate(generator, first + i).input);
+        }
+        return triangles;
+    };
+    const std::vector<CompactTriangle> small = batch(50, 0);
+    const std::vector<CompactTriangle> large = batch(1050, 50);
+
+    // a client pipelining text lines around a batch solved inline and one split over the pool
+    const int idle = connect();
+    const int client = connect();
+    std::string requests = "?,?,?,3,4,5\n\n";
+    ServerProtocol::appendRequest(requests, large);
+    requests += R"({"angleA": 30, "angleB": 60, "sideC": 2})" "\r\n";
+    ServerProtocol::appendRequest(requests, small);
+    requests += "not a triangle\n30,60,?,?,?,2";
+    const std::string replies = exchange(client, requests);
+
+    const auto expectLine = [&](StreamFormat format, std::optional<CompactTriangle> input, std::size_t& pos) {
+        std::string expected;
+        ResultCode code = ResultCode::InvalidData;
+        CompactTriangle triangle = input.value_or(CompactTriangle{});
+        if (input) {
+            code = TriangleCalculator::finalizeTriangle(triangle);
+        }
+        TriangleStream::appendResult(expected, format, triangle, code);
+        EXPECT_EQ(replies.substr(pos, expected.size()), expected);
+        pos += expected.size();
+    };
+    const auto expectFrame = [&](std::vector<CompactTriangle> input, std::size_t& pos) {
+        std::vector<ResultCode> codes(input.size());
+        ASSERT_EQ(TriangleCalculator::finalizeTriangles(std::span(input), std::span(codes)), ResultCode::Success);
+        std::vector<CompactTriangle> solved;
+        std::vector<ResultCode> solvedCodes;
+        const std::size_t size = ServerProtocol::parseReply(std::string_view(replies).substr(pos), solved, solvedCodes);
+        ASSERT_EQ(size, ServerProtocol::HeaderSize + input.size() * ServerProtocol::ReplyRecordSize);
+        EXPECT_EQ(solvedCodes, codes);
+        for (std::size_t i = 0; i < input.size(); ++i) {
+            ASSERT_EQ(solved[i].known, input[i].known) << i;
+            EXPECT_EQ(solved[i].sideA, input[i].sideA);
+            EXPECT_EQ(solved[i].sideC, input[i].sideC);
+            EXPECT_EQ(solved[i].angleB, input[i].angleB);
+        }
+        pos += size;
+    };
+
+    std::size_t pos = 0;
+    expectLine(StreamFormat::Csv, TriangleStream::parseCsvLine("?,?,?,3,4,5"), pos);
+    expectFrame(large, pos);
+    expectLine(StreamFormat::Ndjson, TriangleStream::parseNdjsonLine(R"({"angleA": 30, "angleB": 60, "sideC": 2})"), pos);
+    expectFrame(small, pos);
+    expectLine(StreamFormat::Csv, std::nullopt, pos);
+    expectLine(StreamFormat::Csv, TriangleStream::parseCsvLine("30,60,?,?,?,2"), pos);
+    EXPECT_EQ(pos, replies.size());
+
+    // a batch larger than the protocol allows drops only that client
+    std::string oversized(ServerProtocol::HeaderSize, '\0');
+    oversized[0] = static_cast<char>(ServerProtocol::FrameMarker);
+    const std::uint32_t tooMany = ServerProtocol::MaxFrameTriangles + 1;
+    std::memcpy(oversized.data() + 4, &tooMany, sizeof(tooMany));
+    EXPECT_EQ(exchange(connect(), oversized), "");
+    EXPECT_EQ(exchange(idle, "3,4,5,?,?,?\n").substr(0, 12), "3,4,5,?,?,?,");
+
+    server.stop();
+    loop.join();
+    EXPECT_FALSE(std::filesystem::exists(options.socketPath));
+}
+#endif
+
+// A coroutine that starts right away and runs to its end, for driving awaitables in tests
+struct EagerCoroutine {
+    struct promise_type {
+        EagerCoroutine get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+TEST(TriangleCalculatorTests, TriangleAsyncSolvesChunksInRowOrder) {
+    using namespace TriangleCalculatorLib;
+
+    GeneratorOptions generator;
+    generator.mix.ambiguousFraction = 0.1;
+    generator.mix.invalidFraction = 0.1;
+    constexpr std::size_t count = 10000;
+    TriangleBatch batch(count);
+    TriangleBatch expected(count);
+    TriangleGenerator::generate(generator, batch.columns());
+    TriangleGenerator::generate(generator, expected.columns());
+    ASSERT_EQ(TriangleCalculator::finalizeTriangles(expected.columns()), ResultCode::Success);
+
+    ThreadPool pool(3);
+    AsyncSolveOptions options;
+    options.pool = &pool;
+    options.chunkSize = 1000;
+    std::vector<std::pair<std::size_t, std::size_t>> chunks;
+    std::promise<AsyncSolveResult> finished;
+    // a named closure: the coroutine reaches its captures through it after the first suspension
+    const auto consume = [&]() -> EagerCoroutine {
+        SolveOperation solving = TriangleAsync::solve(batch.columns(), options);
+        while (const std::optional<SolvedChunk> chunk = co_await solving.nextChunk()) {
+            // the rows of a delivered chunk are final while later chunks may still be solving
+            EXPECT_EQ(chunk->rows.size(), chunk->end - chunk->begin);
+            for (std::size_t i = chunk->begin; i < chunk->end; ++i) {
+                EXPECT_EQ(batch.columns().codes[i], expected.columns().codes[i]) << i;
+                EXPECT_EQ(batch.columns().known[i], expected.columns().known[i]) << i;
+                EXPECT_EQ(batch.columns().sideA[i], expected.columns().sideA[i]) << i;
+                EXPECT_EQ(batch.columns().angleC[i], expected.columns().angleC[i]) << i;
+            }
+            chunks.emplace_back(chunk->begin, chunk->end);
+        }
+        finished.set_value(co_await solving);
+    };
+    consume();
+    const AsyncSolveResult result = finished.get_future().get();
+    EXPECT_EQ(result.code, ResultCode::Success);
+    EXPECT_EQ(result.solvedRows, count);
+    EXPECT_FALSE(result.cancelled);
+    ASSERT_EQ(chunks.size(), count / options.chunkSize);
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        EXPECT_EQ(chunks[i].first, i * options.chunkSize);
+        EXPECT_EQ(chunks[i].second, (i + 1) * options.chunkSize);
+    }
+
+    // mismatched columns finish right away, nothing is solved
+    TriangleColumns mismatched = batch.columns();
+    mismatched.sideA = mismatched.sideA.first(10);
+    const auto solveMismatched = [&]() -> EagerCoroutine {
+        const AsyncSolveResult invalid = co_await TriangleAsync::solve(mismatched, options);
+        EXPECT_EQ(invalid.code, ResultCode::InvalidData);
+        EXPECT_EQ(invalid.solvedRows, 0u);
+    };
+    solveMismatched();
+}
+
+TEST(TriangleCalculatorTests, TriangleAsyncCancelsQueuedChunks) {
+    using namespace TriangleCalculatorLib;
+
+    constexpr std::size_t count = 4000;
+    TriangleBatch batch(count);
+    TriangleGenerator::generate(GeneratorOptions{}, batch.columns());
+
+    // the only worker is held until the batch is cancelled, so no chunk has started
+    ThreadPool pool(1);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    pool.submit([released] { released.wait(); });
+
+    std::stop_source stop;
+    AsyncSolveOptions options;
+    options.pool = &pool;
+    options.chunkSize = 1000;
+    options.stopToken = stop.get_token();
+    std::promise<AsyncSolveResult> finished;
+    std::optional<SolvedChunk> first{SolvedChunk{}};
+    const auto consume = [&]() -> EagerCoroutine {
+        SolveOperation solving = TriangleAsync::solve(batch.columns(), options);
+        first = co_await solving.nextChunk();
+        finished.set_value(co_await solving);
+    };
+    consume();
+    stop.request_stop();
+    release.set_value();
+    const AsyncSolveResult result = finished.get_future().get();
+    EXPECT_FALSE(first.has_value());
+    EXPECT_TRUE(result.cancelled);
+    EXPECT_EQ(result.solvedRows, 0u);
+    const TriangleColumns rows = batch.columns();
+    EXPECT_TRUE(std::all_of(rows.known.begin(), rows.known.end(), [](std::uint8_t known) { return std::popcount(known) == 3; }));
+
+    // an operation dropped while solving gives up its queued chunks and returns once the running ones are done
+    std::promise<void> hold;
+    std::shared_future<void> held = hold.get_future().share();
+    pool.submit([held] { held.wait(); });
+    {
+        AsyncSolveOptions dropped = options;
+        dropped.stopToken = {};
+        SolveOperation solving = TriangleAsync::solve(batch.columns(), dropped);
+    }
+    hold.set_value();
+    // the single worker takes its queue in order, once this task runs every dropped chunk has been skipped
+    std::promise<void> drained;
+    pool.submit([&drained] { drained.set_value(); });
+    drained.get_future().wait();
+    EXPECT_TRUE(std::all_of(rows.known.begin(), rows.known.end(), [](std::uint8_t known) { return std::popcount(known) == 3; }));
+}
+
+TEST(TriangleCalculatorTests, TriangleCacheEvictsWithClock) {
+    using namespace TriangleCalculatorLib;
+
+    TriangleCache cache(4, 1);
+    ASSERT_EQ(cache.capacity(), 4u);
+    auto side = [](double a) { return CompactTriangle{a, 1.0, 1.0, 0, 0, 0, KnownField::Sides}; };
+    for (double a : {1.0, 1.1, 1.2, 1.3}) {
+        cache.insert(side(a), AngleUnit::Degrees, AmbiguousCaseSolution::NoSolution, side(a), ResultCode::Success);
+    }
+
+    CompactTriangle solved;
+    ResultCode code;
+    EXPECT_TRUE(cache.find(side(1.0), AngleUnit::Degrees, AmbiguousCaseSolution::NoSolution, solved, code));
+    EXPECT_FALSE(cache.find(side(1.0), AngleUnit::Radians, AmbiguousCaseSolution::NoSolution, solved, code));
+    EXPECT_FALSE(cache.find(side(1.0), AngleUnit::Degrees, AmbiguousCaseSolution::FirstSolution, solved, code));
+
+    // values of unknown fields are not part of the key
+    CompactTriangle noise = side(1.0);
+    noise.angleA = 42.0;
+    EXPECT_TRUE(cache.find(noise, AngleUnit::Degrees, AmbiguousCaseSolution::NoSolution, solved, code));
+
+    // 1.0 was used since it was inserted, so the hand passes it and evicts 1.1
+    cache.insert(side(1.4), AngleUnit::Degrees, AmbiguousCaseSolution::NoSolution, side(1.4), ResultCode::Success);
+    EXPECT_TRUE(cache.find(side(1.0), AngleUnit::Degrees, AmbiguousCaseSolution::NoSolution, solved, code));
+    EXPECT_FALSE(cache.find(side(1.1), AngleUnit::Degrees, AmbiguousCaseSolution::NoSolution, solved, code));
+    for (double a : {1.2, 1.3, 1.4}) {
+        EXPECT_TRUE(cache.find(side(a), AngleUnit::Degrees, AmbiguousCaseSolution::NoSolution, solved, code)) << a;
+        EXPECT_EQ(solved.sideA, a);
+    }
+
+    const TriangleCache::Stats stats = cache.stats();
+    EXPECT_EQ(stats.hits, 6u);
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.size, 4u);
+
+    cache.clear();
+    EXPECT_EQ(cache.stats().size, 0u);
+    EXPECT_FALSE(cache.find(side(1.0), AngleUnit::Degrees, AmbiguousCaseSolution::NoSolution, solved, code));
+}
+
+TEST(TriangleCalculatorTests, CachedFinalizeTriangleMatchesUncachedAcrossThreads) {
+    using namespace TriangleCalculatorLib;
+
+    // a small set of shapes asked for over and over, in a cache too small to hold all of them
+    std::vector<Triangle> inputs;
+    const auto triangles = CollectAllTriangles(LoadFixture());
+    for (std::size_t i = 0; i < std::min<std::size_t>(triangles.size(), 48); ++i) {
+        Triangle input = triangles[i];
+        input.angleA.reset();
+        input.angleB.reset();
+        inputs.push_back(input);
+    }
+    std::vector<Result> expected;
+    for (const auto& input : inputs) {
+        expected.push_back(TriangleCalculator::finalizeTriangle(input));
+    }
+
+    TriangleCache cache(32, 4);
+    constexpr std::size_t Rounds = 50;
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> mismatches{0};
+    for (std::size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (std::size_t round = 0; round < Rounds; ++round) {
+                for (std::size_t i = 0; i < inputs.size(); ++i) {
+                    const std::size_t index = (i + t * 7) % inputs.size();
+                    const Result result = TriangleCalculator::finalizeTriangle(inputs[index], AngleUnit::Degrees, cache);
+                    const Result& want = expected[index];
+                    if (result.code != want.code || result.triangle.sideA != want.triangle.sideA ||
+                        result.triangle.sideB != want.triangle.sideB || result.triangle.sideC != want.triangle.sideC ||
+                        result.triangle.angleA != want.triangle.angleA || result.triangle.angleB != want.triangle.angleB ||
+                        result.triangle.angleC != want.triangle.angleC) {
+                        ++mismatches;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(mismatches.load(), 0u);
+    const TriangleCache::Stats stats = cache.stats();
+    EXPECT_EQ(stats.hits + stats.misses, 4 * Rounds * inputs.size());
+    EXPECT_GT(stats.hits, 0u);
+    EXPECT_GT(stats.evictions, 0u);
+    EXPECT_LE(stats.size, cache.capacity());
+}
+
+TEST(TriangleCalculatorTests, SolverStatsCountCasesCodesAndLatencies) {
+    using namespace TriangleCalculatorLib;
+
+    // one triangle per solver case, all of the 3-4-5 right triangle
+    const std::optional<double> none;
+    const std::vector<std::pair<SolveCase, Triangle>> cases{
+        {SolveCase::Insufficient, Triangle{3.0, none, none, none, none, none}},
+        {SolveCase::Complete, Triangle{3.0, 4.0, 5.0, 36.8699, 53.1301, 90.0}},
+        {SolveCase::ThirdAngle, Triangle{3.0, 4.0, 5.0, 36.8699, 53.1301, none}},
+        {SolveCase::SSS, Triangle{3.0, 4.0, 5.0, none, none, none}},
+        {SolveCase::SAS, Triangle{none, 4.0, 5.0, 36.8699, none, none}},
+        {SolveCase::SSA, Triangle{5.0, 4.0, none, 90.0, none, none}},
+        {SolveCase::AAS, Triangle{3.0, none, none, 36.8699, 53.1301, none}},
+    };
+
+    SolverStats::setEnabled(true);
+    SolverStats::reset();
+
+    for (const auto& [solveCase, triangle] : cases) {
+        TriangleCalculator::finalizeTriangle(triangle);
+    }
+    SolverStats::Snapshot snapshot = SolverStats::snapshot();
+    EXPECT_EQ(snapshot.solves(), cases.size());
+    for (const auto& [solveCase, triangle] : cases) {
+        EXPECT_EQ(snapshot.count(solveCase), 1u) << to_string(solveCase);
+        EXPECT_LE(snapshot.latency[static_cast<std::size_t>(solveCase)].count, 1u) << to_string(solveCase);
+    }
+    EXPECT_EQ(snapshot.count(ResultCode::InsufficientData), 1u);
+    EXPECT_EQ(snapshot.count(ResultCode::Success), cases.size() - 1);
+
+    // the batch counts the same cases, the rows it hands to the backend (ThirdAngle) are counted there once
+    std::vector<CompactTriangle> batch;
+    for (const auto& [solveCase, triangle] : cases) {
+        batch.push_back(CompactTriangle::fromTriangle(triangle));
+    }
+    std::vector<ResultCode> codes(batch.size());
+    ASSERT_EQ(TriangleCalculator::finalizeTriangles(batch, codes), ResultCode::Success);
+    snapshot = SolverStats::snapshot();
+    for (const auto& [solveCase, triangle] : cases) {
+        EXPECT_EQ(snapshot.count(solveCase), 2u) << to_string(solveCase);
+    }
+    EXPECT_EQ(snapshot.count(ResultCode::InsufficientData), 2u);
+    EXPECT_EQ(snapshot.count(ResultCode::Success), 2 * (cases.size() - 1));
+
+    // threads count on their own and keep their counts when they exit; a fresh thread times its first solve
+    std::thread worker([&cases] {
+        for (int i = 0; i < 5; ++i) {
+            TriangleCalculator::finalizeTriangle(cases[3].second);
+        }
+    });
+    worker.join();
+    snapshot = SolverStats::snapshot();
+    EXPECT_EQ(snapshot.count(SolveCase::SSS), 7u);
+    const SolverStats::Histogram& sss = snapshot.latency[static_cast<std::size_t>(SolveCase::SSS)];
+    std::uint64_t bucketed = 0;
+    for (const std::uint64_t count : sss.buckets) {
+        bucketed += count;
+    }
+    EXPECT_EQ(bucketed, sss.count);
+    // the batch row plus at least the first solve of the worker
+    EXPECT_GE(sss.count, 2u);
+    EXPECT_LE(sss.count, 7u);
+    EXPECT_GT(sss.totalNanoseconds, 0u);
+
+    const json exported = json::parse(SolverStats::toJson(snapshot));
+    EXPECT_EQ(exported.at("solves").get<std::uint64_t>(), snapshot.solves());
+    EXPECT_EQ(exported.at("cases").at("SSS").at("count").get<std::uint64_t>(), 7u);
+    EXPECT_EQ(exported.at("cases").at("SSS").at("latency").at("count").get<std::uint64_t>(), sss.count);
+    EXPECT_EQ(exported.at("codes").at("InsufficientData").get<std::uint64_t>(), 2u);
+
+    const std::string prometheus = SolverStats::toPrometheus(snapshot);
+    EXPECT_NE(prometheus.find("triangle_solves_total{case=\"SSS\"} 7\n"), std::string::npos);
+    EXPECT_NE(prometheus.find("triangle_results_total{code=\"InsufficientData\"} 2\n"), std::string::npos);
+    const std::string sampled = std::to_string(sss.count) + "\n";
+    EXPECT_NE(prometheus.find("triangle_solve_duration_seconds_bucket{case=\"SSS\",le=\"+Inf\"} " + sampled), std::string::npos);
+    EXPECT_NE(prometheus.find("triangle_solve_duration_seconds_count{case=\"SSS\"} " + sampled), std::string::npos);
+
+    // nothing is counted while off, and reset starts over
+    SolverStats::setEnabled(false);
+    TriangleCalculator::finalizeTriangle(cases[3].second);
+    EXPECT_EQ(SolverStats::snapshot().count(SolveCase::SSS), 7u);
+    SolverStats::reset();
+    EXPECT_EQ(SolverStats::snapshot().solves(), 0u);
+}
+
+TEST(TriangleCalculatorTests, ThreadPoolParallelForVisitsEveryIndexOnce) {
+    TriangleCalculatorLib::ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(10007);
+    pool.parallelFor(visits.size(), 64, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            visits[i].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    for (std::size_t i = 0; i < visits.size(); ++i) {
+        ASSERT_EQ(visits[i].load(), 1) << "index " << i;
+    }
+}
+
+TEST(TriangleCalculatorTests, ParallelFinalizeTrianglesMatchesSerial) {
+    using TriangleCalculatorLib::AmbiguousCaseSolution;
+    using TriangleCalculatorLib::ResultCode;
+
+    const json fixture = LoadFixture();
+    std::mt19937 rng(fixture.at("seed").get<uint32_t>());
+    const auto expectedTriangles = CollectAllTriangles(fixture);
+    ASSERT_FALSE(expectedTriangles.empty());
+
+    // a mixed batch several times the fixture size so every worker gets many chunks
+    constexpr std::size_t repeats = 8;
+    TriangleBatch serial(expectedTriangles.size() * repeats);
+    const Difficulty difficulties[] = {Difficulty::Basic, Difficulty::Advanced, Difficulty::HardEdge};
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        const auto& expected = expectedTriangles[i % expectedTriangles.size()];
+        serial.set(i, GeneratePartialTriangle(expected, difficulties[i % 3], rng).partial);
+    }
+    TriangleBatch parallel = serial;
+
+    ASSERT_EQ(TriangleCalculator::finalizeTriangles(serial.columns(), AmbiguousCaseSolution::FirstSolution), ResultCode::Success);
+
+    for (std::size_t threads : {1u, 4u}) {
+        TriangleBatch batch = parallel;
+        TriangleCalculatorLib::ThreadPool pool(threads);
+        ASSERT_EQ(TriangleCalculator::finalizeTriangles(batch.columns(), pool, AmbiguousCaseSolution::FirstSolution, 37),
+                  ResultCode::Success);
+
+        const auto expectedColumns = serial.columns();
+        const auto actualColumns = batch.columns();
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            ASSERT_EQ(actualColumns.known[i], expectedColumns.known[i]) << "row " << i;
+            ASSERT_EQ(actualColumns.codes[i], expectedColumns.codes[i]) << "row " << i;
+            const Triangle a = batch.get(i);
+            const Triangle e = serial.get(i);
+            EXPECT_EQ(a.sideA, e.sideA) << "row " << i;
+            EXPECT_EQ(a.sideB, e.sideB) << "row " << i;
+            EXPECT_EQ(a.sideC, e.sideC) << "row " << i;
+            EXPECT_EQ(a.angleA, e.angleA) << "row " << i;
+            EXPECT_EQ(a.angleB, e.angleB) << "row " << i;
+            EXPECT_EQ(a.angleC, e.angleC) << "row " << i;
+        }
+    }
+
+    // compact triangles in a precision tier, split or not the rows come out bitwise the same
+    std::vector<TriangleCalculatorLib::CompactTriangle> compact;
+    for (std::size_t i = 0; i < parallel.size(); ++i) {
+        compact.push_back(TriangleCalculatorLib::CompactTriangle::fromTriangle(parallel.get(i)));
+    }
+    for (const auto precision : {TriangleCalculatorLib::Precision::Fast, TriangleCalculatorLib::Precision::Mixed}) {
+        std::vector<TriangleCalculatorLib::CompactTriangle> expected = compact;
+        std::vector<ResultCode> expectedCodes(compact.size());
+        ASSERT_EQ(TriangleCalculator::finalizeTriangles(expected, expectedCodes, TriangleCalculatorLib::AngleUnit::Degrees, precision),
+                  ResultCode::Success);
+        std::vector<TriangleCalculatorLib::CompactTriangle> actual = compact;
+        std::vector<ResultCode> actualCodes(compact.size());
+        TriangleCalculatorLib::ThreadPool pool(4);
+        ASSERT_EQ(TriangleCalculator::finalizeTriangles(actual, actualCodes, TriangleCalculatorLib::AngleUnit::Degrees, precision, pool,
+                                                        AmbiguousCaseSolution::NoSolution, 37),
+                  ResultCode::Success);
+        EXPECT_EQ(actualCodes, expectedCodes);
+        for (std::size_t i = 0; i < compact.size(); ++i) {
+            ASSERT_EQ(actual[i].known, expected[i].known) << "row " << i;
+            EXPECT_EQ(actual[i].sideA, expected[i].sideA) << "row " << i;
+            EXPECT_EQ(actual[i].sideB, expected[i].sideB) << "row " << i;
+            EXPECT_EQ(actual[i].sideC, expected[i].sideC) << "row " << i;
+            EXPECT_EQ(actual[i].angleA, expected[i].angleA) << "row " << i;
+            EXPECT_EQ(actual[i].angleB, expected[i].angleB) << "row " << i;
+            EXPECT_EQ(actual[i].angleC, expected[i].angleC) << "row " << i;
+        }
+    }
+}
@@ -3,6 +3,7 @@
 #define LOGGING_OSTREAM_LOGGER_HPP
 
 #include <iostream>
+#include <mutex>
 
 #include <logging/logging.hpp>
 
@@ -29,7 +30,9 @@ public:
 
     void log(const record& r) noexcept override {
         if (r.lvl < min_level_) return;
-        
+
+        // batch tests solve on thread pools, keep concurrent records from interleaving
+        std::lock_guard<std::mutex> lock(mutex_);
         auto& os = (r.lvl == level::error || r.lvl == level::critical || r.lvl == level::warn)
                         ? err_
                         : out_;
@@ -48,6 +51,7 @@ private:
     std::ostream& out_;
     std::ostream& err_;
     level min_level_;
+    std::mutex mutex_;
 };
 
 } // namespace logiface